@@ -0,0 +1,99 @@
+#include "bench.h"
+
+#include "array_single_ended.h"
+#include "partition.h"
+#include "reduce.h"
+#include "rotate.h"
+#include "scan.h"
+#include "search_binary.h"
+
+namespace elements {
+
+template <typename T>
+auto
+bench_increasing(pointer_diff n) -> array_single_ended<T>
+{
+    array_single_ended<T> x(n);
+    for (pointer_diff i = 0; i < n; ++i) push(x, static_cast<T>(i));
+    return x;
+}
+
+template <typename T>
+auto
+bench_shuffled(pointer_diff n) -> array_single_ended<T>
+{
+    array_single_ended<T> x(n);
+    unsigned state = 12345u;
+    for (pointer_diff i = 0; i < n; ++i) {
+        state = state * 1103515245u + 12345u;
+        push(x, static_cast<T>(state % static_cast<unsigned>(n)));
+    }
+    return x;
+}
+
+template <typename T>
+void
+bench_algorithms_of(bench_output& output)
+{
+    auto type = bench_type_name<T>;
+    auto sum = [](T const& x, T const& y){ return x + y; };
+    for (auto n : bench_sizes) {
+        auto increasing = [n](){ return bench_increasing<T>(n); };
+        auto shuffled = [n](){ return bench_shuffled<T>(n); };
+        auto is_small = [n](T const& x){ return x < static_cast<T>(half(n)); };
+
+        bench(output, "search_binary", "lower", type, n, increasing, [n](array_single_ended<T>& x){
+            for (pointer_diff i = 0; i < n; ++i) {
+                do_not_optimize(search_binary_lower(first(x), limit(x), static_cast<T>(i)));
+            }
+        });
+        bench(output, "partition", "semistable", type, n, shuffled, [&is_small](array_single_ended<T>& x){
+            do_not_optimize(partition_semistable(first(x), limit(x), is_small));
+        });
+        bench(output, "partition", "stable", type, n, shuffled, [&is_small](array_single_ended<T>& x){
+            do_not_optimize(partition_stable(first(x), limit(x), is_small));
+        });
+        bench(output, "partition", "unstable", type, n, shuffled, [&is_small](array_single_ended<T>& x){
+            do_not_optimize(partition_unstable(first(x), limit(x), is_small));
+        });
+        bench(output, "partition", "block", type, n, shuffled, [&is_small](array_single_ended<T>& x){
+            do_not_optimize(partition_block(first(x), limit(x), is_small));
+        });
+        bench(output, "partition", "less", type, n, shuffled, [n](array_single_ended<T>& x){
+            do_not_optimize(partition_less(first(x), limit(x), static_cast<T>(half(n))));
+        });
+        bench(output, "partition", "stable_parallel", type, n, shuffled, [&is_small](array_single_ended<T>& x){
+            do_not_optimize(partition_stable_parallel(first(x), limit(x), is_small));
+        });
+        bench(output, "copy_if", "in_place", type, n, shuffled, [&is_small](array_single_ended<T>& x){
+            do_not_optimize(copy_if(first(x), limit(x), first(x), is_small));
+        });
+        bench(output, "rotate", "third", type, n, increasing, [n](array_single_ended<T>& x){
+            do_not_optimize(rotate(first(x), limit(x), first(x) + n / 3));
+        });
+        bench(output, "reduce", "sum", type, n, increasing, [&sum](array_single_ended<T>& x){
+            do_not_optimize(reduce(first(x), limit(x), sum, T{}));
+        });
+        bench(output, "reduce", "balanced_sum", type, n, increasing, [&sum](array_single_ended<T>& x){
+            do_not_optimize(reduce_balanced(first(x), limit(x), sum, T{}));
+        });
+        bench(output, "scan", "sum", type, n, increasing, [&sum](array_single_ended<T>& x){
+            do_not_optimize(scan_inclusive(first(x), limit(x), first(x), sum));
+        });
+        bench(output, "scan", "add", type, n, increasing, [](array_single_ended<T>& x){
+            do_not_optimize(scan_inclusive(first(x), limit(x), first(x), add));
+        });
+        bench(output, "scan", "parallel", type, n, increasing, [](array_single_ended<T>& x){
+            do_not_optimize(scan_inclusive_parallel(first(x), limit(x), first(x), add, T{}));
+        });
+    }
+}
+
+void
+bench_algorithms(bench_output& output)
+{
+    bench_algorithms_of<int>(output);
+    bench_algorithms_of<double>(output);
+}
+
+}
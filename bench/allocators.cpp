@@ -0,0 +1,39 @@
+#include "bench.h"
+
+#include "array_k.h"
+#include "memory.h"
+
+namespace elements {
+
+inline constexpr pointer_diff bench_allocation_sizes[] = {16, 256, 4096};
+
+inline constexpr pointer_diff bench_allocation_count = 64;
+
+template <Allocator A>
+void
+bench_allocator(bench_output& output, char const* group, A& a)
+{
+    for (auto bytes : bench_allocation_sizes) {
+        auto setup = [](){ return array_k<memory, bench_allocation_count>{}; };
+        bench(output, group, "allocate_deallocate", "bytes", bytes, setup, [&a, bytes](array_k<memory, bench_allocation_count>& blocks){
+            for (pointer_diff i = 0; i < bench_allocation_count; ++i) blocks[i] = allocate(a, bytes);
+            for (pointer_diff i = bench_allocation_count; i != 0; --i) {
+                if (blocks[i - 1]) deallocate(a, blocks[i - 1]);
+            }
+        });
+    }
+}
+
+void
+bench_allocators(bench_output& output)
+{
+    dynamic_allocator dynamic;
+    bench_allocator(output, "dynamic_allocator", dynamic);
+    static_allocator<bench_allocation_count * 4096> stack;
+    bench_allocator(output, "static_allocator", stack);
+    choice_allocator choice{static_allocator<4096>{}, dynamic_allocator{}};
+    bench_allocator(output, "choice_allocator", choice);
+    bench_allocator(output, "default_allocator", default_allocator);
+}
+
+}
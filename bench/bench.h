@@ -0,0 +1,141 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "intrinsics.h"
+#include "integer.h"
+#include "ordering.h"
+#include "perf_counters.h"
+
+namespace elements {
+
+struct bench_output
+{
+    std::FILE* out{};
+    pointer_diff count{};
+    perf_counters counters;
+};
+
+template <typename T>
+inline constexpr char const* bench_type_name = "unknown";
+
+template <>
+inline constexpr char const* bench_type_name<int> = "int";
+
+template <>
+inline constexpr char const* bench_type_name<double> = "double";
+
+inline constexpr pointer_diff bench_sizes[] = {16, 1024, 65536};
+
+inline constexpr auto bench_min_time = std::chrono::milliseconds{20};
+
+inline constexpr pointer_diff bench_max_iterations = 1 << 16;
+
+template <typename T>
+inline void
+do_not_optimize(T const& x)
+{
+    asm volatile("" : : "r,m"(x) : "memory");
+}
+
+inline void
+write_json_header(bench_output& output)
+{
+    std::fprintf(output.out, "{\n  \"context\": {\"compiler\": \"%s\", \"build\": \"Release\"},\n  \"benchmarks\": [", __VERSION__);
+}
+
+inline void
+write_json_footer(bench_output& output)
+{
+    std::fprintf(output.out, "\n  ]\n}\n");
+}
+
+inline void
+write_json(
+    bench_output& output,
+    char const* group, char const* operation, char const* type, pointer_diff n,
+    pointer_diff iterations, double ns_per_element, perf_counts const& events)
+// Writes the hardware events per element, or null for the events that are
+// not available.
+{
+    std::fprintf(output.out,
+        "%s\n    {\"name\": \"%s/%s/%s/%td\", \"group\": \"%s\", \"operation\": \"%s\", \"type\": \"%s\", "
+        "\"size\": %td, \"iterations\": %td, \"ns_per_element\": %.4f",
+        is_zero(output.count) ? "" : ",",
+        group, operation, type, n,
+        group, operation, type, n, iterations, ns_per_element);
+    auto elements = static_cast<double>(iterations * max(n, One<pointer_diff>));
+    for (size_t i = 0; i < n_perf_events; ++i) {
+        if (is_valid(events, i)) {
+            std::fprintf(output.out, ", \"%s\": %.4f", perf_event_names[i], events[i] / elements);
+        } else {
+            std::fprintf(output.out, ", \"%s\": null", perf_event_names[i]);
+        }
+    }
+    if (is_valid(events, perf_cycles) and is_valid(events, perf_instructions)) {
+        std::fprintf(output.out, ", \"ipc\": %.4f}", instructions_per_cycle(events));
+    } else {
+        std::fprintf(output.out, ", \"ipc\": null}");
+    }
+    increment(output.count);
+}
+
+inline void
+bench_pin(pointer_diff cpu)
+// Pins the calling thread to the given processor, if there is one
+{
+#if defined(__linux__)
+    if (!(cpu < hardware_concurrency())) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<size_t>(cpu), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+template <Invocable S, typename R>
+void
+bench(bench_output& output, char const* group, char const* operation, char const* type, pointer_diff n, S setup, R run)
+// Calls setup outside and run inside the timed region until bench_min_time
+// has been spent in run, and records the fastest run per element and the
+// hardware events per element over all runs.
+{
+    using clock = std::chrono::steady_clock;
+    auto best = clock::duration::max();
+    auto total = clock::duration::zero();
+    auto iterations = Zero<pointer_diff>;
+    clear(output.counters);
+    while (total < bench_min_time and iterations < bench_max_iterations) {
+        auto state = setup();
+        clock::time_point t0;
+        clock::time_point t1;
+        {
+            perf_scope scope{output.counters};
+            t0 = clock::now();
+            run(state);
+            t1 = clock::now();
+        }
+        do_not_optimize(state);
+        if (t1 - t0 < best) best = t1 - t0;
+        total = total + (t1 - t0);
+        increment(iterations);
+    }
+    auto ns = std::chrono::duration<double, std::nano>(best).count();
+    write_json(output, group, operation, type, n, iterations, ns / static_cast<double>(max(n, One<pointer_diff>)), output.counters.counts);
+}
+
+void bench_containers(bench_output& output);
+
+void bench_algorithms(bench_output& output);
+
+void bench_allocators(bench_output& output);
+
+void bench_numeric(bench_output& output);
+
+}
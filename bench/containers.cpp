@@ -0,0 +1,262 @@
+#include "bench.h"
+
+#include "array_circular.h"
+#include "array_double_ended.h"
+#include "array_segmented_double_ended.h"
+#include "array_segmented_single_ended.h"
+#include "array_single_ended.h"
+#include "array_small.h"
+#include "list_doubly_linked_circular.h"
+#include "list_doubly_linked_front_back.h"
+#include "list_doubly_linked_sentinel.h"
+#include "list_singly_linked_circular.h"
+#include "list_singly_linked_front.h"
+#include "list_singly_linked_front_back.h"
+#include "list_pool.h"
+#include "list_unrolled.h"
+#include "locked_queue.h"
+#include "locked_stack.h"
+#include "queue_spsc.h"
+#include "reduce.h"
+
+namespace elements {
+
+template <typename S>
+void
+bench_sum(bench_output& output, char const* group, pointer_diff n)
+{
+    using T = Value_type<S>;
+    auto sum = [](T const& x, T const& y){ return x + y; };
+    auto setup = [n](){
+        S seq;
+        for (pointer_diff i = 0; i < n; ++i) push_first(seq, static_cast<T>(i));
+        return seq;
+    };
+    bench(output, group, "iterate", bench_type_name<T>, n, setup, [&sum](S& seq){
+        do_not_optimize(reduce(first(seq), limit(seq), sum, T{}));
+    });
+}
+
+template <typename S>
+void
+bench_back(bench_output& output, char const* group)
+{
+    using T = Value_type<S>;
+    auto sum = [](T const& x, T const& y){ return x + y; };
+    for (auto n : bench_sizes) {
+        auto empty = [](){ return S{}; };
+        auto full = [n](){
+            S seq;
+            for (pointer_diff i = 0; i < n; ++i) push(seq, static_cast<T>(i));
+            return seq;
+        };
+        bench(output, group, "push", bench_type_name<T>, n, empty, [n](S& seq){
+            for (pointer_diff i = 0; i < n; ++i) push(seq, static_cast<T>(i));
+        });
+        bench(output, group, "pop", bench_type_name<T>, n, full, [n](S& seq){
+            for (pointer_diff i = 0; i < n; ++i) pop(seq);
+        });
+        bench(output, group, "iterate", bench_type_name<T>, n, full, [&sum](S& seq){
+            do_not_optimize(reduce(first(seq), limit(seq), sum, T{}));
+        });
+    }
+}
+
+template <typename S>
+void
+bench_front(bench_output& output, char const* group)
+{
+    using T = Value_type<S>;
+    for (auto n : bench_sizes) {
+        auto empty = [](){ return S{}; };
+        auto full = [n](){
+            S seq;
+            for (pointer_diff i = 0; i < n; ++i) push_first(seq, static_cast<T>(i));
+            return seq;
+        };
+        bench(output, group, "push_first", bench_type_name<T>, n, empty, [n](S& seq){
+            for (pointer_diff i = 0; i < n; ++i) push_first(seq, static_cast<T>(i));
+        });
+        bench(output, group, "pop_first", bench_type_name<T>, n, full, [n](S& seq){
+            for (pointer_diff i = 0; i < n; ++i) pop_first(seq);
+        });
+    }
+}
+
+template <typename T>
+void
+bench_list_pool(bench_output& output)
+// Nodes are allocated with indices 1 to n, each linked to the one before,
+// so the list starts at n
+{
+    using P = list_pool<T>;
+    using N = Size_type<P>;
+    auto sum = [](T const& x, T const& y){ return x + y; };
+    for (auto n : bench_sizes) {
+        auto empty = [](){ return P{}; };
+        auto full = [n](){
+            P pool;
+            auto head = pool.limit();
+            for (pointer_diff i = 0; i < n; ++i) head = allocate(pool, static_cast<T>(i), head);
+            return pool;
+        };
+        bench(output, "list_pool", "push_first", bench_type_name<T>, n, empty, [n](P& pool){
+            auto head = pool.limit();
+            for (pointer_diff i = 0; i < n; ++i) head = allocate(pool, static_cast<T>(i), head);
+            do_not_optimize(head);
+        });
+        bench(output, "list_pool", "pop_first", bench_type_name<T>, n, full, [n](P& pool){
+            auto head = static_cast<N>(n);
+            for (pointer_diff i = 0; i < n; ++i) head = free(pool, head);
+            do_not_optimize(head);
+        });
+        bench(output, "list_pool", "iterate", bench_type_name<T>, n, full, [n, &sum](P& pool){
+            do_not_optimize(reduce(list_pool_cursor<T>{pool, static_cast<N>(n)}, list_pool_cursor<T>{pool}, sum, T{}));
+        });
+    }
+}
+
+template <typename S>
+void
+bench_locked(bench_output& output, char const* group)
+// Measures the cost of the lock without contention
+{
+    using T = Value_type<S>;
+    for (auto n : bench_sizes) {
+        auto empty = [](){ return S{}; };
+        auto full = [n](){
+            S seq;
+            for (pointer_diff i = 0; i < n; ++i) push(seq, static_cast<T>(i));
+            return seq;
+        };
+        bench(output, group, "push", bench_type_name<T>, n, empty, [n](S& seq){
+            for (pointer_diff i = 0; i < n; ++i) push(seq, static_cast<T>(i));
+        });
+        bench(output, group, "pop", bench_type_name<T>, n, full, [n](S& seq){
+            T x{};
+            for (pointer_diff i = 0; i < n; ++i) try_pop(seq, x);
+            do_not_optimize(x);
+        });
+    }
+}
+
+inline constexpr pointer_diff bench_queue_spsc_sizes[] = {65536, 1 << 20};
+
+inline constexpr pointer_diff bench_queue_spsc_capacity = 1024;
+
+inline constexpr pointer_diff bench_queue_spsc_batch = 64;
+
+template <typename T>
+void
+bench_queue_spsc(bench_output& output)
+// A producer and a consumer thread, pinned to the first two processors,
+// pass n elements through the queue one at a time and in batches. The
+// time per element is the inverse of the throughput in messages per
+// nanosecond. Either side yields when the queue is full or empty, so that
+// the benchmark also completes on a single processor.
+{
+    using Q = queue_spsc<T>;
+    auto one_at_a_time = [](Q& q, pointer_diff n){
+        thread producer{[&q, n](){
+            bench_pin(1);
+            for (pointer_diff i = 0; i < n; ++i) {
+                while (!try_push(q, static_cast<T>(i))) std::this_thread::yield();
+            }
+        }};
+        thread consumer{[&q, n](){
+            bench_pin(0);
+            T sum{};
+            T x{};
+            for (pointer_diff i = 0; i < n; ++i) {
+                while (!try_pop(q, x)) std::this_thread::yield();
+                sum = sum + x;
+            }
+            do_not_optimize(sum);
+        }};
+        producer.join();
+        consumer.join();
+    };
+    auto batched = [](Q& q, pointer_diff n){
+        thread producer{[&q, n](){
+            bench_pin(1);
+            T batch[bench_queue_spsc_batch];
+            for (pointer_diff i = 0; i < bench_queue_spsc_batch; ++i) batch[i] = static_cast<T>(i);
+            auto i = Zero<pointer_diff>;
+            while (i < n) {
+                auto m = try_push_n(q, Pointer_type<T const>{batch}, min(bench_queue_spsc_batch, n - i));
+                if (is_zero(m)) std::this_thread::yield();
+                i = i + m;
+            }
+        }};
+        thread consumer{[&q, n](){
+            bench_pin(0);
+            T batch[bench_queue_spsc_batch];
+            T sum{};
+            auto i = Zero<pointer_diff>;
+            while (i < n) {
+                auto m = try_pop_n(q, bench_queue_spsc_batch, Pointer_type<T>{batch});
+                if (is_zero(m)) std::this_thread::yield();
+                else sum = sum + batch[m - 1];
+                i = i + m;
+            }
+            do_not_optimize(sum);
+        }};
+        producer.join();
+        consumer.join();
+    };
+    for (auto n : bench_queue_spsc_sizes) {
+        auto setup = [](){ return Q{bench_queue_spsc_capacity}; };
+        bench(output, "queue_spsc", "push_pop", bench_type_name<T>, n, setup, [n, &one_at_a_time](Q& q){
+            one_at_a_time(q, n);
+        });
+        bench(output, "queue_spsc", "push_n_pop_n", bench_type_name<T>, n, setup, [n, &batched](Q& q){
+            batched(q, n);
+        });
+    }
+}
+
+template <typename T>
+void
+bench_containers_of(bench_output& output)
+{
+    bench_back<array_single_ended<T>>(output, "array_single_ended");
+    bench_back<array_small<T>>(output, "array_small");
+    bench_back<array_double_ended<T>>(output, "array_double_ended");
+    bench_front<array_double_ended<T>>(output, "array_double_ended");
+    bench_back<array_circular<T>>(output, "array_circular");
+    bench_front<array_circular<T>>(output, "array_circular");
+    bench_back<array_segmented_single_ended<T>>(output, "array_segmented_single_ended");
+    bench_back<array_segmented_double_ended<T>>(output, "array_segmented_double_ended");
+    bench_front<array_segmented_double_ended<T>>(output, "array_segmented_double_ended");
+
+    bench_front<list_singly_linked_front<T>>(output, "list_singly_linked_front");
+    bench_front<list_singly_linked_front_back<T>>(output, "list_singly_linked_front_back");
+    bench_front<list_singly_linked_circular<T>>(output, "list_singly_linked_circular");
+    bench_front<list_doubly_linked_front_back<T>>(output, "list_doubly_linked_front_back");
+    bench_front<list_doubly_linked_sentinel<T>>(output, "list_doubly_linked_sentinel");
+    bench_front<list_doubly_linked_circular<T>>(output, "list_doubly_linked_circular");
+    bench_front<list_unrolled<T>>(output, "list_unrolled");
+    for (auto n : bench_sizes) {
+        bench_sum<list_singly_linked_front<T>>(output, "list_singly_linked_front", n);
+        bench_sum<list_singly_linked_front_back<T>>(output, "list_singly_linked_front_back", n);
+        bench_sum<list_singly_linked_circular<T>>(output, "list_singly_linked_circular", n);
+        bench_sum<list_doubly_linked_front_back<T>>(output, "list_doubly_linked_front_back", n);
+        bench_sum<list_doubly_linked_sentinel<T>>(output, "list_doubly_linked_sentinel", n);
+        bench_sum<list_doubly_linked_circular<T>>(output, "list_doubly_linked_circular", n);
+        bench_sum<list_unrolled<T>>(output, "list_unrolled", n);
+    }
+
+    bench_list_pool<T>(output);
+    bench_locked<locked_stack<array_single_ended<T>>>(output, "locked_stack");
+    bench_locked<locked_queue<array_double_ended<T>>>(output, "locked_queue");
+    bench_queue_spsc<T>(output);
+}
+
+void
+bench_containers(bench_output& output)
+{
+    bench_containers_of<int>(output);
+    bench_containers_of<double>(output);
+}
+
+}
@@ -0,0 +1,25 @@
+#include "bench.h"
+
+namespace e = elements;
+
+auto
+main(int argc, char** argv) -> int
+{
+    e::bench_output output;
+    output.out = stdout;
+    if (argc > 1) {
+        output.out = std::fopen(argv[1], "w");
+        if (output.out == nullptr) {
+            std::fprintf(stderr, "cannot open %s\n", argv[1]);
+            return 1;
+        }
+    }
+    e::write_json_header(output);
+    e::bench_containers(output);
+    e::bench_algorithms(output);
+    e::bench_allocators(output);
+    e::bench_numeric(output);
+    e::write_json_footer(output);
+    if (output.out != stdout) std::fclose(output.out);
+    return 0;
+}
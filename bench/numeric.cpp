@@ -0,0 +1,104 @@
+#include "bench.h"
+
+#include "rational.h"
+#include "sparse.h"
+#include "vector_space.h"
+
+namespace elements {
+
+template <>
+inline constexpr char const* bench_type_name<rational<long>> = "rational<long>";
+
+template <>
+inline constexpr char const* bench_type_name<rational_normalized<long>> = "rational_normalized<long>";
+
+template <>
+inline constexpr char const* bench_type_name<sparse_matrix<double>> = "sparse_matrix<double>";
+
+template <>
+inline constexpr char const* bench_type_name<sparse_matrix<double, int>> = "sparse_matrix<double, int>";
+
+inline constexpr pointer_diff bench_rational_terms = 10000000;
+
+template <typename Q, typename Op>
+void
+bench_rational_sum(bench_output& output, char const* operation, Op add)
+// Sums 10^7 rationals with denominators up to 16, whose exact sum has
+// terms below 10^14, so a sum that does not reduce overflows
+{
+    pointer_diff n = bench_rational_terms;
+    bench(output, "rational", operation, bench_type_name<Q>, n, [](){ return Q{}; }, [n, &add](Q& s){
+        for (pointer_diff i = 1; i <= n; ++i) {
+            s = add(s, Q{i % 7 - 3, 1 + i % 16});
+        }
+        do_not_optimize(s);
+    });
+}
+
+inline constexpr pointer_diff bench_sparse_rows = 1 << 20;
+
+template <typename I>
+void
+bench_sparse_multiply(bench_output& output)
+// Multiplies a vector by a matrix of 2^20 rows with 16 nonzeros each, spread
+// over a band on one worker, reporting the time per nonzero
+{
+    pointer_diff m = bench_sparse_rows;
+    pointer_diff per_row = 16;
+    coo_matrix_engine<double, I> x(m, m);
+    for (pointer_diff i = 0; i < m; ++i) {
+        for (pointer_diff k = 0; k < per_row; ++k) push(x, i, (i + k * 97) % m, 1.0 / static_cast<double>(1 + k));
+    }
+    sparse_matrix<double, I> a{csr_matrix_engine<double, I>(x)};
+    dynamic_vector<double> v(m, 1.0);
+    bench(output, "sparse", "multiply_vector", bench_type_name<sparse_matrix<double, I>>, nonzeros(a), [m](){
+        return dynamic_vector<double>(m, 0.0);
+    }, [&a, &v](dynamic_vector<double>& y){
+        multiply_sparse(a.engine, first(v), first(y), 1);
+        do_not_optimize(first(y)[0]);
+    });
+}
+
+inline constexpr pointer_diff bench_matrix_sizes[] = {64, 256, 1024};
+
+void
+bench_matrix_multiply(bench_output& output)
+// Multiplies square matrices of doubles on one worker, reporting the time
+// per multiply-add, so that two over the time in nanoseconds is the
+// throughput in GFLOP/s
+{
+    for (auto n : bench_matrix_sizes) {
+        dynamic_matrix<double> x(n, n, 0.0);
+        dynamic_matrix<double> y(n, n, 0.0);
+        for (pointer_diff i = 0; i < n; ++i) {
+            for (pointer_diff j = 0; j < n; ++j) {
+                x(i, j) = static_cast<double>((i * 7 + j * 3) % 11 - 5);
+                y(i, j) = static_cast<double>((i * 5 + j) % 13 - 6);
+            }
+        }
+        auto const& a = x;
+        auto const& b = y;
+        bench(output, "matrix", "multiply_matrix", bench_type_name<double>, n * n * n, [n](){
+            return dynamic_matrix<double>(n, n, 0.0);
+        }, [&a, &b](dynamic_matrix<double>& z){
+            multiply_matrix(view(a), view(b), view(z), 1);
+            do_not_optimize(z(0, 0));
+        });
+    }
+}
+
+void
+bench_numeric(bench_output& output)
+{
+    bench_rational_sum<rational<long>>(output, "sum_normalize_each", [](rational<long> const& x, rational<long> const& y){
+        return normalize(x + y);
+    });
+    bench_rational_sum<rational_normalized<long>>(output, "sum_lazy", [](rational_normalized<long> const& x, rational_normalized<long> const& y){
+        return x + y;
+    });
+    bench_sparse_multiply<pointer_diff>(output);
+    bench_sparse_multiply<int>(output);
+    bench_matrix_multiply(output);
+}
+
+}
@@ -135,7 +135,7 @@ struct lt<point<S, k, C, V>>
     constexpr auto
     operator()(point<S, k, C, V> const& x, point<S, k, C, V> const& y) -> bool
     {
-        return lt{}(x.coordinates, y.coordinates);
+        return lt<C>{}(x.coordinates, y.coordinates);
     }
 };
 
@@ -192,8 +192,280 @@ constexpr auto
 quadrance(point<S, k, C, V> const& x, point<S, k, C, V> const& y) -> Scalar_type<V>
 {
     auto v{x - y};
-    v = power_semigroup(v, S{2}, [](V& v0, V const& v1){ map(first(v0), limit(v0), first(v1), first(v0), mul_op<S>{}); });
+    map(first(v), limit(v), first(v), first(v), mul_op<S>{});
     return reduce(first(v), limit(v), add_op<S>{}, Zero<S>);
 }
 
+template <Semiring S, pointer_diff k>
+constexpr auto
+transform(point<S, k> const& x, static_matrix<S, k, k> const& a, static_vector<S, k> const& t) -> point<S, k>
+// Returns a x + t
+{
+    point<S, k> y;
+    for (pointer_diff r = 0; r < k; ++r) {
+        auto s = t(r);
+        for (pointer_diff j = 0; j < k; ++j) s = s + a(r, j) * x(j);
+        y(r) = s;
+    }
+    return y;
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc = array_allocator<S>>
+struct point_cloud
+{
+    // Coordinate j of all points is stored contiguously in coordinates[j],
+    // so that the kernels below process consecutive points in lockstep,
+    // which vectorizes
+    array_k<array_single_ended<S, alloc>, k> coordinates;
+
+    constexpr
+    point_cloud() = default;
+
+    explicit constexpr
+    point_cloud(pointer_diff capacity)
+    {
+        for (pointer_diff j = 0; j < k; ++j) reserve(coordinates[j], capacity);
+    }
+
+    constexpr auto
+    operator()(pointer_diff i) const -> point<S, k>
+    {
+        point<S, k> x;
+        for (pointer_diff j = 0; j < k; ++j) x(j) = coordinates[j][i];
+        return x;
+    }
+};
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+struct value_type_t<point_cloud<S, k, alloc>>
+{
+    using type = point<S, k>;
+};
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+struct scalar_type_t<point_cloud<S, k, alloc>>
+{
+    using type = S;
+};
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+struct size_type_t<point_cloud<S, k, alloc>>
+{
+    using type = pointer_diff;
+};
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+constexpr auto
+operator==(point_cloud<S, k, alloc> const& x, point_cloud<S, k, alloc> const& y) -> bool
+{
+    return x.coordinates == y.coordinates;
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+constexpr auto
+size(point_cloud<S, k, alloc> const& x) -> pointer_diff
+{
+    return size(x.coordinates[0]);
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+constexpr auto
+is_empty(point_cloud<S, k, alloc> const& x) -> bool
+{
+    return is_empty(x.coordinates[0]);
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+constexpr void
+push(point_cloud<S, k, alloc>& x, point<S, k> const& y)
+{
+    for (pointer_diff j = 0; j < k; ++j) push(x.coordinates[j], y(j));
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+constexpr void
+store(point_cloud<S, k, alloc>& x, pointer_diff i, point<S, k> const& y)
+//[[expects: i < size(x)]]
+{
+    for (pointer_diff j = 0; j < k; ++j) x.coordinates[j][i] = y(j);
+}
+
+inline constexpr pointer_diff point_cloud_block = 256;
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+void
+quadrances_block(point_cloud<S, k, alloc> const& x, point<S, k> const& y, pointer_diff i, pointer_diff n, Pointer_type<S> dst)
+//[[expects: i + n <= size(x)]]
+// Stores the quadrances between points [i, i + n) of x and y in dst[0, n);
+// the loop over the k coordinates is unrolled, leaving a loop over points
+{
+    Pointer_type<S const> c[static_cast<size_t>(k)];
+    for (pointer_diff j = 0; j < k; ++j) c[j] = first(x.coordinates[j]) + i;
+    for (pointer_diff l = 0; l < n; ++l) {
+        auto s = Zero<S>;
+        for (pointer_diff j = 0; j < k; ++j) {
+            auto d = c[j][l] - y(j);
+            s = s + d * d;
+        }
+        dst[l] = s;
+    }
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc, Invocable<pointer_diff, S const&> P>
+void
+for_each_quadrance(point_cloud<S, k, alloc> const& x, point<S, k> const& y, pointer_diff i, pointer_diff j, P proc)
+//[[expects: i <= j and j <= size(x)]]
+// Calls proc(l, q) for each l in [i, j), where q is the quadrance between
+// point l of x and y, computing the quadrances a block at a time
+{
+    S q[point_cloud_block];
+    while (i < j) {
+        auto h = min(point_cloud_block, j - i);
+        quadrances_block(x, y, i, h, q);
+        for (pointer_diff l = 0; l < h; ++l) proc(i + l, q[l]);
+        i = i + h;
+    }
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+void
+quadrances(point_cloud<S, k, alloc> const& x, point<S, k> const& y, Pointer_type<S> dst)
+// Stores the quadrance between each point of x and y in dst[0, size(x))
+{
+    quadrances_block(x, y, 0, size(x), dst);
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+void
+quadrances(point_cloud<S, k, alloc> const& x, point_cloud<S, k, alloc> const& y, Pointer_type<S> dst)
+//[[expects: size(x) == size(y)]]
+// Stores the quadrance between the points with each index of x and y in dst
+{
+    Pointer_type<S const> c0[static_cast<size_t>(k)];
+    Pointer_type<S const> c1[static_cast<size_t>(k)];
+    for (pointer_diff j = 0; j < k; ++j) {
+        c0[j] = first(x.coordinates[j]);
+        c1[j] = first(y.coordinates[j]);
+    }
+    auto n = size(x);
+    for (pointer_diff l = 0; l < n; ++l) {
+        auto s = Zero<S>;
+        for (pointer_diff j = 0; j < k; ++j) {
+            auto d = c0[j][l] - c1[j][l];
+            s = s + d * d;
+        }
+        dst[l] = s;
+    }
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc, Vector_space V>
+void
+translate(point_cloud<S, k, alloc>& x, V const& v)
+// Adds v to each point of x
+{
+    auto n = size(x);
+    for (pointer_diff j = 0; j < k; ++j) {
+        auto c = first(x.coordinates[j]);
+        auto v_j = v(j);
+        for (pointer_diff i = 0; i < n; ++i) c[i] = c[i] + v_j;
+    }
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+void
+transform(point_cloud<S, k, alloc>& x, static_matrix<S, k, k> const& a, static_vector<S, k> const& t)
+// Replaces each point p of x with a p + t. The coefficients are copied to
+// local arrays, which the stores to the coordinates cannot alias, so they
+// stay in registers while the loop over points vectorizes
+{
+    S m[static_cast<size_t>(k)][static_cast<size_t>(k)];
+    S u[static_cast<size_t>(k)];
+    Pointer_type<S> c[static_cast<size_t>(k)];
+    for (pointer_diff r = 0; r < k; ++r) {
+        for (pointer_diff j = 0; j < k; ++j) m[r][j] = a(r, j);
+        u[r] = t(r);
+        c[r] = first(x.coordinates[r]);
+    }
+    auto n = size(x);
+    for (pointer_diff l = 0; l < n; ++l) {
+        S p[static_cast<size_t>(k)];
+        for (pointer_diff j = 0; j < k; ++j) p[j] = c[j][l];
+        for (pointer_diff r = 0; r < k; ++r) {
+            auto s = u[r];
+            for (pointer_diff j = 0; j < k; ++j) s = s + m[r][j] * p[j];
+            c[r][l] = s;
+        }
+    }
+}
+
+template <Semiring S>
+requires Totally_ordered<S>
+constexpr auto
+precedes_nearest(S const& q0, pointer_diff i0, S const& q1, pointer_diff i1) -> bool
+// Orders candidate neighbours by quadrance and then by index
+{
+    return q0 < q1 or (q0 == q1 and i0 < i1);
+}
+
+template <Semiring S>
+requires Totally_ordered<S>
+constexpr void
+insert_nearest(Pointer_type<S> nearest, Pointer_type<pointer_diff> dst, pointer_diff& count, pointer_diff m, S const& q, pointer_diff i)
+//[[expects: 0 < m and count <= m]]
+// Inserts the candidate with quadrance q and index i into the count
+// candidates (nearest, dst) sorted by precedes_nearest, keeping at most m
+{
+    if (count == m and !precedes_nearest(q, i, nearest[predecessor(m)], dst[predecessor(m)])) return;
+    auto j = count;
+    if (count == m) j = predecessor(m);
+    else increment(count);
+    while (!is_zero(j) and precedes_nearest(q, i, nearest[predecessor(j)], dst[predecessor(j)])) {
+        nearest[j] = nearest[predecessor(j)];
+        dst[j] = dst[predecessor(j)];
+        decrement(j);
+    }
+    nearest[j] = q;
+    dst[j] = i;
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+requires Totally_ordered<S>
+auto
+nearest_neighbours(point_cloud<S, k, alloc> const& x, point<S, k> const& y, pointer_diff m, Pointer_type<pointer_diff> dst) -> pointer_diff
+// Stores the indices of the min(m, size(x)) points of x nearest to y in dst,
+// in increasing order of quadrance and of index for equal quadrances, and
+// returns their number. The quadrances are computed a block at a time, and
+// most points are rejected by a single comparison with the m:th nearest so far
+{
+    auto n = size(x);
+    m = min(m, n);
+    if (is_zero(m)) return m;
+    array_single_ended<S> nearest(m, Zero<S>);
+    auto count = Zero<pointer_diff>;
+    auto c = first(nearest);
+    for_each_quadrance(x, y, 0, n, [c, dst, &count, m](pointer_diff i, S const& q){
+        if (count < m or !(c[predecessor(m)] < q)) insert_nearest(c, dst, count, m, q, i);
+    });
+    return m;
+}
+
+inline constexpr pointer_diff nearest_neighbours_parallel_grain = 16;
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+requires Totally_ordered<S>
+void
+nearest_neighbours(
+    point_cloud<S, k, alloc> const& x, point_cloud<S, k, alloc> const& y, pointer_diff m, Pointer_type<pointer_diff> dst,
+    pointer_diff workers = hardware_concurrency())
+//[[expects: m <= size(x)]]
+// Stores the indices of the m points of x nearest to point i of y in
+// dst[i m, (i + 1) m) for each i, dividing the points of y among workers
+{
+    auto n = size(y);
+    auto w = parallel_workers(n, nearest_neighbours_parallel_grain, workers);
+    for_each_worker(w, [&x, &y, m, dst, n, w](pointer_diff t){
+        for (auto i = n * t / w; i < n * successor(t) / w; ++i) nearest_neighbours(x, y(i), m, dst + i * m);
+    });
+}
+
 }
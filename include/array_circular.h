@@ -1,10 +1,13 @@
 #pragma once
 
+#include "copy.h"
 #include "functional.h"
 #include "lexicographical.h"
 #include "map.h"
 #include "memory.h"
 #include "ordering.h"
+#include "pair.h"
+#include "range.h"
 #include "swap.h"
 
 namespace elements {
@@ -376,7 +379,7 @@ emplace_first(array_circular<T, alloc>& arr, U&& x)
 
 template <typename T, Invocable auto alloc, typename U>
 constexpr void
-push_first(array_circular<T, alloc>& arr, T x)
+push_first(array_circular<T, alloc>& arr, U x)
 {
     insert(front{arr}, mv(x));
 }
@@ -480,4 +483,100 @@ capacity(array_circular<T, alloc> const& x) -> Size_type<array_circular<T, alloc
     return load(x.header).limit_of_storage - pointer_to(load(x.header).x);
 }
 
+template <typename T, Invocable auto alloc>
+constexpr auto
+segments(array_circular<T, alloc>& x) -> pair<bounded_range<Pointer_type<T>>>
+{
+    if (is_empty(x)) return {};
+    auto& header = at(x.header);
+    if (header.first < header.limit) {
+        return {{header.first, header.limit}, {header.limit, header.limit}};
+    } else {
+        return {{header.first, header.limit_of_storage}, {pointer_to(header.x), header.limit}};
+    }
+}
+
+template <typename T, Invocable auto alloc>
+constexpr auto
+segments(array_circular<T, alloc> const& x) -> pair<bounded_range<Pointer_type<T const>>>
+{
+    if (is_empty(x)) return {};
+    auto const& header = load(x.header);
+    if (header.first < header.limit) {
+        return {{header.first, header.limit}, {header.limit, header.limit}};
+    } else {
+        return {{header.first, header.limit_of_storage}, {pointer_to(header.x), header.limit}};
+    }
+}
+
+template <typename T, Invocable auto alloc, Cursor S>
+requires Same_as<Remove_const<Value_type<S>>, T>
+constexpr auto
+push_n(array_circular<T, alloc>& x, S src, Size_type<array_circular<T, alloc>> n) -> S
+{
+    if (is_zero(n)) return src;
+    if (capacity(x) - size(x) < n) {
+        reserve(x, max(size(x) + n, twice(size(x))));
+    }
+    auto& header = at(x.header);
+    if (header.limit == header.limit_of_storage) {
+        header.limit = pointer_to(header.x);
+    }
+    auto n0 = n;
+    if (header.first <= header.limit) {
+        n0 = min(n, header.limit_of_storage - header.limit);
+    }
+    auto cur = construct_copy_n(src, n0, header.limit);
+    if (n0 < n) {
+        cur = construct_copy_n(cur.m0, n - n0, pointer_to(header.x));
+    }
+    header.limit = cur.m1;
+    header.size = header.size + n;
+    return cur.m0;
+}
+
+template <typename T, Invocable auto alloc>
+constexpr void
+pop_n(array_circular<T, alloc>& x, Size_type<array_circular<T, alloc>> n)
+//[[expects: n <= size(x)]]
+{
+    if (is_zero(n)) return;
+    auto& header = at(x.header);
+    auto n0 = min(n, header.limit_of_storage - header.first);
+    destroy(header.first, header.first + n0);
+    header.first = header.first + n0;
+    if (header.first == header.limit_of_storage) {
+        header.first = pointer_to(header.x);
+    }
+    if (n0 < n) {
+        destroy(header.first, header.first + (n - n0));
+        header.first = header.first + (n - n0);
+    }
+    header.size = header.size - n;
+    if (is_empty(x)) {
+        deallocate_array_circular<T, alloc>(x.header);
+        x.header = nullptr;
+    }
+}
+
+template <typename T, Invocable auto alloc, Cursor D>
+requires Same_as<Value_type<D>, T>
+constexpr auto
+copy_out(array_circular<T, alloc> const& x, Size_type<array_circular<T, alloc>> n, D dst) -> D
+//[[expects: n <= size(x)]]
+{
+    auto seg = segments(x);
+    auto n0 = min(n, size(seg.m0));
+    dst = copy(first(seg.m0), first(seg.m0) + n0, dst);
+    return copy(first(seg.m1), first(seg.m1) + (n - n0), dst);
+}
+
+template <typename T, Invocable auto alloc, Cursor D>
+requires Same_as<Value_type<D>, T>
+constexpr auto
+copy_out(array_circular<T, alloc> const& x, D dst) -> D
+{
+    return copy_out(x, size(x), dst);
+}
+
 }
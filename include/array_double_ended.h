@@ -258,7 +258,8 @@ insert(front<array_double_ended<T, alloc>> arr, U&& x) -> front<array_double_end
     if (!precedes(first(seq), first_of_storage(seq))) {
         if (!precedes(limit(seq), limit_of_storage(seq))) {
             auto n = size(seq);
-            reserve(seq, max(One<Size_type<array_double_ended<T, alloc>>>, twice(n)), n);
+            auto m = max(One<Size_type<array_double_ended<T, alloc>>>, twice(n));
+            reserve(seq, m, m - n);
         } else {
             auto cur = limit(seq) + successor(half(limit_of_storage(seq) - limit(seq)));
             at(seq.header).first = swap(
@@ -332,11 +333,29 @@ erase(front<array_double_ended<T, alloc>> arr) -> front<array_double_ended<T, al
     return arr;
 }
 
+template <typename T, Invocable auto alloc>
+constexpr void
+clear(
+    array_double_ended<T, alloc>& x,
+    Size_type<array_double_ended<T, alloc>> offset = Zero<Size_type<array_double_ended<T, alloc>>>)
+//[[expects: offset <= capacity(x)]]
+{
+    if (x.header == nullptr) return;
+    auto& header = at(x.header);
+    destroy(header.first, header.limit);
+    header.first = pointer_to(header.x) + offset;
+    header.limit = header.first;
+}
+
 template <typename T, Invocable auto alloc>
 constexpr void
 erase_all(array_double_ended<T, alloc>& x)
 {
     while (!is_empty(x)) erase(back{x});
+    if (x.header != nullptr) {
+        deallocate_array_double_ended<T, alloc>(x.header);
+        x.header = nullptr;
+    }
 }
 
 template <typename T, Invocable auto alloc>
@@ -7,13 +7,12 @@
 #include "ordering.h"
 #include "swap.h"
 #include "array_double_ended.h"
-
-#define byte char
+#include "array_k.h"
 
 namespace elements {
 
-template <typename T, pointer_diff k = 256, Invocable auto alloc = array_allocator<T>>
-// requires (0 < k) and (k <= max_array_size<T>)
+template <typename T, pointer_diff k = 256, Invocable auto alloc = array_allocator<T>, pointer_diff spare = 1>
+// requires (0 < k) and (k <= max_array_size<T>) and (0 < spare)
 struct array_segmented_double_ended;
 
 template <typename T, pointer_diff k, Invocable auto alloc>
@@ -119,14 +118,14 @@ template <typename T, pointer_diff k, Invocable auto alloc>
 constexpr auto
 at(array_segmented_double_ended_cursor<T, k, alloc> const& cur) -> T const&
 {
-    return at(segment_cur(cur));
+    return at(segment_cursor(cur));
 }
 
 template <typename T, pointer_diff k, Invocable auto alloc>
 constexpr auto
 at(array_segmented_double_ended_cursor<T, k, alloc>& cur) -> T&
 {
-    return at(segment_cur(cur));
+    return at(segment_cursor(cur));
 }
 
 template <typename T, pointer_diff k, Invocable auto alloc>
@@ -136,17 +135,33 @@ precedes(array_segmented_double_ended_cursor<T, k, alloc> const& cur0, array_seg
     return precedes(cur0.index, cur1.index) or precedes(cur0.segment, cur1.segment);
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
-// requires (0 < k) and (k <= max_array_size<T>)
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+// requires (0 < k) and (k <= max_array_size<T>) and (0 < spare)
 struct array_segmented_double_ended
 {
     array_double_ended<array_double_ended<T, alloc>, alloc> index;
+    array_k<array_double_ended<T, alloc>, spare> pool;
+    pointer_diff pool_size{};
 
     constexpr
     array_segmented_double_ended() = default;
 
     constexpr
-    array_segmented_double_ended(Size_type<array_segmented_double_ended<T, k, alloc>> size, T const& x)
+    array_segmented_double_ended(array_segmented_double_ended const& x)
+        : index{x.index}
+    {}
+
+    constexpr
+    array_segmented_double_ended(array_segmented_double_ended&& x)
+        : index{mv(x.index)}
+        , pool{mv(x.pool)}
+        , pool_size{x.pool_size}
+    {
+        x.pool_size = 0;
+    }
+
+    constexpr
+    array_segmented_double_ended(Size_type<array_segmented_double_ended<T, k, alloc, spare>> size, T const& x)
     {
         if (size == Zero<decltype(size)>) return;
         auto n_segments{size / k + min(One<decltype(size)>, size % k)};
@@ -156,6 +171,25 @@ struct array_segmented_double_ended
         }
     }
 
+    constexpr auto
+    operator=(array_segmented_double_ended const& x) -> array_segmented_double_ended&
+    {
+        using elements::swap;
+        array_segmented_double_ended temp(x);
+        swap(index, temp.index);
+        return at(this);
+    }
+
+    constexpr auto
+    operator=(array_segmented_double_ended&& x) -> array_segmented_double_ended&
+    {
+        using elements::swap;
+        if (this != pointer_to(x)) {
+            swap(at(this), x);
+        }
+        return at(this);
+    }
+
     constexpr auto
     operator[](pointer_diff i) -> T&
     {
@@ -181,38 +215,38 @@ struct array_segmented_double_ended
     }
 };
 
-template <typename T, pointer_diff k, Invocable auto alloc>
-struct value_type_t<array_segmented_double_ended<T, k, alloc>>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+struct value_type_t<array_segmented_double_ended<T, k, alloc, spare>>
 {
     using type = T;
 };
 
-template <typename T, pointer_diff k, Invocable auto alloc>
-struct cursor_type_t<array_segmented_double_ended<T, k, alloc>>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+struct cursor_type_t<array_segmented_double_ended<T, k, alloc, spare>>
 {
     using type = array_segmented_double_ended_cursor<T, k, alloc>;
 };
 
-template <typename T, pointer_diff k, Invocable auto alloc>
-struct cursor_type_t<array_segmented_double_ended<T, k, alloc> const>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+struct cursor_type_t<array_segmented_double_ended<T, k, alloc, spare> const>
 {
     using type = array_segmented_double_ended_cursor<T const, k, alloc>;
 };
 
-template <typename T, pointer_diff k, Invocable auto alloc>
-struct size_type_t<array_segmented_double_ended<T, k, alloc>>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+struct size_type_t<array_segmented_double_ended<T, k, alloc, spare>>
 {
     using type = Difference_type<array_segmented_double_ended_cursor<T, k, alloc>>;
 };
 
-template <typename T, pointer_diff k, Invocable auto alloc>
-struct functor_t<array_segmented_double_ended<T, k, alloc>>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+struct functor_t<array_segmented_double_ended<T, k, alloc, spare>>
 {
-    using constructor_type = array_segmented_double_ended<T, k, alloc>;
+    using constructor_type = array_segmented_double_ended<T, k, alloc, spare>;
 
     template <Operation<T> Op>
     static constexpr auto
-    fmap(array_segmented_double_ended<T, k, alloc>& x, Op op) -> array_segmented_double_ended<T, k, alloc>&
+    fmap(array_segmented_double_ended<T, k, alloc, spare>& x, Op op) -> array_segmented_double_ended<T, k, alloc, spare>&
     {
         using elements::copy;
         copy(first(x), limit(x), map_sink{op}(first(x)));
@@ -221,21 +255,21 @@ struct functor_t<array_segmented_double_ended<T, k, alloc>>
 
     template <Regular_invocable<T> F>
     static constexpr auto
-    fmap(array_segmented_double_ended<T, k, alloc>&& x, F fun) -> array_segmented_double_ended<Return_type<F, T>, k, alloc>
+    fmap(array_segmented_double_ended<T, k, alloc, spare>&& x, F fun) -> array_segmented_double_ended<Return_type<F, T>, k, alloc, spare>
     {
         using elements::map;
-        array_segmented_double_ended<Return_type<F, T>, k, alloc> y;
+        array_segmented_double_ended<Return_type<F, T>, k, alloc, spare> y;
         map(first(x), limit(x), insert_sink{}(back{y}), fun);
         return y;
     }
 };
 
-template <typename T, pointer_diff k, Invocable auto alloc>
-struct monad_t<array_segmented_double_ended<T, k, alloc>>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+struct monad_t<array_segmented_double_ended<T, k, alloc, spare>>
 {
     template <Regular_invocable<T> F>
     static constexpr auto
-    bind(array_segmented_double_ended<T, k, alloc>& x, F fun) -> Return_type<F, T>&
+    bind(array_segmented_double_ended<T, k, alloc, spare>& x, F fun) -> Return_type<F, T>&
     {
         using elements::flat_map;
         auto y{flat_map(first(x), limit(x), fun)};
@@ -245,183 +279,223 @@ struct monad_t<array_segmented_double_ended<T, k, alloc>>
 
     template <Regular_invocable<T> F>
     static constexpr auto
-    bind(array_segmented_double_ended<T, k, alloc>&& x, F fun) -> Return_type<F, T>
+    bind(array_segmented_double_ended<T, k, alloc, spare>&& x, F fun) -> Return_type<F, T>
     {
         using elements::flat_map;
         return flat_map(first(x), limit(x), fun);
     }
 };
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-operator==(array_segmented_double_ended<T, k, alloc> const& x, array_segmented_double_ended<T, k, alloc> const& y) -> bool
+operator==(array_segmented_double_ended<T, k, alloc, spare> const& x, array_segmented_double_ended<T, k, alloc, spare> const& y) -> bool
 {
     return x.index == y.index;
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-operator<(array_segmented_double_ended<T, k, alloc> const& x, array_segmented_double_ended<T, k, alloc> const& y) -> bool
+operator<(array_segmented_double_ended<T, k, alloc, spare> const& x, array_segmented_double_ended<T, k, alloc, spare> const& y) -> bool
 {
     return x.index < y.index;
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr void
-swap(array_segmented_double_ended<T, k, alloc>& x, array_segmented_double_ended<T, k, alloc>& y)
+swap(array_segmented_double_ended<T, k, alloc, spare>& x, array_segmented_double_ended<T, k, alloc, spare>& y)
 {
     swap(x.index, y.index);
+    swap(x.pool, y.pool);
+    swap(x.pool_size, y.pool_size);
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc, typename U>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-insert(back<array_segmented_double_ended<T, k, alloc>> arr, U&& x) -> back<array_segmented_double_ended<T, k, alloc>>
+allocate_array_segmented_double_ended_segment(
+    array_segmented_double_ended<T, k, alloc, spare>& x,
+    pointer_diff offset) -> array_double_ended<T, alloc>
+{
+    if (is_zero(x.pool_size)) return array_double_ended<T, alloc>(k, offset);
+    decrement(x.pool_size);
+    array_double_ended<T, alloc> segment(mv(x.pool[x.pool_size]));
+    clear(segment, offset);
+    return segment;
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+constexpr void
+deallocate_array_segmented_double_ended_segment(
+    array_segmented_double_ended<T, k, alloc, spare>& x,
+    array_double_ended<T, alloc>& segment)
+{
+    if (x.pool_size < spare) {
+        clear(segment);
+        swap(x.pool[x.pool_size], segment);
+        increment(x.pool_size);
+    }
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare, typename U>
+constexpr auto
+insert(back<array_segmented_double_ended<T, k, alloc, spare>> arr, U&& x) -> back<array_segmented_double_ended<T, k, alloc, spare>>
 {
     auto& seq = base(arr);
     if (!precedes(limit(seq), limit_of_storage(seq))) {
         if (is_empty(seq)) {
-            emplace(seq.index, array_double_ended<T, alloc>(k, half(k)));
+            emplace(seq.index, allocate_array_segmented_double_ended_segment(seq, half(k)));
         } else {
-            emplace(seq.index, array_double_ended<T, alloc>(k, Zero<decltype(k)>));
+            emplace(seq.index, allocate_array_segmented_double_ended_segment(seq, Zero<decltype(k)>));
         }
     }
     emplace(at(predecessor(limit(seq.index))), fw<U>(x));
     return seq;
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc, typename U>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare, typename U>
 constexpr auto
-insert(front<array_segmented_double_ended<T, k, alloc>> arr, U&& x) -> front<array_segmented_double_ended<T, k, alloc>>
+insert(front<array_segmented_double_ended<T, k, alloc, spare>> arr, U&& x) -> front<array_segmented_double_ended<T, k, alloc, spare>>
 {
     auto& seq = base(arr);
     if (!precedes(first(seq), first_of_storage(seq))) {
         if (is_empty(seq)) {
-            emplace_first(seq.index, array_double_ended<T, alloc>(k, half(k)));
+            emplace_first(seq.index, allocate_array_segmented_double_ended_segment(seq, half(k)));
         } else {
-            emplace_first(seq.index, array_double_ended<T, alloc>(k, k));
+            emplace_first(seq.index, allocate_array_segmented_double_ended_segment(seq, k));
         }
     }
     emplace_first(at(first(seq.index)), fw<U>(x));
     return seq;
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc, typename U>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare, typename U>
 constexpr void
-emplace(array_segmented_double_ended<T, k, alloc>& arr, U&& x)
+emplace(array_segmented_double_ended<T, k, alloc, spare>& arr, U&& x)
 {
     insert(back{arr}, fw<U>(x));
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc, typename U>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare, typename U>
 constexpr void
-emplace_first(array_segmented_double_ended<T, k, alloc>& arr, U&& x)
+emplace_first(array_segmented_double_ended<T, k, alloc, spare>& arr, U&& x)
 {
     insert(front{arr}, fw<U>(x));
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc, typename U>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare, typename U>
 constexpr void
-push(array_segmented_double_ended<T, k, alloc>& arr, U x)
+push(array_segmented_double_ended<T, k, alloc, spare>& arr, U x)
 {
     insert(back{arr}, mv(x));
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc, typename U>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare, typename U>
 constexpr void
-push_first(array_segmented_double_ended<T, k, alloc>& arr, U x)
+push_first(array_segmented_double_ended<T, k, alloc, spare>& arr, U x)
 {
     insert(front{arr}, mv(x));
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-erase(back<array_segmented_double_ended<T, k, alloc>> arr) -> back<array_segmented_double_ended<T, k, alloc>>
+erase(back<array_segmented_double_ended<T, k, alloc, spare>> arr) -> back<array_segmented_double_ended<T, k, alloc, spare>>
 {
     auto& seq = base(arr);
-    auto cur{limit(seq)};
-    pop(at(index_cur(cur)));
-    if (is_empty(load(index_cur(cur)))) {
-        pop(seq.index);
+    auto& segment = at(predecessor(limit(seq.index)));
+    if (size(segment) == 1) {
+        deallocate_array_segmented_double_ended_segment(seq, segment);
+        if (size(seq.index) == 1) {
+            clear(seq.index, half(capacity(seq.index)));
+        } else {
+            pop(seq.index);
+        }
+    } else {
+        pop(segment);
     }
     return arr;
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-erase(front<array_segmented_double_ended<T, k, alloc>> arr) -> front<array_segmented_double_ended<T, k, alloc>>
+erase(front<array_segmented_double_ended<T, k, alloc, spare>> arr) -> front<array_segmented_double_ended<T, k, alloc, spare>>
 {
     auto& seq = base(arr);
-    auto cur{first(seq)};
-    pop_first(at(index_cur(cur)));
-    if (is_empty(load(index_cur(cur)))) {
-        pop_first(seq.index);
+    auto& segment = at(first(seq.index));
+    if (size(segment) == 1) {
+        deallocate_array_segmented_double_ended_segment(seq, segment);
+        if (size(seq.index) == 1) {
+            clear(seq.index, half(capacity(seq.index)));
+        } else {
+            pop_first(seq.index);
+        }
+    } else {
+        pop_first(segment);
     }
     return arr;
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr void
-erase_all(array_segmented_double_ended<T, k, alloc>& x)
+erase_all(array_segmented_double_ended<T, k, alloc, spare>& x)
 {
     erase_all(x.index);
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr void
-pop(array_segmented_double_ended<T, k, alloc>& arr)
+pop(array_segmented_double_ended<T, k, alloc, spare>& arr)
 {
     erase(back{arr});
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr void
-pop_first(array_segmented_double_ended<T, k, alloc>& arr)
+pop_first(array_segmented_double_ended<T, k, alloc, spare>& arr)
 {
     erase(front{arr});
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-first(array_segmented_double_ended<T, k, alloc> const& x) -> Cursor_type<array_segmented_double_ended<T, k, alloc>>
+first(array_segmented_double_ended<T, k, alloc, spare> const& x) -> Cursor_type<array_segmented_double_ended<T, k, alloc, spare>>
 {
     if (is_empty(x)) return {nullptr, nullptr};
     return {first(x.index), first(at(first(x.index)))};
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-limit(array_segmented_double_ended<T, k, alloc> const& x) -> Cursor_type<array_segmented_double_ended<T, k, alloc>>
+limit(array_segmented_double_ended<T, k, alloc, spare> const& x) -> Cursor_type<array_segmented_double_ended<T, k, alloc, spare>>
 {
     if (is_empty(x)) return {nullptr, nullptr};
     return {predecessor(limit(x.index)), limit(at(predecessor(limit(x.index))))};
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-first_of_storage(array_segmented_double_ended<T, k, alloc> const& x) -> Cursor_type<array_segmented_double_ended<T, k, alloc>>
+first_of_storage(array_segmented_double_ended<T, k, alloc, spare> const& x) -> Cursor_type<array_segmented_double_ended<T, k, alloc, spare>>
 {
     if (is_empty(x)) return {nullptr, nullptr};
     return {first(x.index), first_of_storage(at(first(x.index)))};
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-limit_of_storage(array_segmented_double_ended<T, k, alloc> const& x) -> Cursor_type<array_segmented_double_ended<T, k, alloc>>
+limit_of_storage(array_segmented_double_ended<T, k, alloc, spare> const& x) -> Cursor_type<array_segmented_double_ended<T, k, alloc, spare>>
 {
     if (is_empty(x)) return {nullptr, nullptr};
     return {predecessor(limit(x.index)), limit_of_storage(at(predecessor(limit(x.index))))};
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-is_empty(array_segmented_double_ended<T, k, alloc> const& x) -> bool
+is_empty(array_segmented_double_ended<T, k, alloc, spare> const& x) -> bool
 {
     return is_empty(x.index);
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-size(array_segmented_double_ended<T, k, alloc> const& x) -> Size_type<array_segmented_double_ended<T, k, alloc>>
+size(array_segmented_double_ended<T, k, alloc, spare> const& x) -> Size_type<array_segmented_double_ended<T, k, alloc, spare>>
 {
     if (is_empty(x)) return 0;
     if (size(x.index) == 1) return size(load(first(x.index)));
@@ -429,9 +503,9 @@ size(array_segmented_double_ended<T, k, alloc> const& x) -> Size_type<array_segm
     return size(load(first(x.index))) + (predecessor(predecessor(size(x.index))) * k) + size(load(predecessor(limit(x.index))));
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-capacity(array_segmented_double_ended<T, k, alloc> const& x) -> Size_type<array_segmented_double_ended<T, k, alloc>>
+capacity(array_segmented_double_ended<T, k, alloc, spare> const& x) -> Size_type<array_segmented_double_ended<T, k, alloc, spare>>
 {
     return size(x.index) * k;
 }
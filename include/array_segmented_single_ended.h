@@ -6,14 +6,13 @@
 #include "map.h"
 #include "ordering.h"
 #include "swap.h"
+#include "array_k.h"
 #include "array_single_ended.h"
 
-#define byte char
-
 namespace elements {
 
-template <typename T, pointer_diff k = 256, Invocable auto alloc = array_allocator<T>>
-// requires (0 < k) and (k <= max_array_size<T>)
+template <typename T, pointer_diff k = 256, Invocable auto alloc = array_allocator<T>, pointer_diff spare = 1>
+// requires (0 < k) and (k <= max_array_size<T>) and (0 < spare)
 struct array_segmented_single_ended;
 
 template <typename T, pointer_diff k, Invocable auto alloc>
@@ -136,17 +135,33 @@ precedes(array_segmented_single_ended_cursor<T, k, alloc> const& cur0, array_seg
     return precedes(cur0.index, cur1.index) or precedes(cur0.segment, cur1.segment);
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
-// requires (0 < k) and (k <= max_array_size<T>)
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+// requires (0 < k) and (k <= max_array_size<T>) and (0 < spare)
 struct array_segmented_single_ended
 {
     array_single_ended<array_single_ended<T, alloc>, alloc> index;
+    array_k<array_single_ended<T, alloc>, spare> pool;
+    pointer_diff pool_size{};
 
     constexpr
     array_segmented_single_ended() = default;
 
     constexpr
-    array_segmented_single_ended(Size_type<array_segmented_single_ended<T, k, alloc>> size, T const& x)
+    array_segmented_single_ended(array_segmented_single_ended const& x)
+        : index{x.index}
+    {}
+
+    constexpr
+    array_segmented_single_ended(array_segmented_single_ended&& x)
+        : index{mv(x.index)}
+        , pool{mv(x.pool)}
+        , pool_size{x.pool_size}
+    {
+        x.pool_size = 0;
+    }
+
+    constexpr
+    array_segmented_single_ended(Size_type<array_segmented_single_ended<T, k, alloc, spare>> size, T const& x)
     {
         if (size == Zero<decltype(size)>) return;
         auto n_segments{size / k + min(One<decltype(size)>, size % k)};
@@ -156,6 +171,25 @@ struct array_segmented_single_ended
         }
     }
 
+    constexpr auto
+    operator=(array_segmented_single_ended const& x) -> array_segmented_single_ended&
+    {
+        using elements::swap;
+        array_segmented_single_ended temp(x);
+        swap(index, temp.index);
+        return at(this);
+    }
+
+    constexpr auto
+    operator=(array_segmented_single_ended&& x) -> array_segmented_single_ended&
+    {
+        using elements::swap;
+        if (this != pointer_to(x)) {
+            swap(at(this), x);
+        }
+        return at(this);
+    }
+
     constexpr auto
     operator[](pointer_diff i) -> T&
     {
@@ -169,38 +203,38 @@ struct array_segmented_single_ended
     }
 };
 
-template <typename T, pointer_diff k, Invocable auto alloc>
-struct value_type_t<array_segmented_single_ended<T, k, alloc>>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+struct value_type_t<array_segmented_single_ended<T, k, alloc, spare>>
 {
     using type = T;
 };
 
-template <typename T, pointer_diff k, Invocable auto alloc>
-struct cursor_type_t<array_segmented_single_ended<T, k, alloc>>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+struct cursor_type_t<array_segmented_single_ended<T, k, alloc, spare>>
 {
     using type = array_segmented_single_ended_cursor<T, k, alloc>;
 };
 
-template <typename T, pointer_diff k, Invocable auto alloc>
-struct cursor_type_t<array_segmented_single_ended<T, k, alloc> const>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+struct cursor_type_t<array_segmented_single_ended<T, k, alloc, spare> const>
 {
     using type = array_segmented_single_ended_cursor<T const, k, alloc>;
 };
 
-template <typename T, pointer_diff k, Invocable auto alloc>
-struct size_type_t<array_segmented_single_ended<T, k, alloc>>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+struct size_type_t<array_segmented_single_ended<T, k, alloc, spare>>
 {
     using type = Difference_type<array_segmented_single_ended_cursor<T, k, alloc>>;
 };
 
-template <typename T, pointer_diff k, Invocable auto alloc>
-struct functor_t<array_segmented_single_ended<T, k, alloc>>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+struct functor_t<array_segmented_single_ended<T, k, alloc, spare>>
 {
-    using constructor_type = array_segmented_single_ended<T, k, alloc>;
+    using constructor_type = array_segmented_single_ended<T, k, alloc, spare>;
 
     template <Operation<T> Op>
     static constexpr auto
-    fmap(array_segmented_single_ended<T, k, alloc>& x, Op op) -> array_segmented_single_ended<T, k, alloc>&
+    fmap(array_segmented_single_ended<T, k, alloc, spare>& x, Op op) -> array_segmented_single_ended<T, k, alloc, spare>&
     {
         using elements::copy;
         copy(first(x), limit(x), map_sink{op}(first(x)));
@@ -209,21 +243,21 @@ struct functor_t<array_segmented_single_ended<T, k, alloc>>
 
     template <Regular_invocable<T> F>
     static constexpr auto
-    fmap(array_segmented_single_ended<T, k, alloc>&& x, F fun) -> array_segmented_single_ended<Return_type<F, T>, k, alloc>
+    fmap(array_segmented_single_ended<T, k, alloc, spare>&& x, F fun) -> array_segmented_single_ended<Return_type<F, T>, k, alloc, spare>
     {
         using elements::map;
-        array_segmented_single_ended<Return_type<F, T>, k, alloc> y;
+        array_segmented_single_ended<Return_type<F, T>, k, alloc, spare> y;
         map(first(x), limit(x), insert_sink{}(back{y}), fun);
         return y;
     }
 };
 
-template <typename T, pointer_diff k, Invocable auto alloc>
-struct monad_t<array_segmented_single_ended<T, k, alloc>>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+struct monad_t<array_segmented_single_ended<T, k, alloc, spare>>
 {
     template <Regular_invocable<T> F>
     static constexpr auto
-    bind(array_segmented_single_ended<T, k, alloc>& x, F fun) -> Return_type<F, T>&
+    bind(array_segmented_single_ended<T, k, alloc, spare>& x, F fun) -> Return_type<F, T>&
     {
         using elements::flat_map;
         auto y{flat_map(first(x), limit(x), fun)};
@@ -233,129 +267,159 @@ struct monad_t<array_segmented_single_ended<T, k, alloc>>
 
     template <Regular_invocable<T> F>
     static constexpr auto
-    bind(array_segmented_single_ended<T, k, alloc>&& x, F fun) -> Return_type<F, T>
+    bind(array_segmented_single_ended<T, k, alloc, spare>&& x, F fun) -> Return_type<F, T>
     {
         using elements::flat_map;
         return flat_map(first(x), limit(x), fun);
     }
 };
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-operator==(array_segmented_single_ended<T, k, alloc> const& x, array_segmented_single_ended<T, k, alloc> const& y) -> bool
+operator==(array_segmented_single_ended<T, k, alloc, spare> const& x, array_segmented_single_ended<T, k, alloc, spare> const& y) -> bool
 {
     return x.index == y.index;
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-operator<(array_segmented_single_ended<T, k, alloc> const& x, array_segmented_single_ended<T, k, alloc> const& y) -> bool
+operator<(array_segmented_single_ended<T, k, alloc, spare> const& x, array_segmented_single_ended<T, k, alloc, spare> const& y) -> bool
 {
     return x.index < y.index;
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr void
-swap(array_segmented_single_ended<T, k, alloc>& x, array_segmented_single_ended<T, k, alloc>& y)
+swap(array_segmented_single_ended<T, k, alloc, spare>& x, array_segmented_single_ended<T, k, alloc, spare>& y)
 {
     swap(x.index, y.index);
+    swap(x.pool, y.pool);
+    swap(x.pool_size, y.pool_size);
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+constexpr auto
+allocate_array_segmented_single_ended_segment(array_segmented_single_ended<T, k, alloc, spare>& x) -> array_single_ended<T, alloc>
+{
+    if (is_zero(x.pool_size)) return array_single_ended<T, alloc>(k);
+    decrement(x.pool_size);
+    return mv(x.pool[x.pool_size]);
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
+constexpr void
+deallocate_array_segmented_single_ended_segment(
+    array_segmented_single_ended<T, k, alloc, spare>& x,
+    array_single_ended<T, alloc>& segment)
+{
+    if (x.pool_size < spare) {
+        clear(segment);
+        swap(x.pool[x.pool_size], segment);
+        increment(x.pool_size);
+    }
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc, typename U>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare, typename U>
 constexpr auto
-insert(back<array_segmented_single_ended<T, k, alloc>> arr, U&& x) -> back<array_segmented_single_ended<T, k, alloc>>
+insert(back<array_segmented_single_ended<T, k, alloc, spare>> arr, U&& x) -> back<array_segmented_single_ended<T, k, alloc, spare>>
 {
     auto& seq = base(arr);
     if (!precedes(limit(seq), limit_of_storage(seq))) {
-        emplace(seq.index, array_single_ended<T, alloc>(k));
+        emplace(seq.index, allocate_array_segmented_single_ended_segment(seq));
     }
     emplace(at(predecessor(limit(seq.index))), fw<U>(x));
     return seq;
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc, typename U>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare, typename U>
 constexpr void
-emplace(array_segmented_single_ended<T, k, alloc>& arr, U&& x)
+emplace(array_segmented_single_ended<T, k, alloc, spare>& arr, U&& x)
 {
     insert(back{arr}, fw<U>(x));
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc, typename U>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare, typename U>
 constexpr void
-push(array_segmented_single_ended<T, k, alloc>& arr, U x)
+push(array_segmented_single_ended<T, k, alloc, spare>& arr, U x)
 {
     insert(back{arr}, mv(x));
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-erase(back<array_segmented_single_ended<T, k, alloc>> arr) -> back<array_segmented_single_ended<T, k, alloc>>
+erase(back<array_segmented_single_ended<T, k, alloc, spare>> arr) -> back<array_segmented_single_ended<T, k, alloc, spare>>
 {
     auto& seq = base(arr);
-    auto cur{limit(seq)};
-    pop(at(index_cursor(cur)));
-    if (is_empty(load(index_cursor(cur)))) {
-        pop(seq.index);
+    auto& segment = at(predecessor(limit(seq.index)));
+    if (size(segment) == 1) {
+        deallocate_array_segmented_single_ended_segment(seq, segment);
+        if (size(seq.index) == 1) {
+            clear(seq.index);
+        } else {
+            pop(seq.index);
+        }
+    } else {
+        pop(segment);
     }
     return arr;
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr void
-erase_all(array_segmented_single_ended<T, k, alloc>& x)
+erase_all(array_segmented_single_ended<T, k, alloc, spare>& x)
 {
     erase_all(x.index);
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr void
-pop(array_segmented_single_ended<T, k, alloc>& arr)
+pop(array_segmented_single_ended<T, k, alloc, spare>& arr)
 {
     erase(back{arr});
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-first(array_segmented_single_ended<T, k, alloc> const& x) -> Cursor_type<array_segmented_single_ended<T, k, alloc>>
+first(array_segmented_single_ended<T, k, alloc, spare> const& x) -> Cursor_type<array_segmented_single_ended<T, k, alloc, spare>>
 {
     if (is_empty(x)) return {nullptr, nullptr};
     return {first(x.index), first(at(first(x.index)))};
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-limit(array_segmented_single_ended<T, k, alloc> const& x) -> Cursor_type<array_segmented_single_ended<T, k, alloc>>
+limit(array_segmented_single_ended<T, k, alloc, spare> const& x) -> Cursor_type<array_segmented_single_ended<T, k, alloc, spare>>
 {
     if (is_empty(x)) return {nullptr, nullptr};
     return {predecessor(limit(x.index)), limit(at(predecessor(limit(x.index))))};
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-limit_of_storage(array_segmented_single_ended<T, k, alloc> const& x) -> Cursor_type<array_segmented_single_ended<T, k, alloc>>
+limit_of_storage(array_segmented_single_ended<T, k, alloc, spare> const& x) -> Cursor_type<array_segmented_single_ended<T, k, alloc, spare>>
 {
     if (is_empty(x)) return {nullptr, nullptr};
     return {predecessor(limit(x.index)), limit_of_storage(at(predecessor(limit(x.index))))};
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-is_empty(array_segmented_single_ended<T, k, alloc> const& x) -> bool
+is_empty(array_segmented_single_ended<T, k, alloc, spare> const& x) -> bool
 {
     return is_empty(x.index);
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-size(array_segmented_single_ended<T, k, alloc> const& x) -> Size_type<array_segmented_single_ended<T, k, alloc>>
+size(array_segmented_single_ended<T, k, alloc, spare> const& x) -> Size_type<array_segmented_single_ended<T, k, alloc, spare>>
 {
     if (is_empty(x)) return 0;
     return predecessor(size(x.index)) * k + size(load(predecessor(limit(x.index))));
 }
 
-template <typename T, pointer_diff k, Invocable auto alloc>
+template <typename T, pointer_diff k, Invocable auto alloc, pointer_diff spare>
 constexpr auto
-capacity(array_segmented_single_ended<T, k, alloc> const& x) -> Size_type<array_segmented_single_ended<T, k, alloc>>
+capacity(array_segmented_single_ended<T, k, alloc, spare> const& x) -> Size_type<array_segmented_single_ended<T, k, alloc, spare>>
 {
     return size(x.index) * k;
 }
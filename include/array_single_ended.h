@@ -250,11 +250,25 @@ erase(back<array_single_ended<T, alloc>> arr) -> back<array_single_ended<T, allo
     return arr;
 }
 
+template <typename T, Invocable auto alloc>
+constexpr void
+clear(array_single_ended<T, alloc>& x)
+{
+    if (x.header == nullptr) return;
+    auto& header = at(x.header);
+    destroy(pointer_to(header.x), header.limit);
+    header.limit = pointer_to(header.x);
+}
+
 template <typename T, Invocable auto alloc>
 constexpr void
 erase_all(array_single_ended<T, alloc>& x)
 {
     while (!is_empty(x)) erase<T, alloc>(back{x});
+    if (x.header != nullptr) {
+        deallocate_array_single_ended<T, alloc>(x.header);
+        x.header = nullptr;
+    }
 }
 
 template <typename T, Invocable auto alloc>
@@ -0,0 +1,341 @@
+#pragma once
+
+#include "copy.h"
+#include "functional.h"
+#include "lexicographical.h"
+#include "map.h"
+#include "memory.h"
+#include "ordering.h"
+#include "swap.h"
+
+namespace elements {
+
+template <typename T, Invocable auto alloc>
+constexpr auto
+allocate_array_small(Difference_type<Pointer_type<T>> n) -> Pointer_type<T>
+{
+    return reinterpret_cast<Pointer_type<T>>(
+        allocate(alloc(), n * static_cast<pointer_diff>(sizeof(T))).first);
+}
+
+template <typename T, Invocable auto alloc>
+constexpr void
+deallocate_array_small(Pointer_type<T> x, Difference_type<Pointer_type<T>> n)
+{
+    deallocate(alloc(), memory{reinterpret_cast<Pointer_type<byte>>(x), n * static_cast<pointer_diff>(sizeof(T))});
+}
+
+template <typename T, pointer_diff k = 8, Invocable auto alloc = array_allocator<T>>
+requires (0 < k) and (k <= max_array_size<T>)
+struct array_small
+{
+    Pointer_type<T> data{x};
+    pointer_diff size{};
+    pointer_diff capacity{k};
+    union { T x[static_cast<size_t>(k)]; };
+
+    constexpr
+    array_small() {}
+
+    constexpr
+    array_small(array_small const& y)
+    {
+        reserve(at(this), y.size);
+        insert_range(y, back{at(this)});
+    }
+
+    constexpr
+    array_small(array_small&& y)
+    {
+        take_array_small(at(this), y);
+    }
+
+    explicit constexpr
+    array_small(Size_type<array_small<T, k, alloc>> capacity_)
+    {
+        reserve(at(this), capacity_);
+    }
+
+    constexpr
+    array_small(Size_type<array_small<T, k, alloc>> size_, T const& y)
+        : array_small(size_, size_, y)
+    {}
+
+    constexpr
+    array_small(Size_type<array_small<T, k, alloc>> capacity_, Size_type<array_small<T, k, alloc>> size_, T const& y)
+    {
+        reserve(at(this), capacity_);
+        while (!is_zero(size_)) {
+            push(at(this), y);
+            decrement(size_);
+        }
+    }
+
+    constexpr auto
+    operator=(array_small const& y) -> array_small&
+    {
+        using elements::swap;
+        array_small temp(y);
+        swap(at(this), temp);
+        return at(this);
+    }
+
+    constexpr auto
+    operator=(array_small&& y) -> array_small&
+    {
+        if (this != pointer_to(y)) {
+            erase_all(at(this));
+            take_array_small(at(this), y);
+        }
+        return at(this);
+    }
+
+    constexpr
+    ~array_small()
+    {
+        erase_all(at(this));
+    }
+
+    constexpr auto
+    operator[](pointer_diff i) -> T&
+    {
+        return at(data + i);
+    }
+
+    constexpr auto
+    operator[](pointer_diff i) const -> T const&
+    {
+        return load(data + i);
+    }
+};
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+struct value_type_t<array_small<T, k, alloc>>
+{
+    using type = T;
+};
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+struct cursor_type_t<array_small<T, k, alloc>>
+{
+    using type = Pointer_type<T>;
+};
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+struct cursor_type_t<array_small<T, k, alloc> const>
+{
+    using type = Pointer_type<T const>;
+};
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+struct size_type_t<array_small<T, k, alloc>>
+{
+    using type = pointer_diff;
+};
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+struct functor_t<array_small<T, k, alloc>>
+{
+    using constructor_type = array_small<T, k, alloc>;
+
+    template <Operation<T> Op>
+    static constexpr auto
+    fmap(array_small<T, k, alloc>& x, Op op) -> array_small<T, k, alloc>&
+    {
+        using elements::copy;
+        copy(first(x), limit(x), map_sink{op}(first(x)));
+        return x;
+    }
+
+    template <Regular_invocable<T> F>
+    static constexpr auto
+    fmap(array_small<T, k, alloc>&& x, F fun) -> array_small<Return_type<F, T>, k, alloc>
+    {
+        using elements::map;
+        array_small<Return_type<F, T>, k, alloc> y;
+        reserve(y, size(x));
+        map(first(x), limit(x), insert_sink{}(back{y}), fun);
+        return y;
+    }
+};
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+constexpr auto
+is_inline(array_small<T, k, alloc> const& x) -> bool
+{
+    return x.data == x.x;
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+constexpr void
+take_array_small(array_small<T, k, alloc>& x, array_small<T, k, alloc>& y)
+//[[expects: is_empty(x) and is_inline(x)]]
+{
+    if (is_inline(y)) {
+        relocate(y.data, y.data + y.size, x.data);
+    } else {
+        x.data = y.data;
+        x.capacity = y.capacity;
+        y.data = y.x;
+        y.capacity = k;
+    }
+    x.size = y.size;
+    y.size = Zero<pointer_diff>;
+}
+
+template <Regular T, pointer_diff k, Invocable auto alloc>
+constexpr auto
+operator==(array_small<T, k, alloc> const& x, array_small<T, k, alloc> const& y) -> bool
+{
+    return equal_range(x, y);
+}
+
+template <Default_totally_ordered T, pointer_diff k, Invocable auto alloc>
+constexpr auto
+operator<(array_small<T, k, alloc> const& x, array_small<T, k, alloc> const& y) -> bool
+{
+    return less_range(x, y);
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+constexpr void
+swap(array_small<T, k, alloc>& x, array_small<T, k, alloc>& y)
+{
+    if (!is_inline(x) and !is_inline(y)) {
+        swap(x.data, y.data);
+        swap(x.size, y.size);
+        swap(x.capacity, y.capacity);
+    } else {
+        array_small<T, k, alloc> temp(mv(x));
+        x = mv(y);
+        y = mv(temp);
+    }
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+constexpr void
+reserve(array_small<T, k, alloc>& x, Size_type<array_small<T, k, alloc>> n)
+{
+    if (n < x.size or n == x.capacity) return;
+    if (n <= k and is_inline(x)) return;
+    auto data = x.x;
+    if (k < n) {
+        data = allocate_array_small<T, alloc>(n);
+    } else {
+        n = k;
+    }
+    relocate(x.data, x.data + x.size, data);
+    if (!is_inline(x)) {
+        deallocate_array_small<T, alloc>(x.data, x.capacity);
+    }
+    x.data = data;
+    x.capacity = n;
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc, typename U>
+constexpr auto
+insert(back<array_small<T, k, alloc>> arr, U&& x) -> back<array_small<T, k, alloc>>
+{
+    auto& seq = base(arr);
+    if (seq.size == seq.capacity) {
+        reserve(seq, twice(seq.size));
+    }
+    construct(at(seq.data + seq.size), fw<U>(x));
+    increment(seq.size);
+    return seq;
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc, typename U>
+constexpr void
+emplace(array_small<T, k, alloc>& arr, U&& x)
+{
+    insert(back{arr}, fw<U>(x));
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc, typename U>
+constexpr void
+push(array_small<T, k, alloc>& arr, U x)
+{
+    insert(back{arr}, mv(x));
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+constexpr auto
+erase(back<array_small<T, k, alloc>> arr) -> back<array_small<T, k, alloc>>
+{
+    auto& seq = base(arr);
+    decrement(seq.size);
+    destroy(at(seq.data + seq.size));
+    return arr;
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+constexpr void
+clear(array_small<T, k, alloc>& x)
+{
+    destroy(x.data, x.data + x.size);
+    x.size = Zero<pointer_diff>;
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+constexpr void
+erase_all(array_small<T, k, alloc>& x)
+{
+    clear(x);
+    if (!is_inline(x)) {
+        deallocate_array_small<T, alloc>(x.data, x.capacity);
+        x.data = x.x;
+        x.capacity = k;
+    }
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+constexpr void
+pop(array_small<T, k, alloc>& arr)
+{
+    erase(back{arr});
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+constexpr auto
+first(array_small<T, k, alloc> const& x) -> Cursor_type<array_small<T, k, alloc>>
+{
+    return x.data;
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+constexpr auto
+limit(array_small<T, k, alloc> const& x) -> Cursor_type<array_small<T, k, alloc>>
+{
+    return x.data + x.size;
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+constexpr auto
+limit_of_storage(array_small<T, k, alloc> const& x) -> Cursor_type<array_small<T, k, alloc>>
+{
+    return x.data + x.capacity;
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+constexpr auto
+is_empty(array_small<T, k, alloc> const& x) -> bool
+{
+    return is_zero(x.size);
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+constexpr auto
+size(array_small<T, k, alloc> const& x) -> Size_type<array_small<T, k, alloc>>
+{
+    return x.size;
+}
+
+template <typename T, pointer_diff k, Invocable auto alloc>
+constexpr auto
+capacity(array_small<T, k, alloc> const& x) -> Size_type<array_small<T, k, alloc>>
+{
+    return x.capacity;
+}
+
+}
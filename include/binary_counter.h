@@ -25,35 +25,136 @@ add_to_counter(C cur, L lim, Op op, Value_type<C> x, Value_type<C> const& zero)
     return x;
 }
 
+inline constexpr pointer_diff binary_counter_depth = 3;
+
+inline constexpr pointer_diff binary_counter_block = pointer_diff{1} << binary_counter_depth;
+
+template <Semiregular T, Operation<T, T> Op>
+constexpr void
+reduce_binary_counter_block(T (&x)[binary_counter_block], Op op)
+// Reduces the block in place into x[0] with the same balanced tree a binary
+// counter builds for the block
+{
+    auto h = binary_counter_block;
+    while (One<pointer_diff> < h) {
+        h = half(h);
+        for (pointer_diff i = 0; i < h; ++i) {
+            x[i] = op(x[twice(i)], x[successor(twice(i))]);
+        }
+    }
+}
+
 template <Semiregular T, Operation<T, T> Op, pointer_diff k = 64>
+requires (0 < k) and (k <= 64)
 struct binary_counter
 {
     Op op;
     T zero;
     array_k<T, k> data;
     pointer_diff size;
+    // Bit i is set if data[i] holds a partial result, so adding is a binary
+    // increment of occupied and needs no comparisons against zero.
+    N<64> occupied;
 
     constexpr
     binary_counter(Op op_, T const& zero_)
         : op(op_)
         , zero(zero_)
-        , data()
+        , data(zero_)
         , size(Zero<pointer_diff>)
+        , occupied(0)
     //[[expects axiom: partially_associative(op)]]
     {}
 
     constexpr void
-    operator()(T const& x)
-    //[[expects: size(at(this)) < k]]
+    operator()(T x)
+    //[[expects: countr_one(occupied) < k]]
     {
-        auto carry(add_to_counter(first(data), first(data) + size, op, x, zero));
-        if (carry != zero) {
-            store(at(first(data) + size), carry);
-            increment(size);
+        add_to_counter(*this, mv(x), Zero<pointer_diff>);
+    }
+
+    template <Cursor C, Limit<C> L>
+    requires Loadable<C> and Same_as<Remove_const<Value_type<C>>, T>
+    constexpr void
+    operator()(C cur, L lim)
+    //[[expects axiom: loadable_range(cur, lim)]]
+    // Adds aligned blocks of binary_counter_block elements, reduced with
+    // reduce_binary_counter_block, at level binary_counter_depth, giving the
+    // same result as adding the elements one by one
+    {
+        auto mask = static_cast<N<64>>(predecessor(binary_counter_block));
+        while (precedes(cur, lim)) {
+            if ((occupied & mask) != 0) {
+                operator()(load(cur));
+                increment(cur);
+                continue;
+            }
+            T x[binary_counter_block];
+            auto n = Zero<pointer_diff>;
+            while (n < binary_counter_block and precedes(cur, lim)) {
+                x[n] = load(cur);
+                increment(n);
+                increment(cur);
+            }
+            if (n < binary_counter_block) {
+                for (pointer_diff i = 0; i < n; ++i) operator()(mv(x[i]));
+                return;
+            }
+            reduce_binary_counter_block(x, op);
+            add_to_counter(*this, mv(x[0]), binary_counter_depth);
         }
     }
+
+    template <Limit<Pointer_type<T const>> L>
+    requires Arithmetic<T>
+    constexpr void
+    operator()(Pointer_type<T const> cur, L lim)
+    //[[expects axiom: loadable_range(cur, lim)]]
+    {
+        auto mask = static_cast<N<64>>(predecessor(binary_counter_block));
+        while (precedes(cur, lim) and (occupied & mask) != 0) {
+            operator()(load(cur));
+            increment(cur);
+        }
+        while (binary_counter_block <= lim - cur) {
+            T x[binary_counter_block];
+            for (pointer_diff i = 0; i < binary_counter_block; ++i) x[i] = cur[i];
+            reduce_binary_counter_block(x, op);
+            add_to_counter(*this, x[0], binary_counter_depth);
+            cur = cur + binary_counter_block;
+        }
+        while (precedes(cur, lim)) {
+            operator()(load(cur));
+            increment(cur);
+        }
+    }
+
+    template <Limit<Pointer_type<T>> L>
+    requires Arithmetic<T>
+    constexpr void
+    operator()(Pointer_type<T> cur, L lim)
+    {
+        operator()(static_cast<Pointer_type<T const>>(cur), static_cast<Pointer_type<T const>>(lim));
+    }
 };
 
+template <Semiregular T, Operation<T, T> Op, pointer_diff k>
+constexpr void
+add_to_counter(binary_counter<T, Op, k>& x, T y, pointer_diff i)
+//[[expects: the bits of x.occupied below i are not set]]
+//[[expects: i + countr_one(x.occupied >> i) < k]]
+{
+    auto j = i + countr_one(x.occupied >> i);
+    x.occupied = x.occupied + (N<64>{1} << i);
+    while (i < j) {
+        y = x.op(x.data[i], y);
+        x.data[i] = x.zero;
+        increment(i);
+    }
+    x.data[j] = mv(y);
+    if (x.size <= j) x.size = successor(j);
+}
+
 template <Semiregular T, Operation<T, T> Op, pointer_diff k>
 struct value_type_t<binary_counter<T, Op, k>>
 {
@@ -99,7 +200,7 @@ template <Semiregular T, Operation<T, T> Op, pointer_diff k>
 constexpr auto
 is_empty(binary_counter<T, Op, k> const& x) noexcept -> bool
 {
-    return x.size != Zero<pointer_diff>;
+    return x.occupied == 0;
 }
 
 template <Semiregular T, Operation<T, T> Op, pointer_diff k>
@@ -40,36 +40,36 @@ operator*(bit x, bit y) -> bit
     return bit{bool(x.v & y.v)};
 }
 
-auto contradiction = [](bit, bit) -> bit { return bit{0}; };
+constexpr auto contradiction = [](bit, bit) -> bit { return bit{0}; };
 
-auto conjunction = [](bit p, bit q) -> bit { return p * q; };
+constexpr auto conjunction = [](bit p, bit q) -> bit { return p * q; };
 
-auto nonimplication = [](bit p, bit q) -> bit { return p + p * q; };
+constexpr auto nonimplication = [](bit p, bit q) -> bit { return p + p * q; };
 
-auto projection_left = [](bit p, bit) -> bit { return p; };
+constexpr auto projection_left = [](bit p, bit) -> bit { return p; };
 
-auto converse_nonimplication = [](bit p, bit q) -> bit { return q + p * q; };
+constexpr auto converse_nonimplication = [](bit p, bit q) -> bit { return q + p * q; };
 
-auto projection_right = [](bit, bit q) -> bit { return q; };
+constexpr auto projection_right = [](bit, bit q) -> bit { return q; };
 
-auto nonequivalence = [](bit p, bit q) -> bit { return p + q; };
+constexpr auto nonequivalence = [](bit p, bit q) -> bit { return p + q; };
 
-auto disjunction = [](bit p, bit q) -> bit { return p + q + p * q; };
+constexpr auto disjunction = [](bit p, bit q) -> bit { return p + q + p * q; };
 
-auto nondisjunction = [](bit p, bit q) -> bit { return bit{1} + p + q + p * q; };
+constexpr auto nondisjunction = [](bit p, bit q) -> bit { return bit{1} + p + q + p * q; };
 
-auto equivalence = [](bit p, bit q) -> bit { return bit{1} + p + q; };
+constexpr auto equivalence = [](bit p, bit q) -> bit { return bit{1} + p + q; };
 
-auto nonprojection_right = [](bit, bit q) -> bit { return bit{1} + q; };
+constexpr auto nonprojection_right = [](bit, bit q) -> bit { return bit{1} + q; };
 
-auto converse_implication = [](bit p, bit q) -> bit { return bit{1} + q + p * q; };
+constexpr auto converse_implication = [](bit p, bit q) -> bit { return bit{1} + q + p * q; };
 
-auto nonprojection_left = [](bit p, bit) -> bit { return bit{1} + p; };
+constexpr auto nonprojection_left = [](bit p, bit) -> bit { return bit{1} + p; };
 
-auto implication = [](bit p, bit q) -> bit { return bit{1} + p + p * q; };
+constexpr auto implication = [](bit p, bit q) -> bit { return bit{1} + p + p * q; };
 
-auto nonconjunction = [](bit p, bit q) -> bit { return bit{1} + p * q; };
+constexpr auto nonconjunction = [](bit p, bit q) -> bit { return bit{1} + p * q; };
 
-auto tautology = [](bit, bit) -> bit { return bit{1}; };
+constexpr auto tautology = [](bit, bit) -> bit { return bit{1}; };
 
 }
@@ -0,0 +1,454 @@
+#pragma once
+
+#include "array_single_ended.h"
+#include "bit.h"
+#include "search_binary.h"
+
+namespace elements {
+
+inline constexpr pointer_diff bit_array_word_size = 64;
+
+constexpr auto
+bit_array_words(pointer_diff n) -> pointer_diff
+// Returns the number of words that hold n bits
+{
+    return (n + predecessor(bit_array_word_size)) / bit_array_word_size;
+}
+
+constexpr auto
+bit_array_mask(pointer_diff n) -> N<64>
+// Returns the word whose low n mod 64 bits are set, or all of them if n is a
+// multiple of 64, that is the mask of the bits in use in the last word
+{
+    auto r = n % bit_array_word_size;
+    if (is_zero(r)) return ~N<64>{0};
+    return (N<64>{1} << r) - 1;
+}
+
+template <Invocable auto alloc = array_allocator<N<64>>>
+struct bit_array
+{
+    // Bit i is bit i mod 64 of word i / 64. The bits of the last word past
+    // the size are zero, so operations and counts can work on whole words
+    array_single_ended<N<64>, alloc> words;
+    pointer_diff n{};
+
+    constexpr
+    bit_array() = default;
+
+    explicit constexpr
+    bit_array(pointer_diff size, bit x = bit{})
+        : words(bit_array_words(size), x.v ? ~N<64>{0} : N<64>{0})
+        , n{size}
+    {
+        if (!is_zero(n)) words[predecessor(bit_array_words(n))] = words[predecessor(bit_array_words(n))] & bit_array_mask(n);
+    }
+
+    constexpr auto
+    operator()(pointer_diff i) const -> bit
+    //[[expects: i < n]]
+    {
+        return bit{((words[i / bit_array_word_size] >> (i % bit_array_word_size)) & 1) != 0};
+    }
+};
+
+template <Invocable auto alloc>
+struct value_type_t<bit_array<alloc>>
+{
+    using type = bit;
+};
+
+template <Invocable auto alloc>
+struct size_type_t<bit_array<alloc>>
+{
+    using type = pointer_diff;
+};
+
+template <Invocable auto alloc>
+constexpr auto
+operator==(bit_array<alloc> const& x, bit_array<alloc> const& y) -> bool
+{
+    return x.n == y.n and x.words == y.words;
+}
+
+template <Invocable auto alloc>
+constexpr auto
+size(bit_array<alloc> const& x) -> pointer_diff
+{
+    return x.n;
+}
+
+template <Invocable auto alloc>
+constexpr auto
+is_empty(bit_array<alloc> const& x) -> bool
+{
+    return is_zero(x.n);
+}
+
+template <Invocable auto alloc>
+constexpr void
+store(bit_array<alloc>& x, pointer_diff i, bit b)
+//[[expects: i < size(x)]]
+{
+    auto& w = x.words[i / bit_array_word_size];
+    auto m = N<64>{1} << (i % bit_array_word_size);
+    w = b.v ? w | m : w & ~m;
+}
+
+template <Invocable auto alloc>
+constexpr void
+push(bit_array<alloc>& x, bit b)
+{
+    if (is_zero(x.n % bit_array_word_size)) push(x.words, N<64>{0});
+    increment(x.n);
+    store(x, predecessor(x.n), b);
+}
+
+struct bit_array_cursor
+{
+    Pointer_type<N<64>> words{};
+    pointer_diff i{};
+    // The bit is read into x by load, which returns a reference to it
+    mutable bit x{};
+
+    constexpr
+    bit_array_cursor() = default;
+
+    constexpr
+    bit_array_cursor(Pointer_type<N<64>> words_, pointer_diff i_)
+        : words{words_}
+        , i{i_}
+    {}
+};
+
+template <>
+struct value_type_t<bit_array_cursor>
+{
+    using type = bit;
+};
+
+template <>
+struct difference_type_t<bit_array_cursor>
+{
+    using type = pointer_diff;
+};
+
+constexpr auto
+operator==(bit_array_cursor const& cur0, bit_array_cursor const& cur1) -> bool
+{
+    return cur0.words == cur1.words and cur0.i == cur1.i;
+}
+
+constexpr void
+increment(bit_array_cursor& cur)
+{
+    increment(cur.i);
+}
+
+constexpr void
+decrement(bit_array_cursor& cur)
+{
+    decrement(cur.i);
+}
+
+constexpr auto
+operator+(bit_array_cursor cur, pointer_diff n) -> bit_array_cursor
+{
+    cur.i = cur.i + n;
+    return cur;
+}
+
+constexpr auto
+operator-(bit_array_cursor const& cur0, bit_array_cursor const& cur1) -> pointer_diff
+{
+    return cur0.i - cur1.i;
+}
+
+constexpr auto
+precedes(bit_array_cursor const& cur0, bit_array_cursor const& cur1) -> bool
+{
+    return cur0.i != cur1.i;
+}
+
+constexpr auto
+load(bit_array_cursor const& cur) -> bit const&
+{
+    cur.x = bit{((cur.words[cur.i / bit_array_word_size] >> (cur.i % bit_array_word_size)) & 1) != 0};
+    return cur.x;
+}
+
+constexpr void
+store(bit_array_cursor& cur, bit const& b)
+{
+    auto& w = cur.words[cur.i / bit_array_word_size];
+    auto m = N<64>{1} << (cur.i % bit_array_word_size);
+    w = b.v ? w | m : w & ~m;
+}
+
+constexpr void
+store(bit_array_cursor& cur, bit&& b)
+{
+    store(cur, static_cast<bit const&>(b));
+}
+
+template <Invocable auto alloc>
+constexpr auto
+first(bit_array<alloc> const& x) -> bit_array_cursor
+{
+    return bit_array_cursor{first(x.words), 0};
+}
+
+template <Invocable auto alloc>
+constexpr auto
+limit(bit_array<alloc> const& x) -> bit_array_cursor
+{
+    return bit_array_cursor{first(x.words), x.n};
+}
+
+template <Invocable auto alloc, Regular_invocable<bit, bit> Op>
+void
+map_bits(bit_array<alloc> const& x, bit_array<alloc> const& y, bit_array<alloc>& z, Op op)
+//[[expects: size(x) == size(y) and size(y) == size(z)]]
+// Stores op(x(i), y(i)) to z(i) for each i, where op is any of the sixteen
+// connectives of bit.h or another binary operation on bits, a word at a time:
+// the truth table of op selects one of the four minterms of each pair of
+// words, which folds to a single bitwise expression when op is inlined.
+// z may be x or y
+{
+    auto truth = [&op](bool p, bool q){ return -N<64>{op(bit{p}, bit{q}).v}; };
+    auto t00 = truth(false, false);
+    auto t01 = truth(false, true);
+    auto t10 = truth(true, false);
+    auto t11 = truth(true, true);
+    auto p = first(x.words);
+    auto q = first(y.words);
+    auto r = first(z.words);
+    auto m = bit_array_words(size(x));
+    for (pointer_diff i = 0; i < m; ++i) {
+        auto a = p[i];
+        auto b = q[i];
+        r[i] = (t00 & ~a & ~b) | (t01 & ~a & b) | (t10 & a & ~b) | (t11 & a & b);
+    }
+    if (!is_zero(m)) r[predecessor(m)] = r[predecessor(m)] & bit_array_mask(size(x));
+}
+
+#if defined(__AVX2__)
+inline auto
+popcount_words_avx2(Pointer_type<N<64> const> x, pointer_diff n) -> pointer_diff
+// Counts the ones of the words x[0, n) four words at a time, looking up the
+// count of each half byte with a byte shuffle and summing the byte counts
+// of up to 31 iterations before widening them, after Mula, Kurz and Lemire
+{
+    auto const table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    auto const low = _mm256_set1_epi8(0x0f);
+    auto total = _mm256_setzero_si256();
+    pointer_diff i = 0;
+    while (i + 4 <= n) {
+        auto bytes = _mm256_setzero_si256();
+        auto l = min(n, i + 4 * 31);
+        while (i + 4 <= l) {
+            auto v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(x + i));
+            auto c0 = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+            auto c1 = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+            bytes = _mm256_add_epi8(bytes, _mm256_add_epi8(c0, c1));
+            i = i + 4;
+        }
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    auto r = static_cast<pointer_diff>(
+        _mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1) +
+        _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3));
+    for (; i < n; ++i) r = r + popcount(x[i]);
+    return r;
+}
+#endif
+
+inline auto
+popcount_words(Pointer_type<N<64> const> x, pointer_diff n) -> pointer_diff
+// Returns the number of ones in the words x[0, n)
+{
+#if defined(__AVX2__)
+    return popcount_words_avx2(x, n);
+#else
+    pointer_diff r = 0;
+    for (pointer_diff i = 0; i < n; ++i) r = r + popcount(x[i]);
+    return r;
+#endif
+}
+
+template <Invocable auto alloc>
+auto
+popcount(bit_array<alloc> const& x) -> pointer_diff
+// Returns the number of ones in x
+{
+    return popcount_words(first(x.words), bit_array_words(size(x)));
+}
+
+template <Invocable auto alloc>
+auto
+find_first_set(bit_array<alloc> const& x, pointer_diff i = 0) -> pointer_diff
+//[[expects: i <= size(x)]]
+// Returns the position of the first one at or after i, or size(x) if there
+// is none, skipping runs of four zero words with a single test
+{
+    auto m = bit_array_words(size(x));
+    auto w = first(x.words);
+    auto j = i / bit_array_word_size;
+    if (j == m) return size(x);
+    auto v = w[j] & (~N<64>{0} << (i % bit_array_word_size));
+    while (is_zero(v)) {
+        increment(j);
+        while (j + 4 <= m and is_zero(w[j] | w[j + 1] | w[j + 2] | w[j + 3])) j = j + 4;
+        if (j == m) return size(x);
+        v = w[j];
+    }
+    return j * bit_array_word_size + countr_zero(v);
+}
+
+inline auto
+select_word(N<64> x, pointer_diff j) -> pointer_diff
+//[[expects: j < popcount(x)]]
+// Returns the position of the one of rank j in x
+{
+#if defined(__BMI2__)
+    return countr_zero(_pdep_u64(N<64>{1} << j, x));
+#else
+    while (!is_zero(j)) {
+        x = x & (x - 1);
+        decrement(j);
+    }
+    return countr_zero(x);
+#endif
+}
+
+template <Invocable auto alloc>
+auto
+rank(bit_array<alloc> const& x, pointer_diff i) -> pointer_diff
+//[[expects: i <= size(x)]]
+// Returns the number of ones before position i
+{
+    auto j = i / bit_array_word_size;
+    auto r = popcount_words(first(x.words), j);
+    if (!is_zero(i % bit_array_word_size)) r = r + popcount(x.words[j] & bit_array_mask(i));
+    return r;
+}
+
+template <Invocable auto alloc>
+auto
+select(bit_array<alloc> const& x, pointer_diff j) -> pointer_diff
+//[[expects: j < popcount(x)]]
+// Returns the position of the one of rank j, that is the i with x(i) set and
+// rank(x, i) == j
+{
+    auto w = first(x.words);
+    pointer_diff i = 0;
+    while (true) {
+        auto c = popcount(w[i]);
+        if (j < c) return i * bit_array_word_size + select_word(w[i], j);
+        j = j - c;
+        increment(i);
+    }
+}
+
+inline constexpr pointer_diff rank_select_block = 512;
+
+inline constexpr pointer_diff rank_select_superblock = 65536;
+
+template <Invocable auto alloc = array_allocator<N<64>>>
+struct rank_select
+{
+    // superblocks holds the number of ones before each superblock of
+    // rank_select_superblock bits followed by the total, and blocks the number
+    // before each block of rank_select_block bits from the start of its
+    // superblock, which fits in 16 bits; together they take 1/32 of the space
+    // of the bits, and leave at most a block of bits to count
+    bit_array<alloc> bits;
+    array_single_ended<N<64>> superblocks;
+    array_single_ended<N<16>> blocks;
+
+    constexpr
+    rank_select() = default;
+
+    explicit
+    rank_select(bit_array<alloc> x)
+        : bits{mv(x)}
+    {
+        constexpr auto block_words = rank_select_block / bit_array_word_size;
+        constexpr auto superblock_blocks = rank_select_superblock / rank_select_block;
+        auto m = bit_array_words(size(bits));
+        auto n_blocks = (m + predecessor(block_words)) / block_words;
+        reserve(blocks, n_blocks);
+        reserve(superblocks, successor((n_blocks + predecessor(superblock_blocks)) / superblock_blocks));
+        auto w = first(bits.words);
+        N<64> total = 0;
+        N<64> base = 0;
+        for (pointer_diff b = 0; b < n_blocks; ++b) {
+            if (is_zero(b % superblock_blocks)) {
+                push(superblocks, total);
+                base = total;
+            }
+            push(blocks, static_cast<N<16>>(total - base));
+            total = total + static_cast<N<64>>(popcount_words(w + b * block_words, min(block_words, m - b * block_words)));
+        }
+        push(superblocks, total);
+    }
+};
+
+template <Invocable auto alloc>
+constexpr auto
+size(rank_select<alloc> const& x) -> pointer_diff
+{
+    return size(x.bits);
+}
+
+template <Invocable auto alloc>
+constexpr auto
+popcount(rank_select<alloc> const& x) -> pointer_diff
+{
+    return static_cast<pointer_diff>(x.superblocks[predecessor(size(x.superblocks))]);
+}
+
+template <Invocable auto alloc>
+auto
+rank(rank_select<alloc> const& x, pointer_diff i) -> pointer_diff
+//[[expects: i <= size(x)]]
+// Returns the number of ones before position i in constant time
+{
+    if (i == size(x)) return popcount(x);
+    auto w = first(x.bits.words);
+    auto b = i / rank_select_block;
+    auto j = i / bit_array_word_size;
+    auto r = static_cast<pointer_diff>(x.superblocks[i / rank_select_superblock]) + static_cast<pointer_diff>(x.blocks[b]);
+    auto c = b * (rank_select_block / bit_array_word_size);
+    r = r + popcount_words(w + c, j - c);
+    if (!is_zero(i % bit_array_word_size)) r = r + popcount(w[j] & bit_array_mask(i));
+    return r;
+}
+
+template <Invocable auto alloc>
+auto
+select(rank_select<alloc> const& x, pointer_diff j) -> pointer_diff
+//[[expects: j < popcount(x)]]
+// Returns the position of the one of rank j, finding its superblock and then
+// its block by binary search on the counts, and its word by counting
+{
+    constexpr auto block_words = rank_select_block / bit_array_word_size;
+    constexpr auto superblock_blocks = rank_select_superblock / rank_select_block;
+    auto sb = first(x.superblocks);
+    auto s = predecessor(search_binary_upper_n(sb, predecessor(size(x.superblocks)), static_cast<N<64>>(j)) - sb);
+    j = j - static_cast<pointer_diff>(sb[s]);
+    auto bl = first(x.blocks) + s * superblock_blocks;
+    auto n = min(superblock_blocks, size(x.blocks) - s * superblock_blocks);
+    auto b = predecessor(search_binary_upper_n(bl, n, static_cast<N<16>>(j)) - bl);
+    j = j - static_cast<pointer_diff>(bl[b]);
+    auto w = first(x.bits.words);
+    auto i = (s * superblock_blocks + b) * block_words;
+    while (true) {
+        auto c = popcount(w[i]);
+        if (j < c) return i * bit_array_word_size + select_word(w[i], j);
+        j = j - c;
+        increment(i);
+    }
+}
+
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "algebra.h"
+#include "instrumented.h"
+#include "integer.h"
+#include "ordering.h"
+#include "perf_counters.h"
+
+namespace elements {
+
+struct operation_counts
+{
+    pointer_diff n{};
+    double counts[instrumented_base::n_ops]{};
+    double ns{};
+    perf_counts events;
+};
+
+template <Invocable<pointer_diff> S, typename R>
+requires Invocable<R, Return_type<S, pointer_diff>&>
+auto
+measure_operations(pointer_diff n, S setup, R run) -> operation_counts
+// Calls setup(n) outside and run on its result inside the measured region,
+// counting the operations on instrumented objects and the hardware events in
+// all threads run joins.
+{
+    auto state = setup(n);
+    perf_counters counters;
+    instrumented_base::initialize(static_cast<size_t>(n));
+    steady_clock::time_point t0;
+    steady_clock::time_point t1;
+    {
+        perf_scope scope{counters};
+        t0 = steady_clock::now();
+        run(state);
+        t1 = steady_clock::now();
+    }
+    operation_counts x;
+    x.n = n;
+    for (size_t i = 0; i < instrumented_base::n_ops; ++i) {
+        x.counts[i] = instrumented_base::total(i);
+    }
+    x.ns = elapsed_ns(t0, t1);
+    x.events = counters.counts;
+    return x;
+}
+
+template <Cursor C, Limit<C> L, Invocable<pointer_diff> S, typename R, Cursor D>
+requires
+    Same_as<Remove_const<Value_type<C>>, pointer_diff> and
+    Same_as<Value_type<D>, operation_counts>
+auto
+tabulate_operations(C cur, L lim, S setup, R run, D dst) -> D
+{
+    while (precedes(cur, lim)) {
+        at(dst) = measure_operations(load(cur), setup, run);
+        increment(cur);
+        increment(dst);
+    }
+    return dst;
+}
+
+enum struct complexity
+{
+    constant, logarithmic, linear, linearithmic, quadratic
+};
+
+inline auto
+growth(complexity model, pointer_diff n) -> double
+{
+    auto x = static_cast<double>(max(n, twice(One<pointer_diff>)));
+    switch (model) {
+        case complexity::constant: return 1.0;
+        case complexity::logarithmic: return log2(x);
+        case complexity::linear: return x;
+        case complexity::linearithmic: return x * log2(x);
+        case complexity::quadratic: return x * x;
+    }
+    return 1.0;
+}
+
+struct growth_fit
+{
+    complexity model{complexity::constant};
+    double coefficient{};
+    double deviation{};
+};
+
+template <Cursor C, Limit<C> L, typename P>
+requires
+    Same_as<Remove_const<Value_type<C>>, operation_counts> and
+    Regular_invocable<P, operation_counts const&>
+auto
+fit_growth(C cur, L lim, P proj, complexity model) -> growth_fit
+// Fits y = coefficient * growth(model, n), with the coefficient of variation
+// of the ratios y / growth(model, n) as deviation.
+{
+    auto m = Zero<pointer_diff>;
+    auto sum = 0.0;
+    auto sum_squares = 0.0;
+    while (precedes(cur, lim)) {
+        auto r = proj(load(cur)) / growth(model, load(cur).n);
+        sum = sum + r;
+        sum_squares = sum_squares + r * r;
+        increment(m);
+        increment(cur);
+    }
+    if (is_zero(m)) return {model, 0.0, 0.0};
+    auto mean = sum / static_cast<double>(m);
+    auto variance = max(sum_squares / static_cast<double>(m) - mean * mean, 0.0);
+    return {model, mean, mean == 0.0 ? 0.0 : sqrt(variance) / mean};
+}
+
+template <Cursor C, Limit<C> L, typename P>
+requires
+    Same_as<Remove_const<Value_type<C>>, operation_counts> and
+    Regular_invocable<P, operation_counts const&>
+auto
+fit_growth(C cur, L lim, P proj) -> growth_fit
+// Returns the fit with the smallest deviation, preferring slower growth
+{
+    auto best = fit_growth(cur, lim, proj, complexity::constant);
+    for (auto model : {complexity::logarithmic, complexity::linear, complexity::linearithmic, complexity::quadratic}) {
+        auto x = fit_growth(cur, lim, proj, model);
+        if (x.deviation < best.deviation) best = x;
+    }
+    return best;
+}
+
+template <Cursor C, Limit<C> L>
+requires Same_as<Remove_const<Value_type<C>>, operation_counts>
+auto
+fit_growth(C cur, L lim, size_t operation) -> growth_fit
+{
+    return fit_growth(cur, lim, [operation](operation_counts const& x){ return x.counts[operation]; });
+}
+
+template <Cursor C, Limit<C> L>
+requires Same_as<Remove_const<Value_type<C>>, operation_counts>
+auto
+fit_growth_time(C cur, L lim) -> growth_fit
+{
+    return fit_growth(cur, lim, [](operation_counts const& x){ return x.ns; });
+}
+
+inline auto
+is_regression(growth_fit const& x, growth_fit const& expected, double tolerance = 0.1) -> bool
+// Returns true if x grows faster than expected, or as fast with a coefficient
+// more than tolerance above the expected one.
+{
+    if (x.model != expected.model) return expected.model < x.model;
+    return expected.coefficient * (1.0 + tolerance) < x.coefficient;
+}
+
+}
@@ -43,6 +43,58 @@ copy_n(S src, N n, D dst) -> pair<S, D>
    return {mv(src), mv(dst)};
 }
 
+template <Trivially_copyable T, Trivially_copyable U>
+requires Same_as<Remove_const<T>, U>
+constexpr auto
+copy(Pointer_type<T> src, Pointer_type<T> lim, Pointer_type<U> dst) -> Pointer_type<U>
+//[[expects axiom: not_overlapped_forward(src, lim, dst, dst + (lim - src))]]
+{
+    if (is_constant_evaluated()) {
+        while (precedes(src, lim)) copy_step(src, dst);
+        return dst;
+    }
+    if (src == lim) return dst;
+    auto n = lim - src;
+    copy_bytes(src, n * static_cast<pointer_diff>(sizeof(T)), dst);
+    return dst + n;
+}
+
+template <Cursor S, Integer N, Forward_cursor D>
+requires
+    Same_as<Remove_const<Value_type<S>>, Value_type<D>> and
+    Copy_constructible<Value_type<D>>
+constexpr auto
+construct_copy_n(S src, N n, D dst) -> pair<S, D>
+//[[expects axiom: raw_memory_range(dst, dst + n)]]
+{
+    while (count_down(n)) {
+        construct_at(addressof(at(dst)), load(src));
+        increment(src);
+        increment(dst);
+    }
+    return {mv(src), mv(dst)};
+}
+
+template <Trivially_copyable T, Integer N, Trivially_copyable U>
+requires Same_as<Remove_const<T>, U>
+constexpr auto
+construct_copy_n(Pointer_type<T> src, N n, Pointer_type<U> dst) -> pair<Pointer_type<T>, Pointer_type<U>>
+//[[expects axiom: raw_memory_range(dst, dst + n)]]
+{
+    if (is_constant_evaluated()) {
+        while (count_down(n)) {
+            construct_at(dst, load(src));
+            increment(src);
+            increment(dst);
+        }
+        return {src, dst};
+    }
+    if (is_zero(n)) return {src, dst};
+    auto m = static_cast<pointer_diff>(n);
+    copy_bytes(src, m * static_cast<pointer_diff>(sizeof(T)), dst);
+    return {src + m, dst + m};
+}
+
 template <Segmented_cursor S, Cursor D>
 requires Indirectly_copyable<S, D>
 constexpr auto
@@ -54,11 +106,12 @@ copy(S src, S lim, D dst) -> D
         return copy(segment_cursor(src), segment_cursor(lim), dst);
     } else {
         dst = copy(segment_cursor(src), limit(load(index_src)), dst);
-        do {
-            increment(index_src);
+        increment(index_src);
+        while (precedes(index_src, index_lim)) {
             dst = copy(first(load(index_src)), limit(load(index_src)), dst);
-        } while (precedes(index_src, index_lim));
-        return dst;
+            increment(index_src);
+        }
+        return copy(first(load(index_src)), segment_cursor(lim), dst);
     }
 }
 
@@ -79,6 +132,125 @@ copy_select(S src, L lim, D dst, P pred) -> D
     return dst;
 }
 
+#if defined(__AVX2__)
+
+struct compress_permutation_table
+{
+    N<8> lanes[256][8];
+};
+
+inline constexpr auto compress_permutations = [](){
+    // Entry m moves the lanes selected by the bits of m to the front and the
+    // others to the back, each in order
+    compress_permutation_table t{};
+    for (pointer_diff m = 0; m < 256; ++m) {
+        pointer_diff k = 0;
+        for (pointer_diff l = 0; l < 8; ++l) {
+            if (((m >> l) & 1) != 0) t.lanes[m][k++] = static_cast<N<8>>(l);
+        }
+        for (pointer_diff l = 0; l < 8; ++l) {
+            if (((m >> l) & 1) == 0) t.lanes[m][k++] = static_cast<N<8>>(l);
+        }
+    }
+    return t;
+}();
+
+#endif
+
+inline constexpr pointer_diff copy_select_block = 256;
+
+template <Arithmetic T>
+auto
+copy_flagged(Pointer_type<T const> src, pointer_diff n, Pointer_type<N<8> const> flags, Pointer_type<T> dst) -> Pointer_type<T>
+//[[expects: n <= copy_select_block]]
+//[[expects: flags are zero or one]]
+// Copies the elements of src whose flags are one to dst and returns the limit
+// of the copies. For 32 and 64-bit elements a register of them is compacted
+// at a time, with a compressing store on AVX-512 and with a permutation from
+// a table and a masked store on AVX2, so that nothing is stored past the
+// copies; the other elements are stored unconditionally to a buffer and kept
+// by advancing by their flags.
+{
+    pointer_diff i = 0;
+#if defined(__AVX512F__)
+    if constexpr (sizeof(T) == 4 or sizeof(T) == 8) {
+        constexpr auto v = 64 / static_cast<pointer_diff>(sizeof(T));
+        auto zero = _mm_setzero_si128();
+        while (i + v <= n) {
+            auto x = _mm512_loadu_si512(src + i);
+            if constexpr (v == 16) {
+                auto m = static_cast<__mmask16>(_mm_movemask_epi8(_mm_sub_epi8(zero, _mm_loadu_si128(reinterpret_cast<__m128i const*>(flags + i)))));
+                _mm512_mask_compressstoreu_epi32(dst, m, x);
+                dst = dst + popcount(static_cast<N<32>>(m));
+            } else {
+                auto m = static_cast<__mmask8>(_mm_movemask_epi8(_mm_sub_epi8(zero, _mm_loadl_epi64(reinterpret_cast<__m128i const*>(flags + i)))));
+                _mm512_mask_compressstoreu_epi64(dst, m, x);
+                dst = dst + popcount(static_cast<N<32>>(m));
+            }
+            i = i + v;
+        }
+    }
+#elif defined(__AVX2__)
+    if constexpr (sizeof(T) == 4 or sizeof(T) == 8) {
+        constexpr auto v = 32 / static_cast<pointer_diff>(sizeof(T));
+        auto zero = _mm256_setzero_si256();
+        auto lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        while (i + v <= n) {
+            // The flags are widened to the lanes of the elements and negated
+            // to all ones, so that the mask has a bit per 32-bit lane
+            __m256i selected;
+            if constexpr (v == 8) selected = _mm256_sub_epi32(zero, _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(flags + i))));
+            else selected = _mm256_sub_epi64(zero, _mm256_cvtepu8_epi64(_mm_loadu_si32(flags + i)));
+            auto m = _mm256_movemask_ps(_mm256_castsi256_ps(selected));
+            auto c = popcount(static_cast<N<32>>(m));
+            auto perm = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(compress_permutations.lanes[m])));
+            auto x = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + i)), perm);
+            _mm256_maskstore_epi32(reinterpret_cast<int*>(dst), _mm256_cmpgt_epi32(_mm256_set1_epi32(c), lanes), x);
+            dst = dst + c * 4 / static_cast<int>(sizeof(T));
+            i = i + v;
+        }
+    }
+#endif
+    T buffer[copy_select_block];
+    pointer_diff k = 0;
+    while (i < n) {
+        buffer[k] = src[i];
+        k = k + flags[i];
+        increment(i);
+    }
+    if (!is_zero(k)) copy_bytes(buffer, k * static_cast<pointer_diff>(sizeof(T)), dst);
+    return dst + k;
+}
+
+template <Arithmetic T, Arithmetic U, Predicate<Pointer_type<T>> P>
+requires Same_as<Remove_const<T>, U>
+constexpr auto
+copy_select(Pointer_type<T> src, Pointer_type<T> lim, Pointer_type<U> dst, P pred) -> Pointer_type<U>
+//[[expects axiom: not_overlapped_forward(src, lim, dst, dst + (# of cursors satisfying pred))]]
+// Evaluates pred on a block of elements into flags, in a loop without
+// branches that vectorizes for simple predicates, and compacts the block
+// with copy_flagged
+{
+    if (is_constant_evaluated()) {
+        while (precedes(src, lim)) {
+            if (invoke(pred, src)) {
+                copy_step(src, dst);
+            } else {
+                increment(src);
+            }
+        }
+        return dst;
+    }
+    N<8> flags[copy_select_block];
+    while (src != lim) {
+        auto n = lim - src < copy_select_block ? lim - src : copy_select_block;
+        for (pointer_diff i = 0; i < n; ++i) flags[i] = static_cast<N<8>>(static_cast<bool>(invoke(pred, src + i)));
+        dst = copy_flagged<U>(src, n, flags, dst);
+        src = src + n;
+    }
+    return dst;
+}
+
 template <Loadable L, Predicate<Value_type<L>> P>
 struct predicate_load
 {
@@ -32,6 +32,26 @@ count_if(C cur, L lim, P pred, N count = Zero<N>) -> N
     return get<1>(for_each(mv(cur), lim, predicate_counter<Value_type<C>, P, N>{pred, count})).count;
 }
 
+template <Segmented_cursor C, Predicate<Value_type<C>> P, Cursor N = Difference_type<C>>
+requires Loadable<C>
+constexpr auto
+count_if(C cur, C lim, P pred, N count = Zero<N>) -> N
+{
+    auto index_cur = index_cursor(cur);
+    auto index_lim = index_cursor(lim);
+    if (!precedes(index_cur, index_lim)) {
+        return count_if(segment_cursor(cur), segment_cursor(lim), pred, count);
+    } else {
+        count = count_if(segment_cursor(cur), limit(load(index_cur)), pred, count);
+        increment(index_cur);
+        while (precedes(index_cur, index_lim)) {
+            count = count_if(first(load(index_cur)), limit(load(index_cur)), pred, count);
+            increment(index_cur);
+        }
+        return count_if(first(load(index_cur)), segment_cursor(lim), pred, count);
+    }
+}
+
 template <Cursor C, Limit<C> L, Predicate<Value_type<C>> P, Cursor N = Difference_type<C>>
 requires Loadable<C>
 constexpr auto
@@ -41,6 +61,14 @@ count_if_not(C cur, L lim, P pred, N count = Zero<N>) -> N
     return count_if(mv(cur), lim, negation<Value_type<C>, P>{pred}, count);
 }
 
+template <Segmented_cursor C, Predicate<Value_type<C>> P, Cursor N = Difference_type<C>>
+requires Loadable<C>
+constexpr auto
+count_if_not(C cur, C lim, P pred, N count = Zero<N>) -> N
+{
+    return count_if(mv(cur), mv(lim), negation<Value_type<C>, P>{pred}, count);
+}
+
 template <Cursor C, Limit<C> L, Cursor N = Value_type<C>>
 requires Loadable<C>
 constexpr auto
@@ -50,6 +78,14 @@ count(C cur, L lim, Value_type<C> const& value, N count = Zero<N>) -> N
     return count_if(mv(cur), lim, eq_unary{value}, count);
 }
 
+template <Segmented_cursor C, Cursor N = Value_type<C>>
+requires Loadable<C>
+constexpr auto
+count(C cur, C lim, Value_type<C> const& value, N count = Zero<N>) -> N
+{
+    return count_if(mv(cur), mv(lim), eq_unary{value}, count);
+}
+
 template <Cursor C, Limit<C> L, Cursor N = Value_type<C>>
 requires Loadable<C>
 constexpr auto
@@ -59,4 +95,12 @@ count_not(C cur, L lim, Value_type<C> const& value, N count = Zero<N>) -> N
     return count_if_not(mv(cur), lim, eq_unary{value}, count);
 }
 
+template <Segmented_cursor C, Cursor N = Value_type<C>>
+requires Loadable<C>
+constexpr auto
+count_not(C cur, C lim, Value_type<C> const& value, N count = Zero<N>) -> N
+{
+    return count_if_not(mv(cur), mv(lim), eq_unary{value}, count);
+}
+
 }
@@ -281,6 +281,25 @@ destroy(C src, L lim) -> C
     return src;
 }
 
+template <Forward_cursor S, Limit<S> L, Forward_cursor D>
+requires
+    Same_as<Value_type<S>, Value_type<D>> and
+    Movable<Value_type<S>>
+constexpr auto
+relocate(S src, L lim, D dst) -> D
+//[[expects axiom: mutable_bounded_range(src, lim)]]
+//[[expects axiom: raw_memory_range(dst, dst + (lim - src))]]
+//[[expects axiom: not_overlapped_forward(src, lim, dst, dst + (lim - src))]]
+{
+    while (precedes(src, lim)) {
+        construct_at(addressof(at(dst)), mv(at(src)));
+        destroy_at(addressof(at(src)));
+        increment(src);
+        increment(dst);
+    }
+    return dst;
+}
+
 template <typename C>
 concept Bidirectional_cursor =
     Forward_cursor<C> and
@@ -288,6 +307,25 @@ concept Bidirectional_cursor =
         decrement(cur);
     };
 
+template <Bidirectional_cursor S, Bidirectional_cursor D>
+requires
+    Same_as<Value_type<S>, Value_type<D>> and
+    Movable<Value_type<S>>
+constexpr auto
+relocate_backward(S src, S lim, D dst) -> D
+//[[expects axiom: mutable_bounded_range(src, lim)]]
+//[[expects axiom: raw_memory_range(dst - (lim - src), dst)]]
+//[[expects axiom: not_overlapped_backward(src, lim, dst - (lim - src), dst)]]
+{
+    while (precedes(src, lim)) {
+        decrement(lim);
+        decrement(dst);
+        construct_at(addressof(at(dst)), mv(at(lim)));
+        destroy_at(addressof(at(lim)));
+    }
+    return dst;
+}
+
 template <Bidirectional_cursor C>
 constexpr auto
 predecessor(C cur) -> C
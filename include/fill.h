@@ -28,40 +28,42 @@ fill(C cur, L lim, T const& value, S sink) -> C
     return cur;
 }
 
-template <Segmented_cursor C, Limit<C> L, Movable T>
+template <Segmented_cursor C, Movable T>
 requires Storable<C>
 constexpr auto
-fill(C cur, L lim, T const& value) -> C
+fill(C cur, C lim, T const& value) -> C
 {
     auto index_cur = index_cursor(cur);
     auto index_lim = index_cursor(lim);
     if (!precedes(index_cur, index_lim)) {
         return {index_cur, fill(segment_cursor(cur), segment_cursor(lim), value)};
     } else {
-        auto segment_cur = fill(segment_cursor(cur), limit(load(index_cur)), value);
-        do {
+        fill(segment_cursor(cur), limit(load(index_cur)), value);
+        increment(index_cur);
+        while (precedes(index_cur, index_lim)) {
+            fill(first(load(index_cur)), limit(load(index_cur)), value);
             increment(index_cur);
-            segment_cur = fill(first(load(index_cur)), limit(load(index_cur)), value);
-        } while (precedes(index_cur, index_lim));
-        return {index_cur, segment_cur};
+        }
+        return {index_cur, fill(first(load(index_cur)), segment_cursor(lim), value)};
     }
 }
 
-template <Segmented_cursor C, Limit<C> L, Movable T, Invocable<C, T> S>
+template <Segmented_cursor C, Movable T, Invocable<Segment_cursor_type<C>, T> S>
 constexpr auto
-fill(C cur, L lim, T const& value, S sink) -> C
+fill(C cur, C lim, T const& value, S sink) -> C
 {
     auto index_cur = index_cursor(cur);
     auto index_lim = index_cursor(lim);
     if (!precedes(index_cur, index_lim)) {
         return {index_cur, fill(segment_cursor(cur), segment_cursor(lim), value, sink)};
     } else {
-        auto segment_cur = fill(segment_cursor(cur), limit(load(index_cur)), value, sink);
-        do {
+        fill(segment_cursor(cur), limit(load(index_cur)), value, sink);
+        increment(index_cur);
+        while (precedes(index_cur, index_lim)) {
+            fill(first(load(index_cur)), limit(load(index_cur)), value, sink);
             increment(index_cur);
-            segment_cur = fill(first(load(index_cur)), limit(load(index_cur)), value, sink);
-        } while (precedes(index_cur, index_lim));
-        return {index_cur, segment_cur};
+        }
+        return {index_cur, fill(first(load(index_cur)), segment_cursor(lim), value, sink)};
     }
 }
 
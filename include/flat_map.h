@@ -53,11 +53,14 @@ flat_map(C src, C lim, F fun) -> Return_type<F, Value_type<C>>
         return flat_map(segment_cursor(src), segment_cursor(lim), fun);
     } else {
         auto x = flat_map(segment_cursor(src), limit(load(index_src)), fun);
-        do {
-            increment(index_src);
+        increment(index_src);
+        while (precedes(index_src, index_lim)) {
             auto y = flat_map(first(load(index_src)), limit(load(index_src)), fun);
             insert_range(y, I{x});
-        } while (precedes(index_src, index_lim));
+            increment(index_src);
+        }
+        auto y = flat_map(first(load(index_src)), segment_cursor(lim), fun);
+        insert_range(y, I{x});
         return x;
     }
 }
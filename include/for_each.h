@@ -24,16 +24,19 @@ for_each(C cur, C lim, P proc) -> pair<C, P>
 {
     auto index_cur = index_cursor(cur);
     auto index_lim = index_cursor(lim);
+    auto proc_ref = [&proc](Value_type<C> const& x){ invoke(proc, x); };
     if (!precedes(index_cur, index_lim)) {
-        return for_each(segment_cursor(cur), segment_cursor(lim), proc);
+        for_each(segment_cursor(cur), segment_cursor(lim), proc_ref);
     } else {
-        proc = for_each(segment_cursor(cur), limit(load(index_cur)), proc);
-        do {
+        for_each(segment_cursor(cur), limit(load(index_cur)), proc_ref);
+        increment(index_cur);
+        while (precedes(index_cur, index_lim)) {
+            for_each(first(load(index_cur)), limit(load(index_cur)), proc_ref);
             increment(index_cur);
-            proc = for_each(first(load(index_cur)), limit(load(index_cur)), proc);
-        } while (precedes(index_cur, index_lim));
-        return {mv(cur), mv(proc)};
+        }
+        for_each(first(load(index_cur)), segment_cursor(lim), proc_ref);
     }
+    return {mv(lim), mv(proc)};
 }
 
 template <Cursor C, Invocable<Value_type<C>> P>
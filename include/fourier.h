@@ -0,0 +1,126 @@
+#pragma once
+
+#include "array_single_ended.h"
+#include "modular_integer.h"
+#include "swap.h"
+
+namespace elements {
+
+constexpr auto
+ceil_power_of_two(pointer_diff n) -> pointer_diff
+{
+    auto l = One<pointer_diff>;
+    while (l < n) l = twice(l);
+    return l;
+}
+
+template <typename P>
+requires Invocable<P, pointer_diff, pointer_diff>
+constexpr void
+for_each_bit_reversal_pair(pointer_diff n, P proc)
+//[[expects: n is a power of two]]
+// Calls proc(i, j) for each i < j where j is i with its log2(n) bits reversed
+{
+    auto j = Zero<pointer_diff>;
+    for (pointer_diff i = 1; i < n; ++i) {
+        auto bit = half(n);
+        while ((j & bit) != 0) {
+            j = j ^ bit;
+            bit = half(bit);
+        }
+        j = j ^ bit;
+        if (i < j) proc(i, j);
+    }
+}
+
+template <N<32> m>
+inline constexpr auto modular_primitive_root = modular_integer<m>{static_cast<N<32>>(primitive_root(m))};
+
+template <N<32> m>
+inline constexpr pointer_diff number_theoretic_transform_max_size = pointer_diff{1} << min(countr_zero(m - 1), 30);
+
+template <N<32> m>
+requires (is_prime(m))
+void
+number_theoretic_transform(Pointer_type<modular_integer<m>> x, pointer_diff n, bool inverse)
+//[[expects: n is a power of two and n <= number_theoretic_transform_max_size<m>]]
+// Evaluates x at the powers of a primitive n:th root of unity in place, or
+// interpolates if inverse, using iterative radix-2 butterflies
+{
+    using R = modular_integer<m>;
+    for_each_bit_reversal_pair(n, [x](pointer_diff i, pointer_diff j){
+        swap(x[i], x[j]);
+    });
+    // The powers of the root of unity are tabulated once, so the butterflies
+    // of a stage do not depend on each other through a running product.
+    auto h_n = half(n);
+    auto w_n = power(modular_primitive_root<m>, (m - 1) / static_cast<N<64>>(max(n, One<pointer_diff>)));
+    if (inverse) w_n = reciprocal_op<R>{}(w_n);
+    array_single_ended<R> roots(max(h_n, One<pointer_diff>), One<R>);
+    auto r = first(roots);
+    for (pointer_diff k = 1; k < h_n; ++k) r[k] = r[predecessor(k)] * w_n;
+    for (pointer_diff len = 2; len <= n; len = twice(len)) {
+        auto h = half(len);
+        auto stride = n / len;
+        for (pointer_diff i = 0; i < n; i = i + len) {
+            for (pointer_diff j = 0; j < h; ++j) {
+                auto u = x[i + j];
+                auto v = x[i + j + h] * r[j * stride];
+                x[i + j] = u + v;
+                x[i + j + h] = u - v;
+            }
+        }
+    }
+    if (inverse) {
+        auto n_inverse = reciprocal_op<R>{}(R{n});
+        for (pointer_diff i = 0; i < n; ++i) x[i] = x[i] * n_inverse;
+    }
+}
+
+inline void
+fourier_transform(Pointer_type<double> x, pointer_diff n, bool inverse)
+//[[expects: n is a power of two]]
+// Transforms the n complex numbers stored as interleaved real and imaginary
+// parts in x[0, 2n) in place with iterative radix-2 butterflies; the inverse
+// includes the division by n
+{
+    for_each_bit_reversal_pair(n, [x](pointer_diff i, pointer_diff j){
+        swap(x[twice(i)], x[twice(j)]);
+        swap(x[successor(twice(i))], x[successor(twice(j))]);
+    });
+    // The roots of unity are computed directly rather than by repeated
+    // multiplication to keep the rounding error independent of n.
+    auto h_n = half(n);
+    array_single_ended<double> roots(max(twice(h_n), One<pointer_diff>));
+    auto sign = inverse ? 1.0 : -1.0;
+    for (pointer_diff k = 0; k < h_n; ++k) {
+        auto angle = sign * 2.0 * pi * static_cast<double>(k) / static_cast<double>(n);
+        push(roots, cos(angle));
+        push(roots, sin(angle));
+    }
+    auto r = first(roots);
+    for (pointer_diff len = 2; len <= n; len = twice(len)) {
+        auto h = half(len);
+        auto stride = n / len;
+        for (pointer_diff i = 0; i < n; i = i + len) {
+            for (pointer_diff j = 0; j < h; ++j) {
+                auto w_re = r[twice(j * stride)];
+                auto w_im = r[successor(twice(j * stride))];
+                auto a = twice(i + j);
+                auto b = twice(i + j + h);
+                auto v_re = x[b] * w_re - x[successor(b)] * w_im;
+                auto v_im = x[b] * w_im + x[successor(b)] * w_re;
+                x[b] = x[a] - v_re;
+                x[successor(b)] = x[successor(a)] - v_im;
+                x[a] = x[a] + v_re;
+                x[successor(a)] = x[successor(a)] + v_im;
+            }
+        }
+    }
+    if (inverse) {
+        auto scale = 1.0 / static_cast<double>(n);
+        for (pointer_diff i = 0; i < twice(n); ++i) x[i] = x[i] * scale;
+    }
+}
+
+}
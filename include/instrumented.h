@@ -5,6 +5,27 @@
 
 namespace elements {
 
+struct instrumented_counters
+{
+    static size_t const n_ops = 10;
+
+    double x[n_ops]{};
+
+    constexpr auto
+    operator[](size_t i) -> double&
+    {
+        return x[i];
+    }
+
+    constexpr auto
+    operator[](size_t i) const -> double const&
+    {
+        return x[i];
+    }
+
+    ~instrumented_counters();
+};
+
 struct instrumented_base
 {
     enum operations
@@ -12,8 +33,13 @@ struct instrumented_base
         n, default_construct, copy, assign, move, move_assign, destruct, equal, less
     };
 
-    static size_t const n_ops = 10;
-    static double counts[n_ops];
+    static size_t const n_ops = instrumented_counters::n_ops;
+
+    // Every thread counts into its own counts, which are added to totals
+    // when the thread exits or calls merge_counts.
+    static inline atomic<double> totals[n_ops]{};
+
+    static inline thread_local instrumented_counters counts;
 
     static constexpr char const*
     counter_names[n_ops] =
@@ -29,16 +55,44 @@ struct instrumented_base
         "less"
     };
 
-    static constexpr void
+    static void
+    merge(instrumented_counters& x)
+    {
+        for (size_t i = default_construct; i < n_ops; ++i) {
+            totals[i].fetch_add(x[i], memory_order_relaxed);
+            x[i] = 0.0;
+        }
+    }
+
+    static void
+    merge_counts()
+    {
+        merge(counts);
+    }
+
+    static void
     initialize(size_t m = 0)
+    //[[expects: no other thread is counting]]
     {
-        fill(counts, counts + n_ops, 0.0);
+        fill(counts.x, counts.x + n_ops, 0.0);
+        for (auto& x : totals) x.store(0.0, memory_order_relaxed);
         counts[n] = double(m);
+        totals[n].store(double(m), memory_order_relaxed);
     }
 
+    static auto
+    total(size_t i) -> double
+    {
+        if (i == n) return counts[n];
+        return totals[i].load(memory_order_relaxed) + counts[i];
+    }
 };
 
-double instrumented_base::counts[];
+inline
+instrumented_counters::~instrumented_counters()
+{
+    instrumented_base::merge(at(this));
+}
 
 template <typename T>
 struct instrumented : instrumented_base
@@ -95,6 +95,43 @@ precedes(I const& i0, I const& i1) -> bool
     return i0 < i1;
 }
 
+template <Integral I>
+constexpr auto
+magnitude(I const& a) -> Unsigned_type<I>
+// Returns |a|, which is representable for the minimum of a signed type
+{
+    auto x = static_cast<Unsigned_type<I>>(a);
+    if constexpr (Signed_integral<I>) {
+        if (a < I{0}) x = static_cast<Unsigned_type<I>>(Unsigned_type<I>{0} - x);
+    }
+    return x;
+}
+
+template <Integral I>
+constexpr auto
+gcd_binary(I const& a, I const& b) -> Unsigned_type<I>
+// Returns the nonnegative greatest common divisor with Stein's algorithm,
+// which replaces division by shifts and subtraction; gcd_binary(0, 0) = 0
+{
+    using U = Unsigned_type<I>;
+    auto x = magnitude(a);
+    auto y = magnitude(b);
+    if (x == U{0}) return y;
+    if (y == U{0}) return x;
+    auto k = countr_zero(static_cast<U>(x | y));
+    x = static_cast<U>(x >> countr_zero(x));
+    do {
+        y = static_cast<U>(y >> countr_zero(y));
+        if (y < x) {
+            auto t = x;
+            x = y;
+            y = t;
+        }
+        y = static_cast<U>(y - x);
+    } while (y != U{0});
+    return static_cast<U>(x << k);
+}
+
 template <typename T, typename... Us>
 struct distance_type_t
 {
@@ -1,18 +1,29 @@
 #pragma once
 
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
 #include <concepts>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <numbers>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 
+#if defined(__AVX2__) or defined(__BMI2__) or defined(__SSE4_2__)
+#include <immintrin.h>
+#endif
+
 namespace elements {
 
 template <typename T, typename U>
@@ -106,6 +117,12 @@ using byte = std::byte;
 template <typename T>
 concept Integral = std::is_integral_v<T>;
 
+template <typename T>
+concept Arithmetic = std::is_arithmetic_v<T>;
+
+template <typename T>
+concept Floating_point = std::is_floating_point_v<T>;
+
 template <Integral T>
 inline constexpr auto Min_integral = std::numeric_limits<T>::min();
 
@@ -184,6 +201,54 @@ struct unsigned_integral_t<64>
 template <std::uint8_t n>
 using N = unsigned_integral_t<n>::type;
 
+__extension__ using int128 = __int128;
+
+__extension__ using uint128 = unsigned __int128;
+
+template <Integral T>
+struct wide_integral_t;
+
+template <Integral T>
+requires (sizeof(T) < 8)
+struct wide_integral_t<T>
+{
+    using type = std::conditional_t<Signed_integral<T>, Z<2 * 8 * sizeof(T)>, N<2 * 8 * sizeof(T)>>;
+};
+
+template <Integral T>
+requires (sizeof(T) == 8)
+struct wide_integral_t<T>
+{
+    using type = std::conditional_t<Signed_integral<T>, int128, uint128>;
+};
+
+template <Integral T>
+using Wide_type = typename wide_integral_t<T>::type;
+
+template <typename T>
+requires std::is_unsigned_v<T>
+constexpr auto
+countr_one(T x) -> int
+{
+    return std::countr_one(x);
+}
+
+template <typename T>
+requires std::is_unsigned_v<T>
+constexpr auto
+countr_zero(T x) -> int
+{
+    return std::countr_zero(x);
+}
+
+template <typename T>
+requires std::is_unsigned_v<T>
+constexpr auto
+popcount(T x) -> int
+{
+    return std::popcount(x);
+}
+
 template <typename F, typename... Args>
 concept Invocable = std::invocable<F, Args...>;
 
@@ -318,6 +383,66 @@ destroy_at(T* p)
     std::destroy_at(p);
 }
 
+template <typename T>
+concept Trivially_copyable = std::is_trivially_copyable_v<T>;
+
+constexpr auto
+is_constant_evaluated() noexcept -> bool
+{
+    return std::is_constant_evaluated();
+}
+
+inline void
+copy_bytes(void const* src, pointer_diff n, void* dst)
+{
+    std::memmove(dst, src, static_cast<size_t>(n));
+}
+
+template <typename T>
+using atomic = std::atomic<T>;
+
+inline constexpr auto memory_order_relaxed = std::memory_order_relaxed;
+
+inline constexpr auto memory_order_acquire = std::memory_order_acquire;
+
+inline constexpr auto memory_order_release = std::memory_order_release;
+
+inline constexpr pointer_diff cache_line_size = 64;
+
+using steady_clock = std::chrono::steady_clock;
+
+inline auto
+elapsed_ns(steady_clock::time_point t0, steady_clock::time_point t1) -> double
+{
+    return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+inline auto
+log2(double x) -> double
+{
+    return std::log2(x);
+}
+
+inline auto
+sqrt(double x) -> double
+{
+    return std::sqrt(x);
+}
+
+inline auto
+cos(double x) -> double
+{
+    return std::cos(x);
+}
+
+inline auto
+sin(double x) -> double
+{
+    return std::sin(x);
+}
+
+inline constexpr double pi = std::numbers::pi;
+
 using mutex = std::mutex;
 
 template <typename T>
@@ -330,6 +455,15 @@ inline constexpr auto try_lock = std::try_to_lock;
 
 using condition_variable = std::condition_variable;
 
+using thread = std::thread;
+
+inline auto
+hardware_concurrency() -> pointer_diff
+{
+    auto n = static_cast<pointer_diff>(std::thread::hardware_concurrency());
+    return n == 0 ? 1 : n;
+}
+
 inline void
 notify_one(condition_variable& x)
 {
@@ -128,4 +128,12 @@ precedes(list_doubly_linked_cursor<T> const& cur0, list_doubly_linked_cursor<T>
     return precedes(cur0.cur, cur1.cur);
 }
 
+template <typename T>
+constexpr void
+erase(list_doubly_linked_cursor<T> cur)
+{
+    set_link_bidirectional(predecessor(cur), successor(cur));
+    delete cur.cur;
+}
+
 }
@@ -274,14 +274,6 @@ erase(back<list_doubly_linked_front_back<T>> list) -> back<list_doubly_linked_fr
     return list;
 }
 
-template <typename T>
-constexpr void
-erase(list_doubly_linked_cursor<T> cur)
-{
-    set_link_bidirectional(predecessor(cur), successor(cur));
-    delete cur.cur;
-}
-
 template <typename T>
 constexpr void
 erase_all(list_doubly_linked_front_back<T>& x)
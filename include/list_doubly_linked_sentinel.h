@@ -278,14 +278,6 @@ erase(back<list_doubly_linked_sentinel<T>> list) -> back<list_doubly_linked_sent
     return list;
 }
 
-template <typename T>
-constexpr void
-erase(list_doubly_linked_cursor<T> cur)
-{
-    set_link_bidirectional(predecessor(cur), successor(cur));
-    delete cur.cur;
-}
-
 template <typename T>
 constexpr void
 erase_all(list_doubly_linked_sentinel<T>& x)
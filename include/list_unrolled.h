@@ -0,0 +1,709 @@
+#pragma once
+
+#include "flat_map.h"
+#include "functional.h"
+#include "lexicographical.h"
+#include "map.h"
+#include "ordering.h"
+#include "swap.h"
+
+namespace elements {
+
+template <typename T, pointer_diff k>
+requires (0 < k) and (k <= max_array_size<T>)
+struct list_node_unrolled
+{
+    Pointer_type<list_node_unrolled<T, k>> next{};
+    Pointer_type<list_node_unrolled<T, k>> prev{};
+    pointer_diff size{};
+    union { T x[static_cast<size_t>(k)]; };
+
+    explicit constexpr
+    list_node_unrolled(
+        Pointer_type<list_node_unrolled<T, k>> next_ = {},
+        Pointer_type<list_node_unrolled<T, k>> prev_ = {})
+        : next{next_}
+        , prev{prev_}
+    {}
+
+    constexpr
+    ~list_node_unrolled() {}
+};
+
+template <typename T, pointer_diff k>
+constexpr auto
+first(list_node_unrolled<T, k> const& x) -> Pointer_type<T>
+{
+    return const_cast<Pointer_type<T>>(x.x);
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+limit(list_node_unrolled<T, k> const& x) -> Pointer_type<T>
+{
+    return first(x) + x.size;
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+is_empty(list_node_unrolled<T, k> const& x) -> bool
+{
+    return is_zero(x.size);
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+is_full(list_node_unrolled<T, k> const& x) -> bool
+{
+    return x.size == k;
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+size(list_node_unrolled<T, k> const& x) -> pointer_diff
+{
+    return x.size;
+}
+
+template <typename T, pointer_diff k>
+struct list_unrolled_index_cursor
+{
+    Pointer_type<list_node_unrolled<T, k>> node{};
+
+    constexpr
+    list_unrolled_index_cursor() = default;
+
+    constexpr
+    list_unrolled_index_cursor(Pointer_type<list_node_unrolled<T, k>> node_)
+        : node{node_}
+    {}
+};
+
+template <typename T, pointer_diff k>
+struct value_type_t<list_unrolled_index_cursor<T, k>>
+{
+    using type = list_node_unrolled<T, k>;
+};
+
+template <typename T, pointer_diff k>
+struct difference_type_t<list_unrolled_index_cursor<T, k>>
+{
+    using type = pointer_diff;
+};
+
+template <typename T, pointer_diff k>
+constexpr auto
+operator==(list_unrolled_index_cursor<T, k> const& cur0, list_unrolled_index_cursor<T, k> const& cur1) -> bool
+{
+    return cur0.node == cur1.node;
+}
+
+template <typename T, pointer_diff k>
+constexpr void
+increment(list_unrolled_index_cursor<T, k>& cur)
+{
+    cur.node = load(cur.node).next;
+}
+
+template <typename T, pointer_diff k>
+constexpr void
+decrement(list_unrolled_index_cursor<T, k>& cur)
+{
+    cur.node = load(cur.node).prev;
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+load(list_unrolled_index_cursor<T, k> const& cur) -> list_node_unrolled<T, k> const&
+{
+    return load(cur.node);
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+at(list_unrolled_index_cursor<T, k> const& cur) -> list_node_unrolled<T, k> const&
+{
+    return load(cur.node);
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+at(list_unrolled_index_cursor<T, k>& cur) -> list_node_unrolled<T, k>&
+{
+    return at(cur.node);
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+precedes(list_unrolled_index_cursor<T, k> const& cur0, list_unrolled_index_cursor<T, k> const& cur1) -> bool
+{
+    return precedes(cur0.node, cur1.node);
+}
+
+template <typename T, pointer_diff k>
+struct list_unrolled_cursor
+{
+    list_unrolled_index_cursor<T, k> index{};
+    Pointer_type<T> segment{};
+
+    constexpr
+    list_unrolled_cursor() = default;
+
+    constexpr
+    list_unrolled_cursor(list_unrolled_index_cursor<T, k> index_, Pointer_type<T> segment_)
+        : index{index_}
+        , segment{segment_}
+    {}
+};
+
+template <typename T, pointer_diff k>
+struct value_type_t<list_unrolled_cursor<T, k>>
+{
+    using type = T;
+};
+
+template <typename T, pointer_diff k>
+struct difference_type_t<list_unrolled_cursor<T, k>>
+{
+    using type = pointer_diff;
+};
+
+template <typename T, pointer_diff k>
+struct index_cursor_type_t<list_unrolled_cursor<T, k>>
+{
+    using type = list_unrolled_index_cursor<T, k>;
+};
+
+template <typename T, pointer_diff k>
+struct segment_cursor_type_t<list_unrolled_cursor<T, k>>
+{
+    using type = Pointer_type<T>;
+};
+
+template <typename T, pointer_diff k>
+constexpr auto
+operator==(list_unrolled_cursor<T, k> const& cur0, list_unrolled_cursor<T, k> const& cur1) -> bool
+{
+    return cur0.segment == cur1.segment;
+}
+
+template <typename T, pointer_diff k>
+constexpr void
+increment(list_unrolled_cursor<T, k>& cur)
+{
+    increment(cur.segment);
+    auto const& node = load(cur.index);
+    if (!precedes(cur.segment, limit(node)) and node.next != nullptr) {
+        increment(cur.index);
+        cur.segment = first(load(cur.index));
+    }
+}
+
+template <typename T, pointer_diff k>
+constexpr void
+decrement(list_unrolled_cursor<T, k>& cur)
+{
+    if (!precedes(first(load(cur.index)), cur.segment)) {
+        decrement(cur.index);
+        cur.segment = limit(load(cur.index));
+    }
+    decrement(cur.segment);
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+index_cursor(list_unrolled_cursor<T, k> const& cur) -> Index_cursor_type<list_unrolled_cursor<T, k>> const&
+{
+    return cur.index;
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+index_cursor(list_unrolled_cursor<T, k>& cur) -> Index_cursor_type<list_unrolled_cursor<T, k>>&
+{
+    return cur.index;
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+segment_cursor(list_unrolled_cursor<T, k> const& cur) -> Segment_cursor_type<list_unrolled_cursor<T, k>> const&
+{
+    return cur.segment;
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+segment_cursor(list_unrolled_cursor<T, k>& cur) -> Segment_cursor_type<list_unrolled_cursor<T, k>>&
+{
+    return cur.segment;
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+load(list_unrolled_cursor<T, k> const& cur) -> T const&
+{
+    return load(cur.segment);
+}
+
+template <typename T, pointer_diff k>
+constexpr void
+store(list_unrolled_cursor<T, k>& cur, T const& value)
+{
+    store(cur.segment, value);
+}
+
+template <typename T, pointer_diff k>
+constexpr void
+store(list_unrolled_cursor<T, k>& cur, T&& value)
+{
+    store(cur.segment, fw<T>(value));
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+at(list_unrolled_cursor<T, k> const& cur) -> T const&
+{
+    return at(cur.segment);
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+at(list_unrolled_cursor<T, k>& cur) -> T&
+{
+    return at(cur.segment);
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+precedes(list_unrolled_cursor<T, k> const& cur0, list_unrolled_cursor<T, k> const& cur1) -> bool
+{
+    return precedes(cur0.segment, cur1.segment);
+}
+
+template <typename T, pointer_diff k = 16>
+requires (0 < k) and (k <= max_array_size<T>)
+struct list_unrolled
+{
+    Pointer_type<list_node_unrolled<T, k>> head{};
+    Pointer_type<list_node_unrolled<T, k>> tail{};
+
+    constexpr
+    list_unrolled() = default;
+
+    constexpr
+    list_unrolled(list_unrolled const& x)
+    {
+        insert_range(x, back{at(this)});
+    }
+
+    constexpr
+    list_unrolled(list_unrolled&& x)
+    {
+        head = x.head;
+        tail = x.tail;
+        x.head = nullptr;
+        x.tail = nullptr;
+    }
+
+    constexpr
+    list_unrolled(pointer_diff size, T const& x)
+    {
+        while (!is_zero(size)) {
+            push_last(at(this), x);
+            decrement(size);
+        }
+    }
+
+    constexpr auto
+    operator=(list_unrolled const& x) -> list_unrolled&
+    {
+        using elements::swap;
+        list_unrolled temp(x);
+        swap(at(this), temp);
+        return at(this);
+    }
+
+    constexpr auto
+    operator=(list_unrolled&& x) -> list_unrolled&
+    {
+        using elements::swap;
+        if (this != pointer_to(x)) {
+            erase_all(at(this));
+            swap(head, x.head);
+            swap(tail, x.tail);
+        }
+        return at(this);
+    }
+
+    constexpr
+    ~list_unrolled()
+    {
+        erase_all(at(this));
+    }
+
+    constexpr auto
+    operator[](pointer_diff i) -> T&
+    {
+        auto node = head;
+        while (!(i < load(node).size)) {
+            i = i - load(node).size;
+            node = load(node).next;
+        }
+        return at(first(load(node)) + i);
+    }
+
+    constexpr auto
+    operator[](pointer_diff i) const -> T const&
+    {
+        auto node = head;
+        while (!(i < load(node).size)) {
+            i = i - load(node).size;
+            node = load(node).next;
+        }
+        return load(first(load(node)) + i);
+    }
+};
+
+template <typename T, pointer_diff k>
+struct value_type_t<list_unrolled<T, k>>
+{
+    using type = T;
+};
+
+template <typename T, pointer_diff k>
+struct cursor_type_t<list_unrolled<T, k>>
+{
+    using type = list_unrolled_cursor<T, k>;
+};
+
+template <typename T, pointer_diff k>
+struct cursor_type_t<list_unrolled<T const, k>>
+{
+    using type = list_unrolled_cursor<T const, k>;
+};
+
+template <typename T, pointer_diff k>
+struct size_type_t<list_unrolled<T, k>>
+{
+    using type = pointer_diff;
+};
+
+template <typename T, pointer_diff k>
+struct functor_t<list_unrolled<T, k>>
+{
+    using constructor_type = list_unrolled<T, k>;
+
+    template <Operation<T> Op>
+    static constexpr auto
+    fmap(list_unrolled<T, k>& x, Op op) -> list_unrolled<T, k>&
+    {
+        using elements::copy;
+        copy(first(x), limit(x), map_sink{op}(first(x)));
+        return x;
+    }
+
+    template <Regular_invocable<T> F>
+    static constexpr auto
+    fmap(list_unrolled<T, k>&& x, F fun) -> list_unrolled<Return_type<F, T>, k>
+    {
+        using elements::map;
+        list_unrolled<Return_type<F, T>, k> y;
+        map(first(x), limit(x), insert_sink{}(back{y}), fun);
+        return y;
+    }
+};
+
+template <Regular T, pointer_diff k>
+constexpr auto
+operator==(list_unrolled<T, k> const& x, list_unrolled<T, k> const& y) -> bool
+{
+    return equal_range(x, y);
+}
+
+template <Default_totally_ordered T, pointer_diff k>
+constexpr auto
+operator<(list_unrolled<T, k> const& x, list_unrolled<T, k> const& y) -> bool
+{
+    return less_range(x, y);
+}
+
+template <typename T, pointer_diff k>
+constexpr void
+swap(list_unrolled<T, k>& x, list_unrolled<T, k>& y)
+{
+    swap(x.head, y.head);
+    swap(x.tail, y.tail);
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+link_list_unrolled_node(
+    list_unrolled<T, k>& seq,
+    Pointer_type<list_node_unrolled<T, k>> next,
+    Pointer_type<list_node_unrolled<T, k>> prev) -> Pointer_type<list_node_unrolled<T, k>>
+{
+    auto node = new list_node_unrolled<T, k>{next, prev};
+    if (next == nullptr) {
+        seq.tail = node;
+    } else {
+        at(next).prev = node;
+    }
+    if (prev == nullptr) {
+        seq.head = node;
+    } else {
+        at(prev).next = node;
+    }
+    return node;
+}
+
+template <typename T, pointer_diff k>
+constexpr void
+unlink_list_unrolled_node(list_unrolled<T, k>& seq, Pointer_type<list_node_unrolled<T, k>> node)
+{
+    auto next = load(node).next;
+    auto prev = load(node).prev;
+    if (next == nullptr) {
+        seq.tail = prev;
+    } else {
+        at(next).prev = prev;
+    }
+    if (prev == nullptr) {
+        seq.head = next;
+    } else {
+        at(prev).next = next;
+    }
+    delete node;
+}
+
+template <typename T, pointer_diff k, typename U>
+constexpr auto
+insert_list_unrolled(list_unrolled<T, k>& seq, list_unrolled_cursor<T, k> cur, U&& x) -> list_unrolled_cursor<T, k>
+//[[expects: cur is a cursor of seq or the limit of a node of seq]]
+{
+    if (is_empty(seq)) {
+        auto node = link_list_unrolled_node<T, k>(seq, nullptr, nullptr);
+        cur = {node, first(load(node))};
+    } else if (is_full(load(cur.index))) {
+        auto& node = at(cur.index);
+        auto i = cur.segment - first(node);
+        if (i == k) {
+            auto next = link_list_unrolled_node(seq, node.next, cur.index.node);
+            cur = {next, first(load(next))};
+        } else if (is_zero(i)) {
+            auto prev = link_list_unrolled_node(seq, cur.index.node, node.prev);
+            cur = {prev, first(load(prev))};
+        } else {
+            auto next = link_list_unrolled_node(seq, node.next, cur.index.node);
+            relocate(first(node) + half(k), limit(node), first(at(next)));
+            at(next).size = k - half(k);
+            node.size = half(k);
+            if (half(k) < i) {
+                cur = {next, first(load(next)) + (i - half(k))};
+            }
+        }
+    }
+    auto& node = at(cur.index);
+    relocate_backward(cur.segment, limit(node), successor(limit(node)));
+    construct_at(cur.segment, fw<U>(x));
+    increment(node.size);
+    return cur;
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+erase_list_unrolled(list_unrolled<T, k>& seq, list_unrolled_cursor<T, k> cur) -> list_unrolled_cursor<T, k>
+//[[expects: cur is a cursor of seq]]
+{
+    auto& node = at(cur.index);
+    auto i = cur.segment - first(node);
+    destroy_at(cur.segment);
+    relocate(successor(cur.segment), limit(node), cur.segment);
+    decrement(node.size);
+    if (is_empty(node)) {
+        auto next = node.next;
+        auto prev = node.prev;
+        unlink_list_unrolled_node(seq, cur.index.node);
+        if (next != nullptr) return {next, first(load(next))};
+        if (prev != nullptr) return {prev, limit(load(prev))};
+        return {};
+    }
+    auto next = node.next;
+    if (next != nullptr and node.size < half(k) and node.size + load(next).size <= k) {
+        relocate(first(load(next)), limit(load(next)), limit(node));
+        node.size = node.size + load(next).size;
+        at(next).size = 0;
+        unlink_list_unrolled_node(seq, next);
+    }
+    if (i < node.size or node.next == nullptr) return {cur.index, first(node) + i};
+    return {node.next, first(load(node.next))};
+}
+
+template <typename T, pointer_diff k, typename U>
+constexpr auto
+insert(front<list_unrolled<T, k>> list, U&& x) -> front<list_unrolled<T, k>>
+{
+    auto& seq = base(list);
+    insert_list_unrolled(seq, first(seq), fw<U>(x));
+    return list;
+}
+
+template <typename T, pointer_diff k, typename U>
+constexpr auto
+insert(back<list_unrolled<T, k>> list, U&& x) -> back<list_unrolled<T, k>>
+{
+    auto& seq = base(list);
+    insert_list_unrolled(seq, limit(seq), fw<U>(x));
+    return list;
+}
+
+template <typename T, pointer_diff k, Constructible_from<T> U>
+constexpr auto
+insert(before<list_unrolled<T, k>> list, U&& x) -> before<list_unrolled<T, k>>
+{
+    auto& seq = base(list);
+    return before{seq, insert_list_unrolled(seq, current(list), fw<U>(x))};
+}
+
+template <typename T, pointer_diff k, Constructible_from<T> U>
+constexpr auto
+insert(after<list_unrolled<T, k>> list, U&& x) -> after<list_unrolled<T, k>>
+{
+    auto& seq = base(list);
+    auto cur = current(list);
+    if (precedes(cur, limit(seq))) increment(cur.segment);
+    return after{seq, insert_list_unrolled(seq, cur, fw<U>(x))};
+}
+
+template <typename T, pointer_diff k, Constructible_from<T> U>
+constexpr void
+emplace_first(list_unrolled<T, k>& list, U&& x)
+{
+    insert(front{list}, fw<U>(x));
+}
+
+template <typename T, pointer_diff k, Constructible_from<T> U>
+constexpr void
+push_first(list_unrolled<T, k>& list, U x)
+{
+    insert(front{list}, mv(x));
+}
+
+template <typename T, pointer_diff k, Constructible_from<T> U>
+constexpr void
+emplace_last(list_unrolled<T, k>& list, U&& x)
+{
+    insert(back{list}, fw<U>(x));
+}
+
+template <typename T, pointer_diff k, Constructible_from<T> U>
+constexpr void
+push_last(list_unrolled<T, k>& list, U x)
+{
+    insert(back{list}, mv(x));
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+erase(front<list_unrolled<T, k>> list) -> front<list_unrolled<T, k>>
+{
+    auto& seq = base(list);
+    erase_list_unrolled(seq, first(seq));
+    return list;
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+erase(back<list_unrolled<T, k>> list) -> back<list_unrolled<T, k>>
+{
+    auto& seq = base(list);
+    erase_list_unrolled(seq, last(seq));
+    return list;
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+erase(before<list_unrolled<T, k>> list) -> before<list_unrolled<T, k>>
+{
+    auto& seq = base(list);
+    return before{seq, erase_list_unrolled(seq, predecessor(current(list)))};
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+erase(after<list_unrolled<T, k>> list) -> after<list_unrolled<T, k>>
+{
+    auto& seq = base(list);
+    erase_list_unrolled(seq, successor(current(list)));
+    return list;
+}
+
+template <typename T, pointer_diff k>
+constexpr void
+erase_all(list_unrolled<T, k>& x)
+{
+    while (x.head != nullptr) {
+        auto& node = at(x.head);
+        destroy(first(node), limit(node));
+        node.size = 0;
+        unlink_list_unrolled_node(x, x.head);
+    }
+}
+
+template <typename T, pointer_diff k>
+constexpr void
+pop_first(list_unrolled<T, k>& list)
+{
+    erase(front{list});
+}
+
+template <typename T, pointer_diff k>
+constexpr void
+pop_last(list_unrolled<T, k>& list)
+{
+    erase(back{list});
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+first(list_unrolled<T, k> const& x) -> Cursor_type<list_unrolled<T, k>>
+{
+    if (x.head == nullptr) return {};
+    return {x.head, first(load(x.head))};
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+last(list_unrolled<T, k> const& x) -> Cursor_type<list_unrolled<T, k>>
+{
+    return {x.tail, predecessor(limit(load(x.tail)))};
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+limit(list_unrolled<T, k> const& x) -> Cursor_type<list_unrolled<T, k>>
+{
+    if (x.tail == nullptr) return {};
+    return {x.tail, limit(load(x.tail))};
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+is_empty(list_unrolled<T, k> const& x) -> bool
+{
+    return x.head == nullptr;
+}
+
+template <typename T, pointer_diff k>
+constexpr auto
+size(list_unrolled<T, k> const& x) -> Size_type<list_unrolled<T, k>>
+{
+    auto n = Zero<pointer_diff>;
+    auto node = x.head;
+    while (node != nullptr) {
+        n = n + load(node).size;
+        node = load(node).next;
+    }
+    return n;
+}
+
+}
@@ -35,11 +35,12 @@ map(S src, S lim, D dst, F fun) -> D
         return map(segment_cursor(src), segment_cursor(lim), dst, fun);
     } else {
         dst = map(segment_cursor(src), limit(load(index_src)), dst, fun);
-        do {
-            increment(index_src);
+        increment(index_src);
+        while (precedes(index_src, index_lim)) {
             dst = map(first(load(index_src)), limit(load(index_src)), dst, fun);
-        } while (precedes(index_src, index_lim));
-        return dst;
+            increment(index_src);
+        }
+        return map(first(load(index_src)), segment_cursor(lim), dst, fun);
     }
 }
 
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "ordered_algebra.h"
+
+namespace elements {
+
+constexpr auto
+power_modular(N<64> x, N<64> n, N<64> m) -> N<64>
+//[[expects: 0 < m and m <= 2^32]]
+{
+    N<64> r = 1 % m;
+    x = x % m;
+    while (n != 0) {
+        if ((n & 1) != 0) r = r * x % m;
+        x = x * x % m;
+        n = n >> 1;
+    }
+    return r;
+}
+
+constexpr auto
+is_prime(N<64> m) -> bool
+{
+    if (m < 2) return false;
+    for (N<64> d = 2; d * d <= m; ++d) {
+        if (m % d == 0) return false;
+    }
+    return true;
+}
+
+constexpr auto
+primitive_root(N<64> p) -> N<64>
+//[[expects: is_prime(p)]]
+// Returns the least generator of the multiplicative group modulo p
+{
+    N<64> factors[32]{};
+    auto n_factors = 0;
+    auto r = p - 1;
+    for (N<64> d = 2; d * d <= r; ++d) {
+        if (r % d == 0) {
+            factors[n_factors++] = d;
+            while (r % d == 0) r = r / d;
+        }
+    }
+    if (r > 1) factors[n_factors++] = r;
+    for (N<64> g = 2; g < p; ++g) {
+        auto i = 0;
+        while (i < n_factors and power_modular(g, (p - 1) / factors[i], p) != 1) ++i;
+        if (i == n_factors) return g;
+    }
+    return 1;
+}
+
+template <N<32> m>
+requires (1 < m)
+struct modular_integer
+{
+    static constexpr N<32> modulus = m;
+
+    N<32> v{};
+
+    constexpr
+    modular_integer() = default;
+
+    template <Integral I>
+    constexpr
+    modular_integer(I x)
+        : v{static_cast<N<32>>(x < I{0}
+            ? (m - static_cast<N<64>>(-(x + I{1})) % m - 1)
+            : static_cast<N<64>>(x) % m)}
+    {}
+};
+
+template <typename R>
+concept Modular_integer =
+    Regular<R> and
+    requires (R const& x) {
+        { R::modulus } -> Convertible_to<N<32>>;
+        { x.v } -> Convertible_to<N<32>>;
+    };
+
+template <typename R>
+concept Modular_prime_field =
+    Modular_integer<R> and
+    is_prime(R::modulus);
+
+template <N<32> m>
+struct zero_type_t<modular_integer<m>>
+{
+    static constexpr modular_integer<m> value{};
+};
+
+template <N<32> m>
+struct one_type_t<modular_integer<m>>
+{
+    static constexpr modular_integer<m> value{1};
+};
+
+template <N<32> m>
+constexpr auto
+operator==(modular_integer<m> const& x, modular_integer<m> const& y) -> bool
+{
+    return x.v == y.v;
+}
+
+template <N<32> m>
+constexpr auto
+operator<(modular_integer<m> const& x, modular_integer<m> const& y) -> bool
+// Orders by the least nonnegative representative
+{
+    return x.v < y.v;
+}
+
+template <N<32> m>
+constexpr auto
+operator+(modular_integer<m> const& x, modular_integer<m> const& y) -> modular_integer<m>
+{
+    // The reductions select with a mask rather than a branch, which would be
+    // mispredicted half of the time on uniformly distributed residues.
+    modular_integer<m> z;
+    auto s = static_cast<N<64>>(x.v) + y.v;
+    z.v = static_cast<N<32>>(s - (N<64>{m} & -static_cast<N<64>>(m <= s)));
+    return z;
+}
+
+template <N<32> m>
+constexpr auto
+operator-(modular_integer<m> const& x) -> modular_integer<m>
+{
+    modular_integer<m> z;
+    z.v = x.v == 0 ? 0 : m - x.v;
+    return z;
+}
+
+template <N<32> m>
+constexpr auto
+operator-(modular_integer<m> const& x, modular_integer<m> const& y) -> modular_integer<m>
+{
+    modular_integer<m> z;
+    auto d = static_cast<N<64>>(x.v) - y.v;
+    z.v = static_cast<N<32>>(d + (N<64>{m} & -static_cast<N<64>>(x.v < y.v)));
+    return z;
+}
+
+template <N<32> m>
+constexpr auto
+operator*(modular_integer<m> const& x, modular_integer<m> const& y) -> modular_integer<m>
+{
+    modular_integer<m> z;
+    z.v = static_cast<N<32>>(static_cast<N<64>>(x.v) * y.v % m);
+    return z;
+}
+
+template <N<32> m>
+constexpr auto
+power(modular_integer<m> const& x, N<64> n) -> modular_integer<m>
+{
+    modular_integer<m> z;
+    z.v = static_cast<N<32>>(power_modular(x.v, n, m));
+    return z;
+}
+
+template <N<32> m>
+requires (is_prime(m))
+struct reciprocal_op<modular_integer<m>>
+{
+    constexpr auto
+    operator()(modular_integer<m> const& x) const -> modular_integer<m>
+    // [[expects: x.v != 0]]
+    {
+        return power(x, m - 2);
+    }
+};
+
+template <N<32> m>
+requires (is_prime(m))
+constexpr auto
+operator/(modular_integer<m> const& x, modular_integer<m> const& y) -> modular_integer<m>
+{
+    return x * reciprocal_op<modular_integer<m>>{}(y);
+}
+
+}
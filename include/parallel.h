@@ -0,0 +1,41 @@
+#pragma once
+
+#include "cursor.h"
+#include "integer.h"
+#include "ordering.h"
+
+namespace elements {
+
+inline auto
+parallel_workers(pointer_diff n, pointer_diff grain, pointer_diff workers = hardware_concurrency()) -> pointer_diff
+// Returns the number of workers, at most workers, such that each of them
+// processes at least grain of the n elements
+//[[expects: 0 < grain]]
+{
+    return max(One<pointer_diff>, min(workers, n / grain));
+}
+
+template <Invocable<pointer_diff> F>
+void
+for_each_worker_from(pointer_diff i, pointer_diff n, F& fun)
+{
+    if (i == n) {
+        fun(Zero<pointer_diff>);
+        return;
+    }
+    thread worker{[&fun, i](){ fun(i); }};
+    for_each_worker_from(successor(i), n, fun);
+    worker.join();
+}
+
+template <Invocable<pointer_diff> F>
+void
+for_each_worker(pointer_diff n, F fun)
+// Calls fun(i) for each i in [0, n), each on its own thread except for
+// i = 0 which runs on the calling thread, and joins the threads
+{
+    if (is_zero(n)) return;
+    for_each_worker_from(One<pointer_diff>, n, fun);
+}
+
+}
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "array_single_ended.h"
 #include "copy.h"
+#include "count.h"
 #include "cursor.h"
 #include "pair.h"
+#include "parallel.h"
 #include "range.h"
 #include "rotate.h"
 #include "search.h"
@@ -132,6 +135,31 @@ partition_copy(S src, L lim, D0 dst_false, D1 dst_true, P pred) -> pair<D0, D1>
     return split_copy(src, lim, dst_false, dst_true, pred_src);
 }
 
+inline constexpr pointer_diff copy_if_parallel_grain = 65536;
+
+template <Indexed_cursor S, Indexed_cursor D, Predicate<Value_type<S>> P>
+requires Indirectly_copyable<S, D>
+auto
+copy_if_parallel(S src, S lim, D dst, P pred, pointer_diff workers = hardware_concurrency()) -> D
+//[[expects axiom: not_overlapped(src, lim, dst, dst + (# of elements satisfying pred))]]
+// Each worker counts the elements of a contiguous share that satisfy pred,
+// the counts are scanned into the offsets of the shares in dst, and each
+// worker then copies its share from its offset with copy_if
+{
+    auto n = lim - src;
+    auto w = parallel_workers(n, copy_if_parallel_grain, workers);
+    if (is_one(w)) return copy_if(src, lim, dst, pred);
+    array_single_ended<Difference_type<D>> offsets(successor(w), Difference_type<D>{0});
+    for_each_worker(w, [&offsets, src, n, w, pred](pointer_diff i){
+        offsets[successor(i)] = count_if(src + n * i / w, src + n * successor(i) / w, pred, Difference_type<D>{0});
+    });
+    for (pointer_diff i = 0; i < w; ++i) offsets[successor(i)] = offsets[successor(i)] + offsets[i];
+    for_each_worker(w, [&offsets, src, dst, n, w, pred](pointer_diff i){
+        copy_if(src + n * i / w, src + n * successor(i) / w, dst + offsets[i], pred);
+    });
+    return dst + offsets[w];
+}
+
 template <Forward_cursor C, Limit<C> L, Forward_cursor B, Predicate<Value_type<C>> P>
 requires
     Mutable<C> and
@@ -207,10 +235,233 @@ partition_unstable(C cur, L lim, P pred) -> C
 {
     while (true) {
         cur = search_if(cur, lim, pred);
-        auto swap_cur = search_backward_if_not(cur, lim, pred);
-        if (cur == swap_cur) return cur;
-        reverse_swap_step(swap_cur, cur);
+        lim = search_backward_if_not(cur, lim, pred);
+        if (cur == lim) return cur;
+        reverse_swap_step(lim, cur);
+    }
+}
+
+inline constexpr pointer_diff partition_block_size = 64;
+
+template <Indexed_cursor C, Predicate<Value_type<C>> P>
+requires Mutable<C>
+constexpr auto
+partition_block(C cur, C lim, P pred) -> C
+//[[expects axiom: mutable_range(cur, lim)]]
+// Fills a buffer with the offsets of the elements that satisfy pred in a
+// block of partition_block_size elements at the front, and one with the
+// offsets of those that do not in a block at the back, storing each offset
+// and advancing the count by the predicate instead of branching on it, and
+// then swaps the elements of as many pairs of offsets as both have, after
+// Edelkamp and Weiss. A block whose offsets are used up is replaced by the
+// next one, and the at most two blocks left are partitioned one by one.
+{
+    constexpr auto b = partition_block_size;
+    N<8> offsets_front[b];
+    N<8> offsets_back[b];
+    Difference_type<C> i = 0;
+    auto j = lim - cur;
+    pointer_diff n_front = 0;
+    pointer_diff n_back = 0;
+    pointer_diff k_front = 0;
+    pointer_diff k_back = 0;
+    while (twice(b) <= j - i) {
+        if (is_zero(n_front)) {
+            k_front = 0;
+            auto block = cur + i;
+            for (pointer_diff k = 0; k < b; ++k) {
+                offsets_front[n_front] = static_cast<N<8>>(k);
+                n_front = n_front + static_cast<pointer_diff>(static_cast<bool>(invoke(pred, load(block + k))));
+            }
+        }
+        if (is_zero(n_back)) {
+            k_back = 0;
+            auto block = cur + (j - b);
+            for (pointer_diff k = 0; k < b; ++k) {
+                offsets_back[n_back] = static_cast<N<8>>(k);
+                n_back = n_back + static_cast<pointer_diff>(!invoke(pred, load(block + k)));
+            }
+        }
+        auto m = min(n_front, n_back);
+        for (pointer_diff k = 0; k < m; ++k) {
+            swap(at(cur + (i + offsets_front[k_front + k])), at(cur + (j - b + offsets_back[k_back + k])));
+        }
+        n_front = n_front - m;
+        n_back = n_back - m;
+        k_front = k_front + m;
+        k_back = k_back + m;
+        if (is_zero(n_front)) i = i + b;
+        if (is_zero(n_back)) j = j - b;
+    }
+    return partition_semistable(cur + i, cur + j, pred);
+}
+
+#if defined(__AVX512F__)
+
+template <typename T>
+inline constexpr pointer_diff partition_lanes = 64 / static_cast<pointer_diff>(sizeof(T)) * static_cast<pointer_diff>(Same_as<T, Z<32>> or Same_as<T, float> or Same_as<T, Z<64>> or Same_as<T, double>);
+
+template <typename T>
+auto
+partition_split(Pointer_type<T const> src, T pivot, Pointer_type<T> dst_front, Pointer_type<T> lim_back) -> pointer_diff
+// Stores the partition_lanes<T> elements at src that are less than pivot from
+// dst_front and the others up to lim_back with compressing stores, and
+// returns the number of the former
+{
+    if constexpr (Same_as<T, Z<32>> or Same_as<T, float>) {
+        auto v = _mm512_loadu_si512(src);
+        __mmask16 m;
+        if constexpr (Same_as<T, float>) m = _mm512_cmp_ps_mask(_mm512_castsi512_ps(v), _mm512_set1_ps(pivot), _CMP_LT_OQ);
+        else m = _mm512_cmplt_epi32_mask(v, _mm512_set1_epi32(pivot));
+        auto c = static_cast<pointer_diff>(popcount(static_cast<N<32>>(m)));
+        _mm512_mask_compressstoreu_epi32(dst_front, m, v);
+        _mm512_mask_compressstoreu_epi32(lim_back - (16 - c), static_cast<__mmask16>(~m), v);
+        return c;
+    } else {
+        auto v = _mm512_loadu_si512(src);
+        __mmask8 m;
+        if constexpr (Same_as<T, double>) m = _mm512_cmp_pd_mask(_mm512_castsi512_pd(v), _mm512_set1_pd(pivot), _CMP_LT_OQ);
+        else m = _mm512_cmplt_epi64_mask(v, _mm512_set1_epi64(pivot));
+        auto c = static_cast<pointer_diff>(popcount(static_cast<N<32>>(m)));
+        _mm512_mask_compressstoreu_epi64(dst_front, m, v);
+        _mm512_mask_compressstoreu_epi64(lim_back - (8 - c), static_cast<__mmask8>(~m), v);
+        return c;
+    }
+}
+
+#elif defined(__AVX2__)
+
+template <typename T>
+inline constexpr pointer_diff partition_lanes = 8 * static_cast<pointer_diff>(Same_as<T, Z<32>> or Same_as<T, float>);
+
+template <typename T>
+auto
+partition_split(Pointer_type<T const> src, T pivot, Pointer_type<T> dst_front, Pointer_type<T> lim_back) -> pointer_diff
+// Moves the eight elements at src that are less than pivot to the front of a
+// register and the others to the back with a permutation from a table, and
+// stores it both from dst_front and up to lim_back, so that the elements less
+// than pivot start at dst_front and the others end at lim_back; the caller
+// guarantees that both stores land in free space
+{
+    auto v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src));
+    int m;
+    if constexpr (Same_as<T, float>) m = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_castsi256_ps(v), _mm256_set1_ps(pivot), _CMP_LT_OQ));
+    else m = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(pivot), v)));
+    auto perm = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(compress_permutations.lanes[m])));
+    auto p = _mm256_permutevar8x32_epi32(v, perm);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst_front), p);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lim_back - 8), p);
+    return static_cast<pointer_diff>(popcount(static_cast<N<32>>(m)));
+}
+
+#endif
+
+template <Totally_ordered T>
+auto
+partition_less(Pointer_type<T> cur, Pointer_type<T> lim, T const& pivot) -> Pointer_type<T>
+//[[expects axiom: mutable_range(cur, lim)]]
+// Moves the elements less than pivot before the others and returns the
+// limit of the former, like partition_block with the predicate !(x < pivot).
+// For 32 and 64-bit integers and floating point numbers with AVX-512, or
+// 32-bit ones with AVX2, the elements are partitioned a register at a time
+// in place, after Bramas: the first and last registers of elements are set
+// aside, which leaves free space at both ends, and each next register is read
+// from the end with less free space and split into both, and at the end the
+// elements set aside are split into the space that remains.
+{
+#if defined(__AVX512F__) or defined(__AVX2__)
+    constexpr auto v = partition_lanes<T>;
+    if constexpr (!is_zero(v)) {
+        if (twice(v) <= lim - cur) {
+            T aside[2 * v];
+            copy_bytes(cur, v * static_cast<pointer_diff>(sizeof(T)), aside);
+            copy_bytes(lim - v, v * static_cast<pointer_diff>(sizeof(T)), aside + v);
+            auto read_front = cur + v;
+            auto read_back = lim - v;
+            auto write_front = cur;
+            auto write_back = lim;
+            while (v <= read_back - read_front) {
+                Pointer_type<T> src;
+                if (read_front - write_front <= write_back - read_back) {
+                    src = read_front;
+                    read_front = read_front + v;
+                } else {
+                    read_back = read_back - v;
+                    src = read_back;
+                }
+                auto c = partition_split<T>(src, pivot, write_front, write_back);
+                write_front = write_front + c;
+                write_back = write_back - (v - c);
+            }
+            T rest[v];
+            auto n = read_back - read_front;
+            copy_bytes(read_front, n * static_cast<pointer_diff>(sizeof(T)), rest);
+            for (pointer_diff i = 0; i < n; ++i) {
+                if (rest[i] < pivot) {
+                    at(write_front) = rest[i];
+                    increment(write_front);
+                } else {
+                    decrement(write_back);
+                    at(write_back) = rest[i];
+                }
+            }
+            auto c = partition_split<T>(aside, pivot, write_front, write_back);
+            write_front = write_front + c;
+            write_back = write_back - (v - c);
+            c = partition_split<T>(aside + v, pivot, write_front, write_back);
+            return write_front + c;
+        }
+    }
+#endif
+    return partition_block(cur, lim, [&pivot](T const& x){ return !(x < pivot); });
+}
+
+inline constexpr pointer_diff partition_parallel_grain = 65536;
+
+template <Indexed_cursor C, Predicate<Value_type<C>> P>
+requires Mutable<C>
+auto
+partition_stable_parallel(C cur, C lim, P pred, pointer_diff workers = hardware_concurrency()) -> C
+//[[expects axiom: mutable_range(cur, lim)]]
+// Each worker partitions a contiguous share of the range stably through a
+// buffer, with a linear number of moves and no branches on the predicate,
+// and the partitioned shares are joined pairwise with combine_ranges, the
+// pairs of each round on separate workers, until one remains
+{
+    auto n = lim - cur;
+    auto w = parallel_workers(n, partition_parallel_grain, workers);
+    array_single_ended<bounded_range<C>> parts(w, bounded_range<C>{cur, cur});
+    for_each_worker(w, [&parts, cur, n, w, pred](pointer_diff i){
+        auto part_cur = cur + n * i / w;
+        auto part_lim = cur + n * successor(i) / w;
+        array_single_ended<Value_type<C>> buffer(part_lim - part_cur, Value_type<C>{});
+        // Each element is stored both in place and in the buffer, and only
+        // the cursor that it belongs to advances
+        auto dst_false = part_cur;
+        auto dst_true = first(buffer);
+        auto src = part_cur;
+        while (src != part_lim) {
+            bool const p = invoke(pred, load(src));
+            store(dst_true, load(src));
+            store(dst_false, load(src));
+            dst_false = dst_false + static_cast<Difference_type<C>>(!p);
+            dst_true = dst_true + static_cast<pointer_diff>(p);
+            increment(src);
+        }
+        copy(first(buffer), dst_true, dst_false);
+        parts[i] = bounded_range<C>{dst_false, part_lim};
+    });
+    while (1 < size(parts)) {
+        auto m = size(parts);
+        auto pairs = half(m);
+        array_single_ended<bounded_range<C>> joined(m - pairs, bounded_range<C>{cur, cur});
+        for_each_worker(pairs, [&parts, &joined](pointer_diff i){
+            joined[i] = combine_ranges(parts[twice(i)], parts[successor(twice(i))]);
+        });
+        if (is_odd(m)) joined[pairs] = parts[predecessor(m)];
+        parts = mv(joined);
     }
+    return first(parts[0]);
 }
 
 }
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "intrinsics.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace elements {
+
+enum perf_event
+{
+    perf_cycles, perf_instructions, perf_l1d_misses, perf_llc_misses, perf_branch_misses
+};
+
+inline constexpr size_t n_perf_events = 5;
+
+inline constexpr char const*
+perf_event_names[n_perf_events] =
+{
+    "cycles",
+    "instructions",
+    "l1d_misses",
+    "llc_misses",
+    "branch_misses"
+};
+
+struct perf_counts
+{
+    double x[n_perf_events]{};
+    bool valid[n_perf_events]{};
+
+    constexpr auto
+    operator[](size_t i) -> double&
+    {
+        return x[i];
+    }
+
+    constexpr auto
+    operator[](size_t i) const -> double const&
+    {
+        return x[i];
+    }
+};
+
+constexpr auto
+is_valid(perf_counts const& x, size_t i) -> bool
+{
+    return x.valid[i];
+}
+
+constexpr auto
+instructions_per_cycle(perf_counts const& x) -> double
+{
+    if (!x.valid[perf_cycles] or !x.valid[perf_instructions] or x[perf_cycles] == 0.0) return 0.0;
+    return x[perf_instructions] / x[perf_cycles];
+}
+
+struct perf_reading
+{
+    double value{};
+    double time_enabled{};
+    double time_running{};
+};
+
+constexpr auto
+perf_difference(perf_reading const& x, perf_reading const& y) -> double
+// Scales the count by the fraction of time the event was scheduled when the
+// kernel multiplexes more events than there are hardware counters.
+{
+    auto running = y.time_running - x.time_running;
+    if (running == 0.0) return 0.0;
+    return (y.value - x.value) * (y.time_enabled - x.time_enabled) / running;
+}
+
+#if defined(__linux__)
+
+inline auto
+open_perf_event(size_t i) -> int
+{
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    auto cache = [](unsigned long long cache_id, unsigned long long result){
+        return cache_id | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (result << 16);
+    };
+    switch (i) {
+        case perf_cycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case perf_instructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case perf_l1d_misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS);
+            break;
+        case perf_llc_misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cache(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_RESULT_MISS);
+            break;
+        default:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+    }
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+inline void
+close_perf_event(int fd)
+{
+    close(fd);
+}
+
+inline auto
+read_perf_event(int fd) -> perf_reading
+{
+    unsigned long long values[3]{};
+    if (read(fd, values, sizeof(values)) != static_cast<ssize_t>(sizeof(values))) return {};
+    return {static_cast<double>(values[0]), static_cast<double>(values[1]), static_cast<double>(values[2])};
+}
+
+#else
+
+inline auto
+open_perf_event(size_t) -> int
+{
+    return -1;
+}
+
+inline void
+close_perf_event(int)
+{}
+
+inline auto
+read_perf_event(int) -> perf_reading
+{
+    return {};
+}
+
+#endif
+
+struct perf_counters
+{
+    // A descriptor is -1 when the event is not available, because the
+    // platform, the kernel or its perf_event_paranoid setting does not allow it.
+    int fd[n_perf_events];
+    perf_counts counts;
+
+    perf_counters()
+    {
+        for (size_t i = 0; i < n_perf_events; ++i) {
+            fd[i] = open_perf_event(i);
+            counts.valid[i] = 0 <= fd[i];
+        }
+    }
+
+    perf_counters(perf_counters const&) = delete;
+
+    perf_counters(perf_counters&&) = delete;
+
+    auto operator=(perf_counters const&) -> perf_counters& = delete;
+
+    auto operator=(perf_counters&&) -> perf_counters& = delete;
+
+    ~perf_counters()
+    {
+        for (auto x : fd) {
+            if (0 <= x) close_perf_event(x);
+        }
+    }
+};
+
+inline auto
+is_available(perf_counters const& x) -> bool
+{
+    for (auto y : x.fd) {
+        if (0 <= y) return true;
+    }
+    return false;
+}
+
+inline void
+clear(perf_counters& x)
+{
+    for (auto& y : x.counts.x) y = 0.0;
+}
+
+struct perf_scope
+{
+    // Adds the events of the enclosed region, including threads created and
+    // joined in it, to the counts of the counters; does nothing for events
+    // that are not available.
+    perf_counters& counters;
+    perf_reading start[n_perf_events];
+
+    explicit
+    perf_scope(perf_counters& x)
+        : counters{x}
+    {
+        for (size_t i = 0; i < n_perf_events; ++i) {
+            if (0 <= counters.fd[i]) start[i] = read_perf_event(counters.fd[i]);
+        }
+    }
+
+    perf_scope(perf_scope const&) = delete;
+
+    auto operator=(perf_scope const&) -> perf_scope& = delete;
+
+    ~perf_scope()
+    {
+        perf_reading lim[n_perf_events];
+        for (size_t i = 0; i < n_perf_events; ++i) {
+            if (0 <= counters.fd[i]) lim[i] = read_perf_event(counters.fd[i]);
+        }
+        for (size_t i = 0; i < n_perf_events; ++i) {
+            if (0 <= counters.fd[i]) counters.counts[i] += perf_difference(start[i], lim[i]);
+        }
+    }
+};
+
+}
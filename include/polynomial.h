@@ -2,6 +2,7 @@
 
 #include "array_single_ended.h"
 #include "combinatorics.h"
+#include "fourier.h"
 #include "ordered_algebra.h"
 
 namespace elements {
@@ -12,7 +13,7 @@ struct polynomial
     C coefficients;
 
     polynomial()
-        : coefficients{Zero<R>}
+        : coefficients{}
     {}
 
     explicit
@@ -114,9 +115,172 @@ operator+(polynomial<R, C> const& x, polynomial<R, C> const& y) -> polynomial<R,
     }
 }
 
+inline constexpr pointer_diff polynomial_karatsuba_threshold = 32;
+
+inline constexpr pointer_diff polynomial_transform_threshold = 64;
+
+template <Indexed_cursor C0, Indexed_cursor C1, Indexed_cursor D>
+requires
+    Loadable<C0> and Loadable<C1> and Mutable<D> and
+    Ring<Value_type<D>> and
+    Same_as<Remove_const<Value_type<C0>>, Value_type<D>> and
+    Same_as<Remove_const<Value_type<C1>>, Value_type<D>>
+constexpr void
+multiply_schoolbook(C0 x, pointer_diff n, C1 y, pointer_diff m, D z)
+// Adds the product of the coefficients x[0, n) and y[0, m) to z[0, n + m - 1)
+{
+    auto lim0 = x + n;
+    while (x != lim0) {
+        auto src1 = y;
+        auto lim1 = y + m;
+        auto dst = z;
+        while (src1 != lim1) {
+            store(dst, load(dst) + load(x) * load(src1));
+            increment(src1);
+            increment(dst);
+        }
+        increment(x);
+        increment(z);
+    }
+}
+
+template <Indexed_cursor C0, Indexed_cursor C1, Indexed_cursor D>
+requires
+    Loadable<C0> and Loadable<C1> and Mutable<D> and
+    Ring<Value_type<D>> and
+    Same_as<Remove_const<Value_type<C0>>, Value_type<D>> and
+    Same_as<Remove_const<Value_type<C1>>, Value_type<D>>
+void
+multiply_karatsuba(C0 x, pointer_diff n, C1 y, pointer_diff m, D z, pointer_diff threshold = polynomial_karatsuba_threshold)
+// Adds the product of the coefficients x[0, n) and y[0, m) to z[0, n + m - 1),
+// splitting at half the longer length until the shorter one is below threshold
+//[[expects: 1 < threshold]]
+{
+    using R = Value_type<D>;
+    if (min(n, m) < threshold) {
+        multiply_schoolbook(x, n, y, m, z);
+        return;
+    }
+    auto h = half(successor(max(n, m)));
+    if (n <= h) {
+        multiply_karatsuba(x, n, y, h, z, threshold);
+        multiply_karatsuba(x, n, y + h, m - h, z + h, threshold);
+        return;
+    }
+    if (m <= h) {
+        multiply_karatsuba(x, h, y, m, z, threshold);
+        multiply_karatsuba(x + h, n - h, y, m, z + h, threshold);
+        return;
+    }
+    // With x = x0 + x1 t^h and y = y0 + y1 t^h, the middle coefficients are
+    // (x0 + x1)(y0 + y1) - x0 y0 - x1 y1.
+    array_single_ended<R> sums(twice(h));
+    copy(x, x + h, insert_sink{}(back{sums}));
+    copy(y, y + h, insert_sink{}(back{sums}));
+    auto sx = first(sums);
+    auto sy = sx + h;
+    map(x + h, x + n, sx, sx, add);
+    map(y + h, y + m, sy, sy, add);
+    auto k = predecessor(twice(h));
+    auto k2 = n + m - twice(h) - One<pointer_diff>;
+    array_single_ended<R> products(twice(k) + k2, Zero<R>);
+    auto p0 = first(products);
+    auto p1 = p0 + k;
+    auto p2 = p1 + k;
+    multiply_karatsuba(x, h, y, h, p0, threshold);
+    multiply_karatsuba(sx, h, sy, h, p1, threshold);
+    multiply_karatsuba(x + h, n - h, y + h, m - h, p2, threshold);
+    map(p0, p0 + k, p1, p1, [](R const& a, R const& b){ return b - a; });
+    map(p2, p2 + k2, p1, p1, [](R const& a, R const& b){ return b - a; });
+    map(p0, p0 + k, z, z, add);
+    map(p2, p2 + k2, z + twice(h), z + twice(h), add);
+    map(p1, p1 + k, z + h, z + h, add);
+}
+
+template <Indexed_cursor C0, Indexed_cursor C1, Indexed_cursor D>
+requires
+    Loadable<C0> and Loadable<C1> and Mutable<D> and
+    Modular_prime_field<Value_type<D>> and
+    Same_as<Remove_const<Value_type<C0>>, Value_type<D>> and
+    Same_as<Remove_const<Value_type<C1>>, Value_type<D>>
+auto
+multiply_number_theoretic(C0 x, pointer_diff n, C1 y, pointer_diff m, D z) -> bool
+// Adds the product of the coefficients x[0, n) and y[0, m) to z[0, n + m - 1)
+// by pointwise multiplication of their number theoretic transforms, or
+// returns false if the modulus has no root of unity of a sufficient order
+{
+    using R = Value_type<D>;
+    auto l = ceil_power_of_two(n + m - One<pointer_diff>);
+    if (number_theoretic_transform_max_size<R::modulus> < l) return false;
+    array_single_ended<R> a(l, Zero<R>);
+    array_single_ended<R> b(l, Zero<R>);
+    copy(x, x + n, first(a));
+    copy(y, y + m, first(b));
+    number_theoretic_transform<R::modulus>(first(a), l, false);
+    number_theoretic_transform<R::modulus>(first(b), l, false);
+    map(first(b), limit(b), first(a), first(a), multiply);
+    number_theoretic_transform<R::modulus>(first(a), l, true);
+    map(first(a), first(a) + (n + m - One<pointer_diff>), z, z, add);
+    return true;
+}
+
+template <Indexed_cursor C0, Indexed_cursor C1, Indexed_cursor D>
+requires
+    Loadable<C0> and Loadable<C1> and Mutable<D> and
+    Floating_point<Value_type<D>> and
+    Same_as<Remove_const<Value_type<C0>>, Value_type<D>> and
+    Same_as<Remove_const<Value_type<C1>>, Value_type<D>>
+void
+multiply_fourier(C0 x, pointer_diff n, C1 y, pointer_diff m, D z)
+// Adds the product of the coefficients x[0, n) and y[0, m) to z[0, n + m - 1)
+// using a single complex transform of x + iy, whose square has the product
+// as its imaginary part divided by 2; the result is subject to rounding
+{
+    using R = Value_type<D>;
+    auto l = ceil_power_of_two(n + m - One<pointer_diff>);
+    array_single_ended<double> a(twice(l), 0.0);
+    auto cur = first(a);
+    for (pointer_diff i = 0; i < n; ++i) cur[twice(i)] = static_cast<double>(x[i]);
+    for (pointer_diff i = 0; i < m; ++i) cur[successor(twice(i))] = static_cast<double>(y[i]);
+    fourier_transform(cur, l, false);
+    for (pointer_diff i = 0; i < l; ++i) {
+        auto re = cur[twice(i)];
+        auto im = cur[successor(twice(i))];
+        cur[twice(i)] = re * re - im * im;
+        cur[successor(twice(i))] = 2.0 * re * im;
+    }
+    fourier_transform(cur, l, true);
+    for (pointer_diff i = 0; i < n + m - One<pointer_diff>; ++i) {
+        z[i] = z[i] + static_cast<R>(0.5 * cur[successor(twice(i))]);
+    }
+}
+
+template <Indexed_cursor C0, Indexed_cursor C1, Indexed_cursor D>
+requires
+    Loadable<C0> and Loadable<C1> and Mutable<D> and
+    Ring<Value_type<D>>
+void
+multiply_coefficients(C0 x, pointer_diff n, C1 y, pointer_diff m, D z)
+{
+    multiply_karatsuba(x, n, y, m, z);
+}
+
+template <Indexed_cursor C0, Indexed_cursor C1, Indexed_cursor D>
+requires
+    Loadable<C0> and Loadable<C1> and Mutable<D> and
+    Ring<Value_type<D>> and Modular_prime_field<Value_type<D>>
+void
+multiply_coefficients(C0 x, pointer_diff n, C1 y, pointer_diff m, D z)
+{
+    if (polynomial_transform_threshold <= min(n, m) and multiply_number_theoretic(x, n, y, m, z)) return;
+    multiply_karatsuba(x, n, y, m, z);
+}
+
 template <Ring R, Dynamic_sequence C>
 constexpr auto
 operator*(polynomial<R, C> const& x, polynomial<R, C> const& y) -> polynomial<R, C>
+// Uses Karatsuba, or number theoretic transforms over a Modular_prime_field,
+// and never the rounding multiply_fourier for floating point coefficients
 {
     if (x == Zero<polynomial<R, C>>) return Zero<polynomial<R, C>>;
     if (y == Zero<polynomial<R, C>>) return Zero<polynomial<R, C>>;
@@ -127,23 +291,28 @@ operator*(polynomial<R, C> const& x, polynomial<R, C> const& y) -> polynomial<R,
     auto dx = degree(x);
     auto dy = degree(y);
     polynomial<R, C> z(dx + successor(dy), Zero<R>);
+    multiply_coefficients(
+        first(x.coefficients), successor(dx),
+        first(y.coefficients), successor(dy),
+        first(z.coefficients));
+    return z;
+}
 
-    auto src0 = first(x.coefficients);
-    auto lim0 = src0 + successor(dx);
-    auto dst_begin = first(z.coefficients);
-    while (src0 != lim0) {
-        auto src1 = first(y.coefficients);
-        auto lim1 = src1 + successor(dy);
-        auto dst = dst_begin;
-        while (src1 != lim1) {
-            store(dst, load(dst) + load(src0) * load(src1));
-            increment(src1);
-            increment(dst);
-        }
-        increment(src0);
-        increment(dst_begin);
-    }
-
+template <Ring R, Dynamic_sequence C>
+requires Floating_point<R>
+auto
+multiply_fourier(polynomial<R, C> const& x, polynomial<R, C> const& y) -> polynomial<R, C>
+// Returns the product through a complex transform, with rounding errors in
+// the coefficients that grow with the degree
+{
+    if (x == Zero<polynomial<R, C>> or y == Zero<polynomial<R, C>>) return Zero<polynomial<R, C>>;
+    auto dx = degree(x);
+    auto dy = degree(y);
+    polynomial<R, C> z(dx + successor(dy), Zero<R>);
+    multiply_fourier(
+        first(x.coefficients), successor(dx),
+        first(y.coefficients), successor(dy),
+        first(z.coefficients));
     return z;
 }
 
@@ -196,6 +365,7 @@ constexpr auto
 evaluate(polynomial<R, C> const& p, R const& x) -> R
 {
     auto k = degree(p);
+    if (k < 0) return Zero<R>;
     auto r = p.coefficients[k];
     while (k > 0) {
         decrement(k);
@@ -204,6 +374,117 @@ evaluate(polynomial<R, C> const& p, R const& x) -> R
     return r;
 }
 
+inline constexpr pointer_diff polynomial_evaluation_lanes = 8;
+
+template <Ring R, Dynamic_sequence C, Cursor S, Limit<S> L, Cursor D>
+requires
+    Loadable<S> and Storable<D> and
+    Same_as<Remove_const<Value_type<S>>, R> and
+    Same_as<Value_type<D>, R>
+constexpr auto
+evaluate(polynomial<R, C> const& p, S cur, L lim, D dst) -> D
+{
+    while (precedes(cur, lim)) {
+        store(dst, evaluate(p, load(cur)));
+        increment(cur);
+        increment(dst);
+    }
+    return dst;
+}
+
+template <Ring R, Dynamic_sequence C, Cursor S, Limit<S> L, Cursor D>
+requires
+    Arithmetic<R> and
+    Loadable<S> and Storable<D> and
+    Same_as<Remove_const<Value_type<S>>, R> and
+    Same_as<Value_type<D>, R>
+constexpr auto
+evaluate(polynomial<R, C> const& p, S cur, L lim, D dst) -> D
+// Runs the Horner steps for polynomial_evaluation_lanes points in lockstep,
+// so the steps of different points are independent and vectorize
+{
+    auto k = degree(p);
+    while (precedes(cur, lim)) {
+        R x[polynomial_evaluation_lanes]{};
+        R r[polynomial_evaluation_lanes];
+        auto n = Zero<pointer_diff>;
+        while (n < polynomial_evaluation_lanes and precedes(cur, lim)) {
+            x[n] = load(cur);
+            increment(n);
+            increment(cur);
+        }
+        auto c = k < 0 ? Zero<R> : p.coefficients[k];
+        for (pointer_diff j = 0; j < polynomial_evaluation_lanes; ++j) r[j] = c;
+        auto i = k;
+        while (i > 0) {
+            decrement(i);
+            auto a = p.coefficients[i];
+            for (pointer_diff j = 0; j < polynomial_evaluation_lanes; ++j) r[j] = r[j] * x[j] + a;
+        }
+        for (pointer_diff j = 0; j < n; ++j) {
+            store(dst, r[j]);
+            increment(dst);
+        }
+    }
+    return dst;
+}
+
+template <Indexed_cursor C, Indexed_cursor B>
+requires
+    Loadable<C> and Mutable<B> and
+    Ring<Value_type<B>> and
+    Same_as<Remove_const<Value_type<C>>, Value_type<B>>
+constexpr auto
+evaluate_estrin_n(C a, pointer_diff n, Value_type<B> const& x, B b) -> Value_type<B>
+//[[expects: 0 < n and b has room for (n + 1) / 2 values]]
+// Combines pairs of coefficients with x, then pairs of the results with x^2,
+// x^4, ..., which shortens the chain of dependent operations to O(log(n))
+{
+    auto m = half(successor(n));
+    for (pointer_diff i = 0; i < half(n); ++i) {
+        b[i] = a[twice(i)] + a[successor(twice(i))] * x;
+    }
+    if (m != half(n)) b[half(n)] = a[predecessor(n)];
+    auto y = x * x;
+    while (One<pointer_diff> < m) {
+        for (pointer_diff i = 0; i < half(m); ++i) {
+            b[i] = b[twice(i)] + b[successor(twice(i))] * y;
+        }
+        if (m != twice(half(m))) b[half(m)] = b[predecessor(m)];
+        m = half(successor(m));
+        y = y * y;
+    }
+    return b[0];
+}
+
+template <Ring R, Dynamic_sequence C>
+constexpr auto
+evaluate_estrin(polynomial<R, C> const& p, R const& x) -> R
+{
+    auto n = successor(degree(p));
+    if (n <= 0) return Zero<R>;
+    array_single_ended<R> b(half(successor(n)), Zero<R>);
+    return evaluate_estrin_n(first(p.coefficients), n, x, first(b));
+}
+
+template <Ring R, Dynamic_sequence C, Cursor S, Limit<S> L, Cursor D>
+requires
+    Loadable<S> and Storable<D> and
+    Same_as<Remove_const<Value_type<S>>, R> and
+    Same_as<Value_type<D>, R>
+constexpr auto
+evaluate_estrin(polynomial<R, C> const& p, S cur, L lim, D dst) -> D
+{
+    auto n = successor(degree(p));
+    array_single_ended<R> b(half(successor(max(n, Zero<pointer_diff>))), Zero<R>);
+    while (precedes(cur, lim)) {
+        store(dst, n <= 0 ? Zero<R> : evaluate_estrin_n(first(p.coefficients), n, load(cur), first(b)));
+        increment(cur);
+        increment(dst);
+    }
+    return dst;
+}
+
 template <typename I, typename C>
 requires
     Integral<I> and
@@ -226,4 +507,363 @@ subderivative(polynomial<I, C> const& x, I const& k) -> polynomial<I, C>
     return y;
 }
 
+template <Ring R, Dynamic_sequence C>
+constexpr auto
+truncate(polynomial<R, C> const& x, pointer_diff n) -> polynomial<R, C>
+// Returns x mod t^n
+{
+    auto k = min(successor(degree(x)), max(n, Zero<pointer_diff>));
+    polynomial<R, C> y(k, Zero<R>);
+    copy(first(x.coefficients), first(x.coefficients) + k, first(y.coefficients));
+    return y;
+}
+
+template <Ring R, Dynamic_sequence C>
+constexpr auto
+divide_by_power(polynomial<R, C> const& x, pointer_diff n) -> polynomial<R, C>
+// Returns x div t^n
+{
+    auto k = successor(degree(x)) - n;
+    if (k <= 0) return Zero<polynomial<R, C>>;
+    polynomial<R, C> y(k, Zero<R>);
+    copy(first(x.coefficients) + n, first(x.coefficients) + n + k, first(y.coefficients));
+    return y;
+}
+
+template <Ring R, Dynamic_sequence C>
+constexpr auto
+reverse(polynomial<R, C> const& x, pointer_diff n) -> polynomial<R, C>
+// Returns t^(n - 1) x(1 / t), the first n coefficients of x in reverse order
+{
+    auto k = min(successor(degree(x)), n);
+    polynomial<R, C> y(n, Zero<R>);
+    auto dst = first(y.coefficients) + n;
+    auto cur = first(x.coefficients);
+    auto lim = cur + k;
+    while (cur != lim) {
+        decrement(dst);
+        store(dst, load(cur));
+        increment(cur);
+    }
+    return y;
+}
+
+template <Ring R, Dynamic_sequence C>
+requires Field<R>
+constexpr auto
+monic(polynomial<R, C> x) -> polynomial<R, C>
+{
+    auto k = degree(x);
+    if (k < 0 or x[k] == One<R>) return truncate(x, successor(k));
+    auto r = reciprocal_op<R>{}(x[k]);
+    polynomial<R, C> y(successor(k), Zero<R>);
+    map(first(x.coefficients), first(x.coefficients) + successor(k), first(y.coefficients), [&r](R const& a){ return a * r; });
+    return y;
+}
+
+template <Ring R, Dynamic_sequence C>
+requires Field<R>
+auto
+inverse_series(polynomial<R, C> const& x, pointer_diff n) -> polynomial<R, C>
+//[[expects: x[0] != 0]]
+// Returns y with x y = 1 mod t^n by Newton iteration,
+// y' = y (2 - x y) mod t^2k, which doubles the number of correct
+// coefficients with two multiplications
+{
+    if (n <= 0) return Zero<polynomial<R, C>>;
+    polynomial<R, C> y{reciprocal_op<R>{}(x[0])};
+    auto k = One<pointer_diff>;
+    while (k < n) {
+        k = min(twice(k), n);
+        auto e = truncate(truncate(x, k) * y, k);
+        e = -e;
+        e[0] = e[0] + One<R> + One<R>;
+        y = truncate(y * e, k);
+    }
+    return y;
+}
+
+inline constexpr pointer_diff polynomial_division_threshold = 512;
+
+template <Indexed_cursor C0, Indexed_cursor C1>
+requires
+    Mutable<C0> and Loadable<C1> and
+    Field<Value_type<C0>> and
+    Same_as<Remove_const<Value_type<C1>>, Value_type<C0>>
+constexpr void
+remainder_schoolbook(C0 x, pointer_diff n, C1 y, pointer_diff m)
+//[[expects: 0 < m and y[m - 1] != 0]]
+// Replaces the coefficients x[0, n) by their remainder x[0, m - 1) modulo
+// y[0, m), leaving zeros in x[m - 1, n)
+{
+    using R = Value_type<C0>;
+    auto r = reciprocal_op<R>{}(load(y + predecessor(m)));
+    auto i = n - m;
+    while (0 <= i) {
+        auto top = x + (i + predecessor(m));
+        auto c = load(top) * r;
+        if (c != Zero<R>) {
+            map(y, y + predecessor(m), x + i, x + i, [&c](auto const& a, auto const& b){ return b - c * a; });
+        }
+        store(top, Zero<R>);
+        decrement(i);
+    }
+}
+
+template <Indexed_cursor C0, Indexed_cursor C1, Indexed_cursor D>
+requires
+    Mutable<C0> and Loadable<C1> and Storable<D> and
+    Field<Value_type<C0>> and
+    Same_as<Remove_const<Value_type<C1>>, Value_type<C0>> and
+    Same_as<Value_type<D>, Value_type<C0>>
+constexpr void
+divide_schoolbook(C0 x, pointer_diff n, C1 y, pointer_diff m, D q)
+//[[expects: 0 < m <= n and y[m - 1] != 0]]
+// Stores the quotient of the coefficients x[0, n) by y[0, m) in q[0, n - m + 1)
+// and replaces x[0, n) by the remainder, as in remainder_schoolbook
+{
+    using R = Value_type<C0>;
+    auto r = reciprocal_op<R>{}(load(y + predecessor(m)));
+    auto i = n - m;
+    while (0 <= i) {
+        auto top = x + (i + predecessor(m));
+        auto c = load(top) * r;
+        store(q + i, c);
+        if (c != Zero<R>) {
+            map(y, y + predecessor(m), x + i, x + i, [&c](auto const& a, auto const& b){ return b - c * a; });
+        }
+        store(top, Zero<R>);
+        decrement(i);
+    }
+}
+
+template <Ring R, Dynamic_sequence C>
+requires Field<R>
+auto
+quotient_remainder(polynomial<R, C> const& x, polynomial<R, C> const& y) -> pair<polynomial<R, C>, polynomial<R, C>>
+//[[expects: y != 0]]
+// Divides in quadratic time, or when both the quotient and the divisor have
+// at least polynomial_division_threshold coefficients, as the reversal of the
+// product of the reversed dividend and the inverse series of the reversed
+// divisor
+{
+    auto dx = degree(x);
+    auto dy = degree(y);
+    if (dx < dy) return {Zero<polynomial<R, C>>, x};
+    auto k = successor(dx - dy);
+    if (k < polynomial_division_threshold or dy < polynomial_division_threshold) {
+        auto r = truncate(x, successor(dx));
+        polynomial<R, C> q(k, Zero<R>);
+        divide_schoolbook(first(r.coefficients), successor(dx), first(y.coefficients), successor(dy), first(q.coefficients));
+        return {q, truncate(r, dy)};
+    }
+    auto q = reverse(truncate(reverse(x, successor(dx)) * inverse_series(reverse(y, successor(dy)), k), k), k);
+    return {q, truncate(x - y * q, dy)};
+}
+
+template <Ring R, Dynamic_sequence C>
+requires Field<R>
+auto
+quotient(polynomial<R, C> const& x, polynomial<R, C> const& y) -> polynomial<R, C>
+//[[expects: y != 0]]
+{
+    return quotient_remainder(x, y).m0;
+}
+
+template <Ring R, Dynamic_sequence C>
+requires Field<R>
+auto
+remainder(polynomial<R, C> const& x, polynomial<R, C> const& y) -> polynomial<R, C>
+//[[expects: y != 0]]
+{
+    auto dx = degree(x);
+    auto dy = degree(y);
+    if (dx < dy) return x;
+    if (successor(dx - dy) < polynomial_division_threshold or dy < polynomial_division_threshold) {
+        auto r = truncate(x, successor(dx));
+        remainder_schoolbook(first(r.coefficients), successor(dx), first(y.coefficients), successor(dy));
+        return truncate(r, dy);
+    }
+    return quotient_remainder(x, y).m1;
+}
+
+template <Ring R, Dynamic_sequence C>
+requires Field<R>
+auto
+gcd_euclidean(polynomial<R, C> const& x, polynomial<R, C> const& y) -> polynomial<R, C>
+// Returns the monic greatest common divisor, or zero if both are zero, by
+// alternately reducing copies of x and y in place
+{
+    auto a = truncate(x, successor(degree(x)));
+    auto b = truncate(y, successor(degree(y)));
+    auto u = first(a.coefficients);
+    auto v = first(b.coefficients);
+    auto du = degree(a);
+    auto dv = degree(b);
+    if (du < dv) {
+        swap(u, v);
+        swap(du, dv);
+    }
+    while (0 <= dv) {
+        remainder_schoolbook(u, successor(du), v, successor(dv));
+        du = predecessor(dv);
+        while (0 <= du and load(u + du) == Zero<R>) decrement(du);
+        swap(u, v);
+        swap(du, dv);
+    }
+    polynomial<R, C> z(successor(du), Zero<R>);
+    copy(u, u + successor(du), first(z.coefficients));
+    return monic(z);
+}
+
+template <Ring R, Dynamic_sequence C>
+struct polynomial_matrix
+{
+    // The 2 x 2 matrix [[m00, m01], [m10, m11]], acting on pairs of polynomials
+    polynomial<R, C> m00;
+    polynomial<R, C> m01;
+    polynomial<R, C> m10;
+    polynomial<R, C> m11;
+};
+
+template <Ring R, Dynamic_sequence C>
+auto
+operator*(polynomial_matrix<R, C> const& x, polynomial_matrix<R, C> const& y) -> polynomial_matrix<R, C>
+{
+    return {
+        x.m00 * y.m00 + x.m01 * y.m10,
+        x.m00 * y.m01 + x.m01 * y.m11,
+        x.m10 * y.m00 + x.m11 * y.m10,
+        x.m10 * y.m01 + x.m11 * y.m11};
+}
+
+template <Ring R, Dynamic_sequence C>
+auto
+apply(polynomial_matrix<R, C> const& m, polynomial<R, C> const& x, polynomial<R, C> const& y) -> pair<polynomial<R, C>, polynomial<R, C>>
+{
+    return {m.m00 * x + m.m01 * y, m.m10 * x + m.m11 * y};
+}
+
+template <Ring R, Dynamic_sequence C>
+auto
+euclidean_step(polynomial_matrix<R, C> const& m, polynomial<R, C> const& q) -> polynomial_matrix<R, C>
+// Returns [[0, 1], [1, -q]] m, the matrix of one more division step
+{
+    return {m.m10, m.m11, m.m00 - q * m.m10, m.m01 - q * m.m11};
+}
+
+template <Ring R, Dynamic_sequence C>
+requires Field<R>
+auto
+half_gcd_schoolbook(polynomial<R, C> const& x, polynomial<R, C> const& y) -> polynomial_matrix<R, C>
+//[[expects: degree(y) <= degree(x)]]
+// Returns the same matrix as half_gcd by running the division steps one at a
+// time on copies of x and y and the rows of the matrix, all reduced in place
+{
+    auto dx = degree(x);
+    auto h = half(successor(dx));
+    auto n = successor(dx);
+    polynomial<R, C> a = truncate(x, n);
+    polynomial<R, C> b(n, Zero<R>);
+    copy(first(y.coefficients), first(y.coefficients) + successor(degree(y)), first(b.coefficients));
+    polynomial<R, C> q(n, Zero<R>);
+    polynomial<R, C> rows[4]{{n, Zero<R>}, {n, Zero<R>}, {n, Zero<R>}, {n, Zero<R>}};
+    rows[0][0] = One<R>;
+    rows[3][0] = One<R>;
+    auto u = first(a.coefficients);
+    auto v = first(b.coefficients);
+    auto du = dx;
+    auto dv = degree(y);
+    // The rows of the matrix are [r00, r01] and [r10, r11]; an entry has at
+    // most l coefficients.
+    auto r00 = first(rows[0].coefficients);
+    auto r01 = first(rows[1].coefficients);
+    auto r10 = first(rows[2].coefficients);
+    auto r11 = first(rows[3].coefficients);
+    auto l = One<pointer_diff>;
+    while (h <= dv) {
+        auto k = successor(du - dv);
+        auto p = first(q.coefficients);
+        divide_schoolbook(u, successor(du), v, successor(dv), p);
+        map(p, p + k, p, negative);
+        multiply_schoolbook(p, k, r10, l, r00);
+        multiply_schoolbook(p, k, r11, l, r01);
+        l = l + predecessor(k);
+        swap(r00, r10);
+        swap(r01, r11);
+        du = predecessor(dv);
+        while (0 <= du and load(u + du) == Zero<R>) decrement(du);
+        swap(u, v);
+        swap(du, dv);
+    }
+    auto entry = [l](auto cur){
+        polynomial<R, C> z(l, Zero<R>);
+        copy(cur, cur + l, first(z.coefficients));
+        return z;
+    };
+    return {entry(r00), entry(r01), entry(r10), entry(r11)};
+}
+
+inline constexpr pointer_diff polynomial_half_gcd_threshold = 2048;
+
+template <Ring R, Dynamic_sequence C>
+requires Field<R>
+auto
+half_gcd(polynomial<R, C> const& x, polynomial<R, C> const& y) -> polynomial_matrix<R, C>
+//[[expects: degree(y) <= degree(x)]]
+// Returns the product m of the Euclidean division steps for x and y that
+// stop at the first remainder of degree below h = ceil(degree(x) / 2), such
+// that m (x, y) = (a, b) with degree(b) < h <= degree(a). The steps for the
+// upper half of x and y are computed recursively from their upper halves,
+// using fast multiplication, in O(M(n) log n) instead of quadratic time.
+{
+    polynomial_matrix<R, C> m{One<polynomial<R, C>>, {}, {}, One<polynomial<R, C>>};
+    auto dx = degree(x);
+    auto h = half(successor(dx));
+    if (degree(y) < h) return m;
+    if (dx < polynomial_half_gcd_threshold) return half_gcd_schoolbook(x, y);
+    m = half_gcd(divide_by_power(x, h), divide_by_power(y, h));
+    auto ab = apply(m, x, y);
+    if (degree(ab.m1) < h) return m;
+    auto qr = quotient_remainder(ab.m0, ab.m1);
+    m = euclidean_step(m, qr.m0);
+    auto k = twice(h) - degree(ab.m1);
+    return half_gcd(divide_by_power(ab.m1, k), divide_by_power(qr.m1, k)) * m;
+}
+
+template <Ring R, Dynamic_sequence C>
+requires Field<R>
+auto
+gcd(polynomial<R, C> x, polynomial<R, C> y) -> polynomial<R, C>
+// Returns the monic greatest common divisor, or zero if both are zero,
+// reducing large arguments to half their degree with each half_gcd
+{
+    if (degree(x) < degree(y)) swap(x, y);
+    while (polynomial_half_gcd_threshold <= degree(y)) {
+        auto ab = apply(half_gcd(x, y), x, y);
+        if (ab.m1 == Zero<polynomial<R, C>>) return monic(ab.m0);
+        x = mv(ab.m1);
+        y = remainder(ab.m0, x);
+    }
+    return gcd_euclidean(x, y);
+}
+
+template <Ring R, Dynamic_sequence C>
+requires Field<R>
+auto
+compose_modular(polynomial<R, C> const& p, polynomial<R, C> const& x, polynomial<R, C> const& m) -> polynomial<R, C>
+//[[expects: m != 0]]
+// Returns p(x) mod m with Horner's scheme, reducing after each step
+{
+    auto k = degree(p);
+    if (k < 0) return Zero<polynomial<R, C>>;
+    auto y = remainder(x, m);
+    auto r = remainder(polynomial<R, C>{p[k]}, m);
+    while (k > 0) {
+        decrement(k);
+        r = remainder(r * y + polynomial<R, C>{p[k]}, m);
+    }
+    return r;
+}
+
 }
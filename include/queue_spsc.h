@@ -0,0 +1,213 @@
+#pragma once
+
+#include "copy.h"
+#include "memory.h"
+#include "ordering.h"
+#include "range.h"
+
+namespace elements {
+
+struct alignas(cache_line_size) queue_spsc_index
+{
+    atomic<pointer_diff> i{Zero<pointer_diff>};
+    pointer_diff opposite{Zero<pointer_diff>};
+};
+
+constexpr auto
+queue_spsc_capacity(pointer_diff n) -> pointer_diff
+{
+    auto capacity = One<pointer_diff>;
+    while (capacity < n) capacity = twice(capacity);
+    return capacity;
+}
+
+template <typename T, Invocable auto alloc = array_allocator<T>>
+struct queue_spsc
+{
+    Pointer_type<T> data{};
+    pointer_diff mask{};
+    // The producer owns tail and caches head in tail.opposite, the consumer
+    // owns head and caches tail in head.opposite, each on its own cache line.
+    queue_spsc_index tail;
+    queue_spsc_index head;
+
+    explicit
+    queue_spsc(pointer_diff capacity)
+        : mask{predecessor(queue_spsc_capacity(capacity))}
+    {
+        data = reinterpret_cast<Pointer_type<T>>(
+            allocate(alloc(), successor(mask) * static_cast<pointer_diff>(sizeof(T))).first);
+    }
+
+    queue_spsc(queue_spsc const&) = delete;
+
+    queue_spsc(queue_spsc&&) = delete;
+
+    auto operator=(queue_spsc const&) -> queue_spsc& = delete;
+
+    auto operator=(queue_spsc&&) -> queue_spsc& = delete;
+
+    ~queue_spsc()
+    {
+        auto h = head.i.load(memory_order_relaxed);
+        auto t = tail.i.load(memory_order_relaxed);
+        while (h != t) {
+            destroy_at(data + (h & mask));
+            increment(h);
+        }
+        deallocate(alloc(), memory{reinterpret_cast<Pointer_type<byte>>(data), successor(mask) * static_cast<pointer_diff>(sizeof(T))});
+    }
+};
+
+template <typename T, Invocable auto alloc>
+struct value_type_t<queue_spsc<T, alloc>>
+{
+    using type = T;
+};
+
+template <typename T, Invocable auto alloc>
+struct size_type_t<queue_spsc<T, alloc>>
+{
+    using type = pointer_diff;
+};
+
+template <typename T, Invocable auto alloc>
+constexpr auto
+capacity(queue_spsc<T, alloc> const& q) -> Size_type<queue_spsc<T, alloc>>
+{
+    return successor(q.mask);
+}
+
+template <typename T, Invocable auto alloc>
+constexpr auto
+free_size_producer(queue_spsc<T, alloc>& q, pointer_diff t, pointer_diff n) -> pointer_diff
+{
+    auto free = capacity(q) - (t - q.tail.opposite);
+    if (free < n) {
+        q.tail.opposite = q.head.i.load(memory_order_acquire);
+        free = capacity(q) - (t - q.tail.opposite);
+    }
+    return free;
+}
+
+template <typename T, Invocable auto alloc>
+constexpr auto
+size_consumer(queue_spsc<T, alloc>& q, pointer_diff h, pointer_diff n) -> pointer_diff
+{
+    auto size = q.head.opposite - h;
+    if (size < n) {
+        q.head.opposite = q.tail.i.load(memory_order_acquire);
+        size = q.head.opposite - h;
+    }
+    return size;
+}
+
+template <typename T, Invocable auto alloc>
+constexpr auto
+try_push(queue_spsc<T, alloc>& q, T const& x) -> bool
+{
+    auto t = q.tail.i.load(memory_order_relaxed);
+    if (is_zero(free_size_producer(q, t, One<pointer_diff>))) return false;
+    construct_at(q.data + (t & q.mask), x);
+    q.tail.i.store(successor(t), memory_order_release);
+    return true;
+}
+
+template <typename T, Invocable auto alloc>
+constexpr auto
+try_push(queue_spsc<T, alloc>& q, T&& x) -> bool
+{
+    auto t = q.tail.i.load(memory_order_relaxed);
+    if (is_zero(free_size_producer(q, t, One<pointer_diff>))) return false;
+    construct_at(q.data + (t & q.mask), fw<T>(x));
+    q.tail.i.store(successor(t), memory_order_release);
+    return true;
+}
+
+template <typename T, Invocable auto alloc>
+constexpr auto
+try_pop(queue_spsc<T, alloc>& q, T& x) -> bool
+{
+    auto h = q.head.i.load(memory_order_relaxed);
+    if (is_zero(size_consumer(q, h, One<pointer_diff>))) return false;
+    auto& y = at(q.data + (h & q.mask));
+    x = mv(y);
+    destroy_at(pointer_to(y));
+    q.head.i.store(successor(h), memory_order_release);
+    return true;
+}
+
+template <typename T, Invocable auto alloc, Cursor S>
+requires Same_as<Remove_const<Value_type<S>>, T>
+constexpr auto
+try_push_n(queue_spsc<T, alloc>& q, S src, pointer_diff n) -> pointer_diff
+{
+    auto t = q.tail.i.load(memory_order_relaxed);
+    n = min(n, free_size_producer(q, t, n));
+    if (is_zero(n)) return n;
+    auto i = t & q.mask;
+    auto n0 = min(n, capacity(q) - i);
+    auto cur = construct_copy_n(src, n0, q.data + i);
+    construct_copy_n(cur.m0, n - n0, q.data);
+    q.tail.i.store(t + n, memory_order_release);
+    return n;
+}
+
+template <typename T, Cursor D>
+requires Same_as<Value_type<D>, T>
+constexpr auto
+move_out_queue_spsc(Pointer_type<T> src, pointer_diff n, D dst) -> D
+{
+    while (count_down(n)) {
+        at(dst) = mv(at(src));
+        destroy_at(src);
+        increment(src);
+        increment(dst);
+    }
+    return dst;
+}
+
+template <Trivially_copyable T, Cursor D>
+requires Same_as<Value_type<D>, T>
+constexpr auto
+move_out_queue_spsc(Pointer_type<T> src, pointer_diff n, D dst) -> D
+{
+    return copy(src, src + n, dst);
+}
+
+template <typename T, Invocable auto alloc, Cursor D>
+requires Same_as<Value_type<D>, T>
+constexpr auto
+try_pop_n(queue_spsc<T, alloc>& q, pointer_diff n, D dst) -> pointer_diff
+{
+    auto h = q.head.i.load(memory_order_relaxed);
+    n = min(n, size_consumer(q, h, n));
+    if (is_zero(n)) return n;
+    auto i = h & q.mask;
+    auto n0 = min(n, capacity(q) - i);
+    dst = move_out_queue_spsc(q.data + i, n0, dst);
+    move_out_queue_spsc(q.data, n - n0, dst);
+    q.head.i.store(h + n, memory_order_release);
+    return n;
+}
+
+template <typename T, Invocable auto alloc>
+constexpr auto
+reserve(queue_spsc<T, alloc>& q, pointer_diff n) -> bounded_range<Pointer_type<T>>
+{
+    auto t = q.tail.i.load(memory_order_relaxed);
+    auto i = t & q.mask;
+    n = min(n, free_size_producer(q, t, n), capacity(q) - i);
+    return {q.data + i, q.data + i + n};
+}
+
+template <typename T, Invocable auto alloc>
+constexpr void
+commit(queue_spsc<T, alloc>& q, pointer_diff n)
+//[[expects: n <= size(reserve(q, n))]]
+{
+    auto t = q.tail.i.load(memory_order_relaxed);
+    q.tail.i.store(t + n, memory_order_release);
+}
+
+}
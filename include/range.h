@@ -64,7 +64,7 @@ struct lt<bounded_range<C, L>>
     constexpr auto
     operator()(bounded_range<C, L> const& x, bounded_range<C, L> const& y) -> bool
     {
-        lt less_cur;
+        lt<> less_cur;
         return
             less_cur(first(x), first(y)) or
             (!less_cur(first(y), first(x)) and less_cur(limit(x), limit(y)));
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "integer.h"
 #include "ordered_algebra.h"
 
 namespace elements {
@@ -151,4 +152,198 @@ half(rational<I> const& x) -> rational<I>
     return {x.p, twice(x.q)};
 }
 
+template <Integral I>
+constexpr auto
+normalize(rational<I> const& x) -> rational<I>
+//[[expects: x.q != 0]]
+// Returns x in lowest terms with a positive denominator
+{
+    auto g = static_cast<I>(gcd_binary(x.p, x.q));
+    if (x.q < I{0}) g = -g;
+    return {static_cast<I>(x.p / g), static_cast<I>(x.q / g)};
+}
+
+template <Signed_integral I>
+inline constexpr I rational_normalized_limit = Max_integral<I> >> (4 * sizeof(I));
+
+template <Signed_integral I>
+struct rational_normalized
+{
+    // p / q with q > 0, reduced lazily: the terms of a result may share a
+    // factor as long as both are at most rational_normalized_limit<I>. The
+    // arithmetic is done in Wide_type<I>, so any representable terms can be
+    // combined without overflow, and only results beyond the limit are
+    // reduced, from reduced operands with Henrici's formulas, which take
+    // greatest common divisors of operand terms instead of result terms.
+    constexpr
+    rational_normalized() = default;
+
+    constexpr
+    rational_normalized(I const& p_)
+        : p{p_}, q{One<I>}
+    {}
+
+    constexpr
+    rational_normalized(I const& p_, I const& q_)
+    //[[expects: q != Zero<I>]]
+        : p{q_ < I{0} ? -p_ : p_}, q{q_ < I{0} ? -q_ : q_}
+    {}
+
+    I p = Zero<I>;
+    I q = One<I>;
+};
+
+template <Signed_integral I>
+struct zero_type_t<rational_normalized<I>>
+{
+    static constexpr rational_normalized<I> value{};
+};
+
+template <Signed_integral I>
+struct one_type_t<rational_normalized<I>>
+{
+    static constexpr rational_normalized<I> value{One<I>};
+};
+
+template <Signed_integral I>
+constexpr auto
+normalize(rational_normalized<I> const& x) -> rational_normalized<I>
+{
+    auto g = static_cast<I>(gcd_binary(x.p, x.q));
+    return {static_cast<I>(x.p / g), static_cast<I>(x.q / g)};
+}
+
+template <Signed_integral I>
+constexpr auto
+is_normalized(rational_normalized<I> const& x) -> bool
+{
+    return gcd_binary(x.p, x.q) == 1;
+}
+
+template <Signed_integral I>
+constexpr auto
+rational_normalized_terms(Wide_type<I> const& p, Wide_type<I> const& q) -> rational_normalized<I>
+//[[expects: 0 < q and p and q are representable in I]]
+{
+    rational_normalized<I> x;
+    x.p = static_cast<I>(p);
+    x.q = static_cast<I>(q);
+    return x;
+}
+
+template <Signed_integral I>
+constexpr auto
+is_within_limit(Wide_type<I> const& p, Wide_type<I> const& q) -> bool
+{
+    using W = Wide_type<I>;
+    auto l = static_cast<W>(rational_normalized_limit<I>);
+    return -l <= p and p <= l and q <= l;
+}
+
+template <Signed_integral I>
+constexpr auto
+operator==(rational_normalized<I> const& x, rational_normalized<I> const& y) -> bool
+{
+    using W = Wide_type<I>;
+    return static_cast<W>(x.p) * y.q == static_cast<W>(y.p) * x.q;
+}
+
+template <Signed_integral I>
+constexpr auto
+operator<(rational_normalized<I> const& x, rational_normalized<I> const& y) -> bool
+{
+    using W = Wide_type<I>;
+    return static_cast<W>(x.p) * y.q < static_cast<W>(y.p) * x.q;
+}
+
+template <Signed_integral I>
+constexpr auto
+operator+(rational_normalized<I> const& x, rational_normalized<I> const& y) -> rational_normalized<I>
+//[[expects: the reduced sum is representable in I]]
+{
+    using W = Wide_type<I>;
+    auto p = static_cast<W>(x.p) * y.q + static_cast<W>(y.p) * x.q;
+    auto q = static_cast<W>(x.q) * y.q;
+    if (is_within_limit<I>(p, q)) return rational_normalized_terms<I>(p, q);
+    auto a = normalize(x);
+    auto b = normalize(y);
+    auto g = static_cast<I>(gcd_binary(a.q, b.q));
+    if (g == One<I>) {
+        return rational_normalized_terms<I>(
+            static_cast<W>(a.p) * b.q + static_cast<W>(b.p) * a.q,
+            static_cast<W>(a.q) * b.q);
+    }
+    auto s = static_cast<I>(a.q / g);
+    auto t = static_cast<W>(a.p) * (b.q / g) + static_cast<W>(b.p) * s;
+    auto h = static_cast<I>(gcd_binary(static_cast<I>(t % g), g));
+    return rational_normalized_terms<I>(t / h, static_cast<W>(s) * (b.q / h));
+}
+
+template <Signed_integral I>
+constexpr auto
+operator*(rational_normalized<I> const& x, rational_normalized<I> const& y) -> rational_normalized<I>
+//[[expects: the reduced product is representable in I]]
+{
+    using W = Wide_type<I>;
+    auto p = static_cast<W>(x.p) * y.p;
+    auto q = static_cast<W>(x.q) * y.q;
+    if (is_within_limit<I>(p, q)) return rational_normalized_terms<I>(p, q);
+    auto a = normalize(x);
+    auto b = normalize(y);
+    auto g0 = static_cast<I>(gcd_binary(a.p, b.q));
+    auto g1 = static_cast<I>(gcd_binary(b.p, a.q));
+    return rational_normalized_terms<I>(
+        static_cast<W>(a.p / g0) * (b.p / g1),
+        static_cast<W>(a.q / g1) * (b.q / g0));
+}
+
+template <Signed_integral I>
+constexpr auto
+operator-(rational_normalized<I> const& x) -> rational_normalized<I>
+{
+    auto y = x;
+    y.p = -x.p;
+    return y;
+}
+
+template <Signed_integral I>
+constexpr auto
+operator-(rational_normalized<I> const& x, rational_normalized<I> const& y) -> rational_normalized<I>
+{
+    return x + (-y);
+}
+
+template <Signed_integral I>
+struct reciprocal_op<rational_normalized<I>>
+{
+    constexpr auto
+    operator()(rational_normalized<I> const& x) const -> rational_normalized<I>
+    // [[expects: x.p != 0]]
+    {
+        return {x.q, x.p};
+    }
+};
+
+template <Signed_integral I>
+constexpr auto
+operator/(rational_normalized<I> const& x, rational_normalized<I> const& y) -> rational_normalized<I>
+// [[expects: y.p != 0]]
+{
+    return x * reciprocal_op<rational_normalized<I>>{}(y);
+}
+
+template <Signed_integral I>
+constexpr auto
+operator*(I const& n, rational_normalized<I> const& x) -> rational_normalized<I>
+{
+    return rational_normalized<I>{n} * x;
+}
+
+template <Signed_integral I>
+constexpr auto
+operator*(rational_normalized<I> const& x, I const& n) -> rational_normalized<I>
+{
+    return x * rational_normalized<I>{n};
+}
+
 }
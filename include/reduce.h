@@ -1,6 +1,8 @@
 #pragma once
 
+#include "array_single_ended.h"
 #include "binary_counter.h"
+#include "parallel.h"
 
 namespace elements {
 
@@ -52,6 +54,38 @@ reduce(C cur, L lim, Op op, Value_type<C> const& zero) -> Value_type<C>
     return reduce(mv(cur), mv(lim), op, [](C const& c){ return load(c); }, zero);
 }
 
+template <Segmented_cursor C, Operation<Value_type<C>, Value_type<C>> Op>
+requires Loadable<C>
+constexpr auto
+reduce(C cur, C lim, Op op, Value_type<C> const& zero) -> Value_type<C>
+//[[expects axiom: partially_associative(op)]]
+{
+    auto index_cur = index_cursor(cur);
+    auto index_lim = index_cursor(lim);
+    if (!precedes(index_cur, index_lim)) {
+        return reduce(segment_cursor(cur), segment_cursor(lim), op, zero);
+    } else {
+        auto seg_cur = segment_cursor(cur);
+        while (!precedes(seg_cur, limit(load(index_cur)))) {
+            increment(index_cur);
+            seg_cur = first(load(index_cur));
+            if (!precedes(index_cur, index_lim)) return reduce(seg_cur, segment_cursor(lim), op, zero);
+        }
+        auto x = reduce_nonempty(seg_cur, limit(load(index_cur)), op);
+        increment(index_cur);
+        while (precedes(index_cur, index_lim)) {
+            if (precedes(first(load(index_cur)), limit(load(index_cur)))) {
+                store(x, op(x, reduce_nonempty(first(load(index_cur)), limit(load(index_cur)), op)));
+            }
+            increment(index_cur);
+        }
+        if (precedes(first(load(index_cur)), segment_cursor(lim))) {
+            store(x, op(x, reduce_nonempty(first(load(index_cur)), segment_cursor(lim), op)));
+        }
+        return x;
+    }
+}
+
 template <Cursor C, Limit<C> L, Regular_invocable<C> F, Operation<Return_type<F, C>, Return_type<F, C>> Op>
 constexpr auto
 reduce_nonzeroes(C cur, L lim, Op op, F fun, Return_type<F, C> const& zero) -> Return_type<F, C>
@@ -104,7 +138,48 @@ reduce_balanced(C cur, L lim, Op op, Value_type<C> const& zero) -> Value_type<C>
 //[[expects axiom: loadable_range(cur, lim)]]
 //[[expects axiom: partially_associative(op)]]
 {
-    return reduce_balanced(mv(cur), mv(lim), op, [](C const& c){ return load(c); }, zero);
+    binary_counter<Remove_const<Value_type<C>>, Op> counter(op, zero);
+    counter(mv(cur), mv(lim));
+    transpose_op<Remove_const<Value_type<C>>, Op> transposed_op(op);
+    return reduce_nonzeroes(first(counter), limit(counter), transposed_op, zero);
+}
+
+inline constexpr pointer_diff reduce_balanced_block = 4096;
+
+template <Indexed_cursor C, Regular_invocable<C> F, Operation<Return_type<F, C>, Return_type<F, C>> Op>
+auto
+reduce_balanced_parallel(C cur, C lim, Op op, F fun, Return_type<F, C> const& zero, pointer_diff workers = hardware_concurrency()) -> Return_type<F, C>
+//[[expects axiom: range(cur, lim)]]
+//[[expects axiom: partially_associative(op)]]
+// The workers reduce blocks of reduce_balanced_block elements each with
+// reduce_balanced, and the block results are reduced in order with
+// reduce_balanced, so the result does not depend on the number of workers.
+{
+    auto n = lim - cur;
+    auto m = (n + predecessor(reduce_balanced_block)) / reduce_balanced_block;
+    array_single_ended<Return_type<F, C>> blocks(m, zero);
+    auto w = parallel_workers(m, One<pointer_diff>, workers);
+    for_each_worker(w, [&](pointer_diff i){
+        auto j = m * i / w;
+        auto j_lim = m * successor(i) / w;
+        while (j < j_lim) {
+            auto block_cur = cur + j * reduce_balanced_block;
+            auto block_lim = cur + min(n, successor(j) * reduce_balanced_block);
+            store(at(first(blocks) + j), reduce_balanced(block_cur, block_lim, op, fun, zero));
+            increment(j);
+        }
+    });
+    return reduce_balanced(first(blocks), limit(blocks), op, zero);
+}
+
+template <Indexed_cursor C, Operation<Value_type<C>, Value_type<C>> Op>
+requires Loadable<C>
+auto
+reduce_balanced_parallel(C cur, C lim, Op op, Value_type<C> const& zero, pointer_diff workers = hardware_concurrency()) -> Value_type<C>
+//[[expects axiom: loadable_range(cur, lim)]]
+//[[expects axiom: partially_associative(op)]]
+{
+    return reduce_balanced_parallel(mv(cur), mv(lim), op, [](C const& c){ return load(c); }, zero, workers);
 }
 
 }
@@ -0,0 +1,782 @@
+#pragma once
+
+#include "bit_array.h"
+
+namespace elements {
+
+inline constexpr pointer_diff roaring_array_limit = 4096;
+
+inline constexpr pointer_diff roaring_bitmap_words = 1024;
+
+enum struct roaring_kind
+{
+    array, bitmap, run
+};
+
+template <Invocable auto alloc = array_allocator<N<64>>>
+struct roaring_container
+{
+    // An array holds its values in increasing order in values, and a run
+    // container the first value and the length minus one of each run of
+    // consecutive values, in increasing order. A bitmap holds all 2^16
+    // possible values as bits of words. Arrays hold at most
+    // roaring_array_limit values, and bitmaps more, except that run_optimize
+    // may turn either into runs
+    roaring_kind kind{roaring_kind::array};
+    pointer_diff cardinality{};
+    array_single_ended<N<16>, alloc> values;
+    array_single_ended<N<64>, alloc> words;
+};
+
+template <Invocable auto alloc>
+constexpr auto
+operator==(roaring_container<alloc> const& x, roaring_container<alloc> const& y) -> bool
+{
+    return x.kind == y.kind and x.cardinality == y.cardinality and x.values == y.values and x.words == y.words;
+}
+
+template <Invocable auto alloc>
+constexpr auto
+operator<(roaring_container<alloc> const& x, roaring_container<alloc> const& y) -> bool
+{
+    if (x.kind != y.kind) return x.kind < y.kind;
+    if (x.cardinality != y.cardinality) return x.cardinality < y.cardinality;
+    if (!(x.values == y.values)) return x.values < y.values;
+    return x.words < y.words;
+}
+
+template <Invocable auto alloc = array_allocator<N<64>>>
+struct roaring_bitmap
+{
+    // The values with the same high 16 bits form a chunk, whose low 16 bits
+    // are stored in a container. keys holds the high bits of the nonempty
+    // chunks in increasing order, and containers their containers
+    array_single_ended<N<16>, alloc> keys;
+    array_single_ended<roaring_container<alloc>, alloc> containers;
+
+    constexpr
+    roaring_bitmap() = default;
+
+    template <Cursor C, Limit<C> L>
+    requires Convertible_to<Value_type<C>, N<32>>
+    roaring_bitmap(C cur, L lim);
+};
+
+template <Invocable auto alloc>
+auto
+roaring_array(Pointer_type<N<16> const> src, pointer_diff n) -> array_single_ended<N<16>, alloc>
+{
+    array_single_ended<N<16>, alloc> x(n, N<16>{0});
+    auto dst = first(x);
+    for (pointer_diff i = 0; i < n; ++i) dst[i] = src[i];
+    return x;
+}
+
+template <Invocable auto alloc>
+auto
+roaring_words(roaring_container<alloc> const& x) -> array_single_ended<N<64>, alloc>
+// Returns the 1024 words of the bitmap of the values of x
+{
+    if (x.kind == roaring_kind::bitmap) return x.words;
+    array_single_ended<N<64>, alloc> w(roaring_bitmap_words, N<64>{0});
+    auto v = first(x.values);
+    if (x.kind == roaring_kind::array) {
+        for (pointer_diff i = 0; i < x.cardinality; ++i) w[v[i] / 64] = w[v[i] / 64] | N<64>{1} << (v[i] % 64);
+        return w;
+    }
+    for (pointer_diff r = 0; r < size(x.values); r = r + 2) {
+        pointer_diff i = v[r];
+        pointer_diff j = i + v[successor(r)] + 1;
+        while (i < j) {
+            // Whole words of the run are filled at once
+            auto l = min(j, (i / 64 + 1) * 64);
+            w[i / 64] = w[i / 64] | (bit_array_mask(l - i) << (i % 64));
+            i = l;
+        }
+    }
+    return w;
+}
+
+template <Invocable auto alloc>
+auto
+roaring_from_words(array_single_ended<N<64>, alloc> w, pointer_diff cardinality) -> roaring_container<alloc>
+// Returns the container of the values of the bitmap w, an array if there are
+// few enough of them
+{
+    roaring_container<alloc> x;
+    x.cardinality = cardinality;
+    if (roaring_array_limit < cardinality) {
+        x.kind = roaring_kind::bitmap;
+        x.words = mv(w);
+        return x;
+    }
+    reserve(x.values, cardinality);
+    auto p = first(w);
+    for (pointer_diff i = 0; i < roaring_bitmap_words; ++i) {
+        auto u = p[i];
+        while (!is_zero(u)) {
+            push(x.values, static_cast<N<16>>(i * 64 + countr_zero(u)));
+            u = u & (u - 1);
+        }
+    }
+    return x;
+}
+
+template <Invocable auto alloc>
+auto
+roaring_expand(roaring_container<alloc> const& x) -> roaring_container<alloc>
+// Returns x as an array or bitmap
+{
+    if (x.kind != roaring_kind::run) return x;
+    return roaring_from_words(roaring_words(x), x.cardinality);
+}
+
+template <Invocable auto alloc>
+auto
+contains(roaring_container<alloc> const& x, N<16> v) -> bool
+{
+    auto p = first(x.values);
+    switch (x.kind) {
+        case roaring_kind::array: {
+            auto c = search_binary_lower_n(p, x.cardinality, v);
+            return c != p + x.cardinality and load(c) == v;
+        }
+        case roaring_kind::bitmap:
+            return ((x.words[v / 64] >> (v % 64)) & 1) != 0;
+        case roaring_kind::run: {
+            // Finds the last run starting at or before v
+            pointer_diff i = 0;
+            auto n = half(size(x.values));
+            while (!is_zero(n)) {
+                auto h = half(n);
+                if (p[twice(i + h)] <= v) {
+                    i = i + h + 1;
+                    n = n - h - 1;
+                } else {
+                    n = h;
+                }
+            }
+            if (is_zero(i)) return false;
+            auto r = twice(predecessor(i));
+            return v - p[r] <= p[successor(r)];
+        }
+    }
+    return false;
+}
+
+template <Invocable auto alloc>
+void
+insert(roaring_container<alloc>& x, N<16> v)
+{
+    if (x.kind == roaring_kind::run) x = roaring_expand(x);
+    if (x.kind == roaring_kind::bitmap) {
+        auto& w = x.words[v / 64];
+        auto m = N<64>{1} << (v % 64);
+        if ((w & m) == 0) increment(x.cardinality);
+        w = w | m;
+        return;
+    }
+    auto p = first(x.values);
+    auto i = search_binary_lower_n(p, x.cardinality, v) - p;
+    if (i < x.cardinality and x.values[i] == v) return;
+    if (x.cardinality == roaring_array_limit) {
+        auto w = roaring_words(x);
+        w[v / 64] = w[v / 64] | N<64>{1} << (v % 64);
+        x = roaring_from_words(mv(w), successor(x.cardinality));
+        return;
+    }
+    push(x.values, v);
+    for (auto j = x.cardinality; i < j; --j) x.values[j] = x.values[predecessor(j)];
+    x.values[i] = v;
+    increment(x.cardinality);
+}
+
+template <Invocable auto alloc>
+auto
+roaring_find(roaring_bitmap<alloc> const& x, N<16> key) -> pointer_diff
+// Returns the position of the container of key, or where it would be inserted
+{
+    auto p = first(x.keys);
+    return search_binary_lower_n(p, size(x.keys), key) - p;
+}
+
+template <Invocable auto alloc>
+auto
+contains(roaring_bitmap<alloc> const& x, N<32> v) -> bool
+{
+    auto key = static_cast<N<16>>(v >> 16);
+    auto i = roaring_find(x, key);
+    return i < size(x.keys) and x.keys[i] == key and contains(x.containers[i], static_cast<N<16>>(v));
+}
+
+template <Invocable auto alloc>
+void
+insert(roaring_bitmap<alloc>& x, N<32> v)
+// Inserts v into x, in amortized constant time if it is at least the greatest
+// value of x
+{
+    auto key = static_cast<N<16>>(v >> 16);
+    auto n = size(x.keys);
+    auto i = (is_zero(n) or x.keys[predecessor(n)] < key) ? n : roaring_find(x, key);
+    if (i == n or x.keys[i] != key) {
+        push(x.keys, key);
+        push(x.containers, roaring_container<alloc>{});
+        for (auto j = n; i < j; --j) {
+            x.keys[j] = x.keys[predecessor(j)];
+            swap(x.containers[j], x.containers[predecessor(j)]);
+        }
+        x.keys[i] = key;
+    }
+    insert(x.containers[i], static_cast<N<16>>(v));
+}
+
+template <Invocable auto alloc>
+template <Cursor C, Limit<C> L>
+requires Convertible_to<Value_type<C>, N<32>>
+roaring_bitmap<alloc>::roaring_bitmap(C cur, L lim)
+{
+    while (precedes(cur, lim)) {
+        insert(at(this), static_cast<N<32>>(load(cur)));
+        increment(cur);
+    }
+}
+
+template <Invocable auto alloc>
+auto
+size(roaring_bitmap<alloc> const& x) -> pointer_diff
+// Returns the number of values of x
+{
+    pointer_diff n = 0;
+    for (pointer_diff i = 0; i < size(x.containers); ++i) n = n + x.containers[i].cardinality;
+    return n;
+}
+
+template <Invocable auto alloc>
+auto
+is_empty(roaring_bitmap<alloc> const& x) -> bool
+{
+    return is_empty(x.keys);
+}
+
+template <Invocable auto alloc, Invocable<N<32>> P>
+void
+for_each_value(roaring_bitmap<alloc> const& x, P proc)
+// Calls proc with each value of x in increasing order
+{
+    for (pointer_diff i = 0; i < size(x.keys); ++i) {
+        auto high = static_cast<N<32>>(x.keys[i]) << 16;
+        auto const& c = x.containers[i];
+        auto v = first(c.values);
+        switch (c.kind) {
+            case roaring_kind::array:
+                for (pointer_diff j = 0; j < c.cardinality; ++j) proc(high | v[j]);
+                break;
+            case roaring_kind::bitmap:
+                for (pointer_diff j = 0; j < roaring_bitmap_words; ++j) {
+                    auto u = c.words[j];
+                    while (!is_zero(u)) {
+                        proc(high | static_cast<N<32>>(j * 64 + countr_zero(u)));
+                        u = u & (u - 1);
+                    }
+                }
+                break;
+            case roaring_kind::run:
+                for (pointer_diff r = 0; r < size(c.values); r = r + 2) {
+                    for (pointer_diff j = 0; j <= v[successor(r)]; ++j) proc(high | static_cast<N<32>>(v[r] + j));
+                }
+                break;
+        }
+    }
+}
+
+template <Invocable auto alloc>
+auto
+operator==(roaring_bitmap<alloc> const& x, roaring_bitmap<alloc> const& y) -> bool
+// Compares the sets of values, whatever their containers
+{
+    if (!(x.keys == y.keys)) return false;
+    for (pointer_diff i = 0; i < size(x.keys); ++i) {
+        auto const& c = x.containers[i];
+        auto const& d = y.containers[i];
+        if (c.cardinality != d.cardinality) return false;
+        if (c.kind == d.kind and !(c == d)) return false;
+        if (c.kind != d.kind and !(roaring_words(c) == roaring_words(d))) return false;
+    }
+    return true;
+}
+
+inline auto
+roaring_count_runs(Pointer_type<N<64> const> w) -> pointer_diff
+// Returns the number of runs of ones in the 1024 words w, which are the ones
+// whose preceding bit is zero
+{
+    pointer_diff n = 0;
+    N<64> carry = 0;
+    for (pointer_diff i = 0; i < roaring_bitmap_words; ++i) {
+        n = n + popcount(w[i] & ~((w[i] << 1) | carry));
+        carry = w[i] >> 63;
+    }
+    return n;
+}
+
+template <Invocable auto alloc>
+void
+run_optimize(roaring_bitmap<alloc>& x)
+// Turns each container of x that takes less space as runs into runs
+{
+    for (pointer_diff i = 0; i < size(x.containers); ++i) {
+        auto& c = x.containers[i];
+        if (c.kind == roaring_kind::run) continue;
+        auto w = roaring_words(c);
+        auto p = first(w);
+        auto runs = roaring_count_runs(p);
+        auto bytes = c.kind == roaring_kind::array ? twice(c.cardinality) : roaring_bitmap_words * 8;
+        if (bytes <= 4 * runs) continue;
+        roaring_container<alloc> r;
+        r.kind = roaring_kind::run;
+        r.cardinality = c.cardinality;
+        reserve(r.values, twice(runs));
+        pointer_diff j = 0;
+        while (j < roaring_bitmap_words * 64) {
+            // Skips to the next one, and then to the next zero
+            auto u = p[j / 64] >> (j % 64);
+            if (is_zero(u)) {
+                j = (j / 64 + 1) * 64;
+                continue;
+            }
+            j = j + countr_zero(u);
+            auto start = j;
+            while (j < roaring_bitmap_words * 64) {
+                auto z = ~p[j / 64] >> (j % 64);
+                if (!is_zero(z)) {
+                    j = j + countr_zero(z);
+                    break;
+                }
+                j = (j / 64 + 1) * 64;
+            }
+            j = min(j, roaring_bitmap_words * 64);
+            push(r.values, static_cast<N<16>>(start));
+            push(r.values, static_cast<N<16>>(j - start - 1));
+        }
+        c = mv(r);
+    }
+}
+
+struct roaring_shuffle_table
+{
+    N<8> bytes[256][16];
+};
+
+inline constexpr auto roaring_shuffles = [](){
+    // Entry m moves the 16-bit lanes selected by the bits of m to the front
+    roaring_shuffle_table t{};
+    for (pointer_diff m = 0; m < 256; ++m) {
+        pointer_diff k = 0;
+        for (pointer_diff b = 0; b < 8; ++b) {
+            if (((m >> b) & 1) != 0) {
+                t.bytes[m][twice(k)] = static_cast<N<8>>(twice(b));
+                t.bytes[m][successor(twice(k))] = static_cast<N<8>>(successor(twice(b)));
+                increment(k);
+            }
+        }
+        for (; k < 8; ++k) {
+            t.bytes[m][twice(k)] = 0x80;
+            t.bytes[m][successor(twice(k))] = 0x80;
+        }
+    }
+    return t;
+}();
+
+inline auto
+intersect_arrays(Pointer_type<N<16> const> a, pointer_diff n_a, Pointer_type<N<16> const> b, pointer_diff n_b, Pointer_type<N<16>> dst) -> pointer_diff
+//[[expects: dst has room for min(n_a, n_b) + 8 values]]
+// Stores the values common to the increasing arrays a and b in dst and
+// returns their number. With SSE 4.2, blocks of eight values of a are
+// compared with blocks of eight values of b all at once, and the matches
+// moved to the front by a byte shuffle, after Schlegel, Willhalm and Lehner
+{
+    pointer_diff i = 0;
+    pointer_diff j = 0;
+    pointer_diff k = 0;
+#if defined(__SSE4_2__)
+    while (i + 8 <= n_a and j + 8 <= n_b) {
+        auto v_a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a + i));
+        auto v_b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(b + j));
+        auto m = _mm_cmpestrm(v_b, 8, v_a, 8, _SIDD_UWORD_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK);
+        auto r = _mm_cvtsi128_si32(m);
+        auto s = _mm_loadu_si128(reinterpret_cast<__m128i const*>(roaring_shuffles.bytes[r]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k), _mm_shuffle_epi8(v_a, s));
+        k = k + popcount(static_cast<N<32>>(r));
+        auto max_a = a[i + 7];
+        auto max_b = b[j + 7];
+        if (max_a <= max_b) i = i + 8;
+        if (max_b <= max_a) j = j + 8;
+    }
+#endif
+    while (i < n_a and j < n_b) {
+        if (a[i] < b[j]) {
+            increment(i);
+        } else if (b[j] < a[i]) {
+            increment(j);
+        } else {
+            dst[k] = a[i];
+            increment(i);
+            increment(j);
+            increment(k);
+        }
+    }
+    return k;
+}
+
+inline auto
+unite_arrays(Pointer_type<N<16> const> a, pointer_diff n_a, Pointer_type<N<16> const> b, pointer_diff n_b, Pointer_type<N<16>> dst) -> pointer_diff
+// Stores the values of either of the increasing arrays a and b in dst and
+// returns their number
+{
+    pointer_diff i = 0;
+    pointer_diff j = 0;
+    pointer_diff k = 0;
+    while (i < n_a and j < n_b) {
+        auto x = a[i];
+        auto y = b[j];
+        dst[k] = min(x, y);
+        i = i + (x <= y);
+        j = j + (y <= x);
+        increment(k);
+    }
+    while (i < n_a) dst[k++] = a[i++];
+    while (j < n_b) dst[k++] = b[j++];
+    return k;
+}
+
+inline auto
+subtract_arrays(Pointer_type<N<16> const> a, pointer_diff n_a, Pointer_type<N<16> const> b, pointer_diff n_b, Pointer_type<N<16>> dst) -> pointer_diff
+// Stores the values of the increasing array a not in the increasing array b
+// in dst and returns their number
+{
+    pointer_diff i = 0;
+    pointer_diff j = 0;
+    pointer_diff k = 0;
+    while (i < n_a and j < n_b) {
+        auto x = a[i];
+        auto y = b[j];
+        // The value is stored unconditionally and kept only if it is not in b
+        dst[k] = x;
+        k = k + (x < y);
+        i = i + (x <= y);
+        j = j + (y <= x);
+    }
+    while (i < n_a) dst[k++] = a[i++];
+    return k;
+}
+
+enum struct roaring_operation
+{
+    union_, intersection, difference
+};
+
+template <Invocable auto alloc>
+auto
+roaring_combine_words(roaring_container<alloc> const& x, roaring_container<alloc> const& y, roaring_operation op) -> roaring_container<alloc>
+// Combines the bitmaps of x and y a word at a time, in loops that vectorize
+{
+    auto w = roaring_words(x);
+    auto v = roaring_words(y);
+    auto p = first(w);
+    auto q = first(v);
+    switch (op) {
+        case roaring_operation::union_:
+            for (pointer_diff i = 0; i < roaring_bitmap_words; ++i) p[i] = p[i] | q[i];
+            break;
+        case roaring_operation::intersection:
+            for (pointer_diff i = 0; i < roaring_bitmap_words; ++i) p[i] = p[i] & q[i];
+            break;
+        case roaring_operation::difference:
+            for (pointer_diff i = 0; i < roaring_bitmap_words; ++i) p[i] = p[i] & ~q[i];
+            break;
+    }
+    auto n = popcount_words(p, roaring_bitmap_words);
+    return roaring_from_words(mv(w), n);
+}
+
+template <Invocable auto alloc>
+auto
+roaring_combine(roaring_container<alloc> const& x, roaring_container<alloc> const& y, roaring_operation op) -> roaring_container<alloc>
+// Returns the container of the union, intersection or difference of x and y
+{
+    if (x.kind == roaring_kind::run) return roaring_combine(roaring_expand(x), y, op);
+    if (y.kind == roaring_kind::run) return roaring_combine(x, roaring_expand(y), op);
+    if (x.kind == roaring_kind::array and y.kind == roaring_kind::array) {
+        if (op == roaring_operation::union_ and roaring_array_limit < x.cardinality + y.cardinality) {
+            return roaring_combine_words(x, y, op);
+        }
+        N<16> buffer[roaring_array_limit * 2 + 8];
+        auto a = first(x.values);
+        auto b = first(y.values);
+        pointer_diff n = 0;
+        switch (op) {
+            case roaring_operation::union_: n = unite_arrays(a, x.cardinality, b, y.cardinality, buffer); break;
+            case roaring_operation::intersection: n = intersect_arrays(a, x.cardinality, b, y.cardinality, buffer); break;
+            case roaring_operation::difference: n = subtract_arrays(a, x.cardinality, b, y.cardinality, buffer); break;
+        }
+        roaring_container<alloc> r;
+        r.cardinality = n;
+        r.values = roaring_array<alloc>(buffer, n);
+        return r;
+    }
+    if (op != roaring_operation::union_ and x.kind == roaring_kind::array) {
+        // Each value of the array is kept if its bit in the other is set, for
+        // an intersection, or clear, for a difference
+        auto w = roaring_words(y);
+        auto p = first(w);
+        auto a = first(x.values);
+        auto keep = op == roaring_operation::intersection ? N<64>{1} : N<64>{0};
+        N<16> buffer[roaring_array_limit];
+        pointer_diff n = 0;
+        for (pointer_diff i = 0; i < x.cardinality; ++i) {
+            buffer[n] = a[i];
+            n = n + static_cast<pointer_diff>(((p[a[i] / 64] >> (a[i] % 64)) & 1) == keep);
+        }
+        roaring_container<alloc> r;
+        r.cardinality = n;
+        r.values = roaring_array<alloc>(buffer, n);
+        return r;
+    }
+    if (op == roaring_operation::intersection and y.kind == roaring_kind::array) return roaring_combine(y, x, op);
+    return roaring_combine_words(x, y, op);
+}
+
+template <Invocable auto alloc>
+auto
+roaring_merge(roaring_bitmap<alloc> const& x, roaring_bitmap<alloc> const& y, roaring_operation op) -> roaring_bitmap<alloc>
+// Combines the containers with the same key, keeping the nonempty ones, and
+// copies the containers of x, or for a union also of y, with keys only there
+{
+    roaring_bitmap<alloc> z;
+    pointer_diff i = 0;
+    pointer_diff j = 0;
+    auto n_x = size(x.keys);
+    auto n_y = size(y.keys);
+    auto append = [&z](N<16> key, roaring_container<alloc> c){
+        if (is_zero(c.cardinality)) return;
+        push(z.keys, key);
+        push(z.containers, mv(c));
+    };
+    while (i < n_x and j < n_y) {
+        if (x.keys[i] < y.keys[j]) {
+            if (op != roaring_operation::intersection) append(x.keys[i], x.containers[i]);
+            increment(i);
+        } else if (y.keys[j] < x.keys[i]) {
+            if (op == roaring_operation::union_) append(y.keys[j], y.containers[j]);
+            increment(j);
+        } else {
+            append(x.keys[i], roaring_combine(x.containers[i], y.containers[j], op));
+            increment(i);
+            increment(j);
+        }
+    }
+    if (op != roaring_operation::intersection) {
+        for (; i < n_x; ++i) append(x.keys[i], x.containers[i]);
+    }
+    if (op == roaring_operation::union_) {
+        for (; j < n_y; ++j) append(y.keys[j], y.containers[j]);
+    }
+    return z;
+}
+
+template <Invocable auto alloc>
+auto
+set_union(roaring_bitmap<alloc> const& x, roaring_bitmap<alloc> const& y) -> roaring_bitmap<alloc>
+{
+    return roaring_merge(x, y, roaring_operation::union_);
+}
+
+template <Invocable auto alloc>
+auto
+set_intersection(roaring_bitmap<alloc> const& x, roaring_bitmap<alloc> const& y) -> roaring_bitmap<alloc>
+{
+    return roaring_merge(x, y, roaring_operation::intersection);
+}
+
+template <Invocable auto alloc>
+auto
+set_difference(roaring_bitmap<alloc> const& x, roaring_bitmap<alloc> const& y) -> roaring_bitmap<alloc>
+{
+    return roaring_merge(x, y, roaring_operation::difference);
+}
+
+// The serialized form of a roaring_bitmap starts with the number of
+// containers as 32 bits, followed by a descriptor of 16 bytes for each of
+// them: its key and kind in 16 bits each, and its cardinality, its number of
+// 16 or 64-bit elements, and the byte offset of these elements from the start
+// in 32 bits each. The elements follow, each container at an offset that is a
+// multiple of 8. A roaring_view answers queries on it in place
+
+inline constexpr pointer_diff roaring_header_size = 8;
+
+inline constexpr pointer_diff roaring_descriptor_size = 16;
+
+template <Trivially_copyable T>
+auto
+roaring_load(Pointer_type<byte const> p, pointer_diff i) -> T
+// Returns the T at offset i from p, which need not be aligned
+{
+    T x;
+    copy_bytes(p + i, static_cast<pointer_diff>(sizeof(T)), pointer_to(x));
+    return x;
+}
+
+template <Trivially_copyable T>
+void
+roaring_store(Pointer_type<byte> p, pointer_diff i, T const& x)
+{
+    copy_bytes(pointer_to(x), static_cast<pointer_diff>(sizeof(T)), p + i);
+}
+
+template <Invocable auto alloc>
+auto
+roaring_elements(roaring_container<alloc> const& x) -> pointer_diff
+{
+    return x.kind == roaring_kind::bitmap ? roaring_bitmap_words : size(x.values);
+}
+
+inline auto
+roaring_element_size(roaring_kind kind) -> pointer_diff
+{
+    return kind == roaring_kind::bitmap ? 8 : 2;
+}
+
+template <Invocable auto alloc>
+auto
+serialized_size(roaring_bitmap<alloc> const& x) -> pointer_diff
+// Returns the number of bytes of the serialized form of x
+{
+    auto n = roaring_header_size + size(x.keys) * roaring_descriptor_size;
+    for (pointer_diff i = 0; i < size(x.containers); ++i) {
+        auto const& c = x.containers[i];
+        n = (n + 7) / 8 * 8 + roaring_elements(c) * roaring_element_size(c.kind);
+    }
+    return n;
+}
+
+template <Invocable auto alloc>
+auto
+serialize(roaring_bitmap<alloc> const& x, Pointer_type<byte> dst) -> Pointer_type<byte>
+//[[expects: dst has room for serialized_size(x) bytes]]
+// Writes the serialized form of x to dst and returns its limit
+{
+    auto n_c = size(x.keys);
+    roaring_store(dst, 0, static_cast<N<32>>(n_c));
+    roaring_store(dst, 4, N<32>{0});
+    auto n = roaring_header_size + n_c * roaring_descriptor_size;
+    for (pointer_diff i = 0; i < n_c; ++i) {
+        auto const& c = x.containers[i];
+        n = (n + 7) / 8 * 8;
+        auto d = roaring_header_size + i * roaring_descriptor_size;
+        roaring_store(dst, d, x.keys[i]);
+        roaring_store(dst, d + 2, static_cast<N<16>>(c.kind));
+        roaring_store(dst, d + 4, static_cast<N<32>>(c.cardinality));
+        roaring_store(dst, d + 8, static_cast<N<32>>(roaring_elements(c)));
+        roaring_store(dst, d + 12, static_cast<N<32>>(n));
+        auto bytes = roaring_elements(c) * roaring_element_size(c.kind);
+        if (c.kind == roaring_kind::bitmap) copy_bytes(first(c.words), bytes, dst + n);
+        else if (!is_zero(bytes)) copy_bytes(first(c.values), bytes, dst + n);
+        n = n + bytes;
+    }
+    return dst + n;
+}
+
+struct roaring_view
+{
+    Pointer_type<byte const> p{};
+};
+
+inline auto
+containers(roaring_view const& x) -> pointer_diff
+{
+    return static_cast<pointer_diff>(roaring_load<N<32>>(x.p, 0));
+}
+
+inline auto
+size(roaring_view const& x) -> pointer_diff
+// Returns the number of values of x
+{
+    pointer_diff n = 0;
+    for (pointer_diff i = 0; i < containers(x); ++i) {
+        n = n + static_cast<pointer_diff>(roaring_load<N<32>>(x.p, roaring_header_size + i * roaring_descriptor_size + 4));
+    }
+    return n;
+}
+
+inline auto
+contains(roaring_view const& x, N<32> v) -> bool
+// Decides membership by binary search on the descriptors and on the values
+// of the container, reading only those
+{
+    auto key = static_cast<N<16>>(v >> 16);
+    auto low = static_cast<N<16>>(v);
+    auto load_key = [&x](pointer_diff i){ return roaring_load<N<16>>(x.p, roaring_header_size + i * roaring_descriptor_size); };
+    pointer_diff i = 0;
+    auto n = containers(x);
+    while (!is_zero(n)) {
+        auto h = half(n);
+        if (load_key(i + h) < key) {
+            i = i + h + 1;
+            n = n - h - 1;
+        } else {
+            n = h;
+        }
+    }
+    if (i == containers(x) or load_key(i) != key) return false;
+    auto d = roaring_header_size + i * roaring_descriptor_size;
+    auto kind = static_cast<roaring_kind>(roaring_load<N<16>>(x.p, d + 2));
+    auto m = static_cast<pointer_diff>(roaring_load<N<32>>(x.p, d + 8));
+    auto o = static_cast<pointer_diff>(roaring_load<N<32>>(x.p, d + 12));
+    if (kind == roaring_kind::bitmap) return ((roaring_load<N<64>>(x.p, o + low / 64 * 8) >> (low % 64)) & 1) != 0;
+    // The last element, or run start, that is not greater than low
+    auto stride = kind == roaring_kind::run ? 2 : 1;
+    pointer_diff j = 0;
+    n = m / stride;
+    while (!is_zero(n)) {
+        auto h = half(n);
+        if (roaring_load<N<16>>(x.p, o + (j + h) * stride * 2) <= low) {
+            j = j + h + 1;
+            n = n - h - 1;
+        } else {
+            n = h;
+        }
+    }
+    if (is_zero(j)) return false;
+    auto e = predecessor(j) * stride * 2;
+    auto start = roaring_load<N<16>>(x.p, o + e);
+    if (kind == roaring_kind::array) return start == low;
+    return low - start <= roaring_load<N<16>>(x.p, o + e + 2);
+}
+
+template <Invocable auto alloc = array_allocator<N<64>>>
+auto
+to_roaring(roaring_view const& x) -> roaring_bitmap<alloc>
+// Returns a copy of the roaring_bitmap that x was serialized from
+{
+    roaring_bitmap<alloc> z;
+    for (pointer_diff i = 0; i < containers(x); ++i) {
+        auto d = roaring_header_size + i * roaring_descriptor_size;
+        roaring_container<alloc> c;
+        c.kind = static_cast<roaring_kind>(roaring_load<N<16>>(x.p, d + 2));
+        c.cardinality = static_cast<pointer_diff>(roaring_load<N<32>>(x.p, d + 4));
+        auto m = static_cast<pointer_diff>(roaring_load<N<32>>(x.p, d + 8));
+        auto o = static_cast<pointer_diff>(roaring_load<N<32>>(x.p, d + 12));
+        if (c.kind == roaring_kind::bitmap) {
+            c.words = array_single_ended<N<64>, alloc>(m, N<64>{0});
+            copy_bytes(x.p + o, m * 8, first(c.words));
+        } else if (!is_zero(m)) {
+            c.values = array_single_ended<N<16>, alloc>(m, N<16>{0});
+            copy_bytes(x.p + o, m * 2, first(c.values));
+        }
+        push(z.keys, roaring_load<N<16>>(x.p, d));
+        push(z.containers, mv(c));
+    }
+    return z;
+}
+
+}
@@ -0,0 +1,332 @@
+#pragma once
+
+#include "algebra.h"
+#include "copy.h"
+#include "reduce.h"
+
+namespace elements {
+
+template <Cursor S, Limit<S> L, Cursor D, Operation<Value_type<S>, Value_type<S>> Op>
+requires Indirectly_copyable<S, D>
+constexpr auto
+scan_inclusive(S src, L lim, D dst, Op op, Value_type<S> x) -> D
+//[[expects axiom: not_overlapped_forward(src, lim, dst, dst + (lim - src))]]
+//[[expects axiom: partially_associative(op)]]
+// Stores op(x, src[0]), op(op(x, src[0]), src[1]), ... to dst
+{
+    while (precedes(src, lim)) {
+        x = op(x, load(src));
+        store(dst, x);
+        increment(src);
+        increment(dst);
+    }
+    return dst;
+}
+
+template <Cursor S, Limit<S> L, Cursor D, Operation<Value_type<S>, Value_type<S>> Op>
+requires Indirectly_copyable<S, D>
+constexpr auto
+scan_inclusive(S src, L lim, D dst, Op op) -> D
+//[[expects axiom: not_overlapped_forward(src, lim, dst, dst + (lim - src))]]
+//[[expects axiom: partially_associative(op)]]
+// Stores src[0], op(src[0], src[1]), ... to dst
+{
+    if (!precedes(src, lim)) return dst;
+    auto x = load(src);
+    copy_step(src, dst);
+    return scan_inclusive(mv(src), lim, mv(dst), op, mv(x));
+}
+
+template <Cursor S, Limit<S> L, Cursor D, Operation<Value_type<S>, Value_type<S>> Op>
+requires Indirectly_copyable<S, D>
+constexpr auto
+scan_exclusive(S src, L lim, D dst, Op op, Value_type<S> zero) -> D
+//[[expects axiom: not_overlapped_forward(src, lim, dst, dst + (lim - src))]]
+//[[expects axiom: partially_associative(op)]]
+// Stores zero, op(zero, src[0]), op(op(zero, src[0]), src[1]), ... to dst,
+// one for each element of src
+{
+    while (precedes(src, lim)) {
+        auto y = load(src);
+        store(dst, zero);
+        zero = op(zero, y);
+        increment(src);
+        increment(dst);
+    }
+    return dst;
+}
+
+#if defined(__AVX512F__) or defined(__AVX2__)
+
+template <typename T>
+inline constexpr bool scan_vectorizable = (Integral<T> or Floating_point<T>) and (sizeof(T) == 4 or sizeof(T) == 8);
+
+#if defined(__AVX512F__)
+
+using scan_register = __m512i;
+
+inline constexpr pointer_diff scan_register_size = 64;
+
+template <typename T>
+inline constexpr pointer_diff scan_register_lanes = scan_register_size / static_cast<pointer_diff>(sizeof(T));
+
+template <typename T>
+auto
+scan_add_lanes(scan_register x, scan_register y) -> scan_register
+{
+    if constexpr (Same_as<T, float>) return _mm512_castps_si512(_mm512_add_ps(_mm512_castsi512_ps(x), _mm512_castsi512_ps(y)));
+    else if constexpr (Same_as<T, double>) return _mm512_castpd_si512(_mm512_add_pd(_mm512_castsi512_pd(x), _mm512_castsi512_pd(y)));
+    else if constexpr (sizeof(T) == 4) return _mm512_add_epi32(x, y);
+    else return _mm512_add_epi64(x, y);
+}
+
+template <typename T>
+auto
+scan_shift_lanes(scan_register x, pointer_diff k) -> scan_register
+// Moves the lanes of x k lanes up, filling with zeros; the zero-masked forms
+// with every lane selected avoid the undefined pass-through operand that GCC
+// warns about
+{
+    auto zero = _mm512_setzero_si512();
+    if constexpr (sizeof(T) == 4) {
+        switch (k) {
+            case 1: return _mm512_maskz_alignr_epi32(0xffff, x, zero, 15);
+            case 2: return _mm512_maskz_alignr_epi32(0xffff, x, zero, 14);
+            case 4: return _mm512_maskz_alignr_epi32(0xffff, x, zero, 12);
+            default: return _mm512_maskz_alignr_epi32(0xffff, x, zero, 8);
+        }
+    } else {
+        switch (k) {
+            case 1: return _mm512_maskz_alignr_epi64(0xff, x, zero, 7);
+            case 2: return _mm512_maskz_alignr_epi64(0xff, x, zero, 6);
+            default: return _mm512_maskz_alignr_epi64(0xff, x, zero, 4);
+        }
+    }
+}
+
+template <typename T>
+auto
+scan_broadcast_last(scan_register x) -> scan_register
+{
+    if constexpr (sizeof(T) == 4) return _mm512_maskz_shuffle_epi32(0xffff, _mm512_maskz_shuffle_i32x4(0xffff, x, x, 0xff), _MM_PERM_DDDD);
+    else {
+        x = _mm512_maskz_shuffle_i64x2(0xff, x, x, 0xff);
+        return _mm512_maskz_unpackhi_epi64(0xff, x, x);
+    }
+}
+
+template <typename T>
+auto
+scan_lanes(scan_register x) -> scan_register
+// Returns the inclusive sums of the lanes of x, in a logarithmic number of
+// shifts and additions
+{
+    constexpr auto v = scan_register_lanes<T>;
+    for (pointer_diff k = 1; k < v; k = twice(k)) x = scan_add_lanes<T>(x, scan_shift_lanes<T>(x, k));
+    return x;
+}
+
+#else
+
+using scan_register = __m256i;
+
+inline constexpr pointer_diff scan_register_size = 32;
+
+template <typename T>
+inline constexpr pointer_diff scan_register_lanes = scan_register_size / static_cast<pointer_diff>(sizeof(T));
+
+template <typename T>
+auto
+scan_add_lanes(scan_register x, scan_register y) -> scan_register
+{
+    if constexpr (Same_as<T, float>) return _mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(x), _mm256_castsi256_ps(y)));
+    else if constexpr (Same_as<T, double>) return _mm256_castpd_si256(_mm256_add_pd(_mm256_castsi256_pd(x), _mm256_castsi256_pd(y)));
+    else if constexpr (sizeof(T) == 4) return _mm256_add_epi32(x, y);
+    else return _mm256_add_epi64(x, y);
+}
+
+template <typename T>
+auto
+scan_shift_lanes(scan_register x, pointer_diff k) -> scan_register
+// Moves the lanes of x k lanes up, filling with zeros
+{
+    if constexpr (sizeof(T) == 4) {
+        switch (k) {
+            case 1: return _mm256_blend_epi32(_mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6)), _mm256_setzero_si256(), 0x01);
+            case 2: return _mm256_blend_epi32(_mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(0, 0, 0, 1, 2, 3, 4, 5)), _mm256_setzero_si256(), 0x03);
+            default: return _mm256_permute2x128_si256(x, x, 0x08);
+        }
+    } else {
+        switch (k) {
+            case 1: return _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x90), _mm256_setzero_si256(), 0x03);
+            default: return _mm256_permute2x128_si256(x, x, 0x08);
+        }
+    }
+}
+
+template <typename T>
+auto
+scan_broadcast_last(scan_register x) -> scan_register
+{
+    if constexpr (sizeof(T) == 4) return _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7));
+    else return _mm256_permute4x64_epi64(x, 0xff);
+}
+
+template <typename T>
+auto
+scan_lanes(scan_register x) -> scan_register
+// Returns the inclusive sums of the lanes of x, in a logarithmic number of
+// shifts and additions
+{
+    constexpr auto v = scan_register_lanes<T>;
+    for (pointer_diff k = 1; k < v; k = twice(k)) x = scan_add_lanes<T>(x, scan_shift_lanes<T>(x, k));
+    return x;
+}
+
+#endif
+
+template <typename T>
+auto
+scan_add(Pointer_type<T const> src, Pointer_type<T const> lim, Pointer_type<T> dst, T x, bool exclusive) -> Pointer_type<T>
+// Stores the inclusive or exclusive sums of src, starting from x, to dst a
+// register at a time: the register is scanned in place, and the running sum
+// of the previous registers, kept broadcast to all lanes, is added to it
+{
+    constexpr auto v = scan_register_lanes<T>;
+    T lanes[v];
+    for (pointer_diff i = 0; i < v; ++i) lanes[i] = x;
+    scan_register carry;
+    copy_bytes(lanes, scan_register_size, pointer_to(carry));
+    while (v <= lim - src) {
+        scan_register y;
+        copy_bytes(src, scan_register_size, pointer_to(y));
+        auto s = scan_lanes<T>(y);
+        auto z = scan_add_lanes<T>(exclusive ? scan_shift_lanes<T>(s, 1) : s, carry);
+        copy_bytes(pointer_to(z), scan_register_size, dst);
+        carry = scan_add_lanes<T>(carry, scan_broadcast_last<T>(s));
+        src = src + v;
+        dst = dst + v;
+    }
+    copy_bytes(pointer_to(carry), static_cast<pointer_diff>(sizeof(T)), pointer_to(x));
+    while (src != lim) {
+        auto y = *src;
+        if (!exclusive) x = x + y;
+        *dst = x;
+        if (exclusive) x = x + y;
+        ++src;
+        ++dst;
+    }
+    return dst;
+}
+
+#endif
+
+template <Arithmetic T, Arithmetic U, Operation<U, U> Op>
+requires Same_as<Remove_const<T>, U> and (Same_as<Op, add_op<>> or Same_as<Op, add_op<U>>)
+constexpr auto
+scan_inclusive(Pointer_type<T> src, Pointer_type<T> lim, Pointer_type<U> dst, Op op, U x) -> Pointer_type<U>
+//[[expects axiom: not_overlapped_forward(src, lim, dst, dst + (lim - src))]]
+// Sums 32 and 64-bit numbers a register at a time with AVX2 or AVX-512,
+// which associates the additions of floating point numbers differently
+{
+#if defined(__AVX512F__) or defined(__AVX2__)
+    if constexpr (scan_vectorizable<U>) {
+        if (!is_constant_evaluated()) return scan_add<U>(src, lim, dst, x, false);
+    }
+#endif
+    while (precedes(src, lim)) {
+        x = op(x, load(src));
+        store(dst, x);
+        increment(src);
+        increment(dst);
+    }
+    return dst;
+}
+
+template <Arithmetic T, Arithmetic U, Operation<U, U> Op>
+requires Same_as<Remove_const<T>, U> and (Same_as<Op, add_op<>> or Same_as<Op, add_op<U>>)
+constexpr auto
+scan_inclusive(Pointer_type<T> src, Pointer_type<T> lim, Pointer_type<U> dst, Op op) -> Pointer_type<U>
+//[[expects axiom: not_overlapped_forward(src, lim, dst, dst + (lim - src))]]
+{
+    return scan_inclusive(src, lim, dst, op, U{0});
+}
+
+template <Arithmetic T, Arithmetic U, Operation<U, U> Op>
+requires Same_as<Remove_const<T>, U> and (Same_as<Op, add_op<>> or Same_as<Op, add_op<U>>)
+constexpr auto
+scan_exclusive(Pointer_type<T> src, Pointer_type<T> lim, Pointer_type<U> dst, Op op, U zero) -> Pointer_type<U>
+//[[expects axiom: not_overlapped_forward(src, lim, dst, dst + (lim - src))]]
+{
+#if defined(__AVX512F__) or defined(__AVX2__)
+    if constexpr (scan_vectorizable<U>) {
+        if (!is_constant_evaluated()) return scan_add<U>(src, lim, dst, zero, true);
+    }
+#endif
+    while (precedes(src, lim)) {
+        auto y = load(src);
+        store(dst, zero);
+        zero = op(zero, y);
+        increment(src);
+        increment(dst);
+    }
+    return dst;
+}
+
+inline constexpr pointer_diff scan_parallel_grain = 65536;
+
+template <Indexed_cursor S, Indexed_cursor D, Operation<Value_type<S>, Value_type<S>> Op>
+requires Indirectly_copyable<S, D>
+auto
+scan_parallel(S src, S lim, D dst, Op op, Value_type<S> const& zero, bool exclusive, pointer_diff workers) -> D
+// Each worker reduces a contiguous share of src, the reductions are scanned
+// into the sum of the shares before each, and each worker scans its share
+// from its sum, so that op is applied about twice per element however many
+// workers there are
+{
+    using T = Value_type<S>;
+    auto n = lim - src;
+    auto w = parallel_workers(n, scan_parallel_grain, workers);
+    if (is_one(w)) {
+        if (exclusive) return scan_exclusive(src, lim, dst, op, zero);
+        return scan_inclusive(src, lim, dst, op, zero);
+    }
+    array_single_ended<T> sums(w, zero);
+    for_each_worker(w, [&sums, src, n, w, op](pointer_diff i){
+        if (i == predecessor(w)) return;
+        sums[successor(i)] = reduce_nonempty(src + n * i / w, src + n * successor(i) / w, op);
+    });
+    scan_inclusive(first(sums), limit(sums), first(sums), op);
+    for_each_worker(w, [&sums, src, dst, n, w, op, exclusive](pointer_diff i){
+        auto share_src = src + n * i / w;
+        auto share_lim = src + n * successor(i) / w;
+        auto share_dst = dst + n * i / w;
+        if (exclusive) scan_exclusive(share_src, share_lim, share_dst, op, sums[i]);
+        else scan_inclusive(share_src, share_lim, share_dst, op, sums[i]);
+    });
+    return dst + n;
+}
+
+template <Indexed_cursor S, Indexed_cursor D, Operation<Value_type<S>, Value_type<S>> Op>
+requires Indirectly_copyable<S, D>
+auto
+scan_inclusive_parallel(S src, S lim, D dst, Op op, Value_type<S> const& zero, pointer_diff workers = hardware_concurrency()) -> D
+//[[expects axiom: not_overlapped_forward(src, lim, dst, dst + (lim - src))]]
+//[[expects axiom: partially_associative(op)]]
+//[[expects: zero is an identity of op]]
+{
+    return scan_parallel(mv(src), mv(lim), mv(dst), op, zero, false, workers);
+}
+
+template <Indexed_cursor S, Indexed_cursor D, Operation<Value_type<S>, Value_type<S>> Op>
+requires Indirectly_copyable<S, D>
+auto
+scan_exclusive_parallel(S src, S lim, D dst, Op op, Value_type<S> const& zero, pointer_diff workers = hardware_concurrency()) -> D
+//[[expects axiom: not_overlapped_forward(src, lim, dst, dst + (lim - src))]]
+//[[expects axiom: partially_associative(op)]]
+//[[expects: zero is an identity of op]]
+{
+    return scan_parallel(mv(src), mv(lim), mv(dst), op, zero, true, workers);
+}
+
+}
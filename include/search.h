@@ -22,19 +22,20 @@ requires Loadable<C>
 constexpr auto
 search_if(C cur, C lim, P pred) -> C
 {
-    auto index_cur_ = index_cur(cur);
-    auto index_lim_ = index_cur(lim);
-    if (!precedes(index_cur_, index_lim_)) {
-        return {index_cur_, search_if(segment_cur(cur), segment_cur(lim), pred)};
+    auto index_cur = index_cursor(cur);
+    auto index_lim = index_cursor(lim);
+    if (!precedes(index_cur, index_lim)) {
+        return {index_cur, search_if(segment_cursor(cur), segment_cursor(lim), pred)};
     } else {
-        auto segment_cur_ = search_if(segment_cur(cur), limit(load(index_cur_)), pred);
-        if (!precedes(segment_cur_, limit(load(index_cur_)))) return {index_cur_, segment_cur_};
-        do {
-            increment(index_cur_);
-            segment_cur_ = search_if(first(load(index_cur_)), limit(load(index_cur_)), pred);
-            if (!precedes(segment_cur_, limit(load(index_cur_)))) return {index_cur_, segment_cur_};
-        } while (precedes(index_cur_, index_lim_));
-        return {index_cur_, segment_cur_};
+        auto segment_cur = search_if(segment_cursor(cur), limit(load(index_cur)), pred);
+        if (precedes(segment_cur, limit(load(index_cur)))) return {index_cur, segment_cur};
+        increment(index_cur);
+        while (precedes(index_cur, index_lim)) {
+            segment_cur = search_if(first(load(index_cur)), limit(load(index_cur)), pred);
+            if (precedes(segment_cur, limit(load(index_cur)))) return {index_cur, segment_cur};
+            increment(index_cur);
+        }
+        return {index_cur, search_if(first(load(index_cur)), segment_cursor(lim), pred)};
     }
 }
 
@@ -0,0 +1,605 @@
+#pragma once
+
+#include "parallel.h"
+#include "search_binary.h"
+#include "swap.h"
+#include "vector_space.h"
+
+namespace elements {
+
+template <typename T, typename I = pointer_diff>
+struct sparse_vector_engine
+{
+    // The nonzero elements in increasing order of their indices; a narrower
+    // index type I lowers the memory footprint
+    array_single_ended<I> indices;
+    array_single_ended<T> values;
+    pointer_diff n{};
+
+    constexpr
+    sparse_vector_engine() = default;
+
+    explicit constexpr
+    sparse_vector_engine(pointer_diff size)
+        : n{size}
+    {}
+
+    constexpr auto
+    operator()(pointer_diff i) const -> T const&
+    {
+        auto cur = search_binary_lower(first(indices), limit(indices), static_cast<I>(i));
+        if (cur == limit(indices) or load(cur) != static_cast<I>(i)) return Zero<T>;
+        return values[cur - first(indices)];
+    }
+};
+
+template <typename T, typename I>
+struct value_type_t<sparse_vector_engine<T, I>>
+{
+    using type = Remove_const<T>;
+};
+
+template <typename T, typename I>
+struct scalar_type_t<sparse_vector_engine<T, I>>
+{
+    using type = T;
+};
+
+template <typename T, typename I>
+struct scalar_type_t<sparse_vector_engine<T, I> const>
+{
+    using type = T const;
+};
+
+template <typename T, typename I>
+struct size_type_t<sparse_vector_engine<T, I>>
+{
+    using type = pointer_diff;
+};
+
+template <typename T, typename I>
+constexpr auto
+operator==(sparse_vector_engine<T, I> const& x, sparse_vector_engine<T, I> const& y) -> bool
+{
+    return x.n == y.n and x.indices == y.indices and x.values == y.values;
+}
+
+template <typename T, typename I>
+constexpr auto
+size(sparse_vector_engine<T, I> const& x) -> pointer_diff
+{
+    return x.n;
+}
+
+template <typename T, typename I>
+constexpr auto
+nonzeros(sparse_vector_engine<T, I> const& x) -> pointer_diff
+{
+    return size(x.values);
+}
+
+template <typename T, typename I>
+constexpr void
+push(sparse_vector_engine<T, I>& x, pointer_diff i, T const& value)
+//[[expects: i < size(x) and i is greater than the indices of x]]
+{
+    push(x.indices, static_cast<I>(i));
+    push(x.values, value);
+}
+
+template <typename T, typename I = pointer_diff>
+using sparse_vector = vector<sparse_vector_engine<T, I>, matrix_operation_t>;
+
+template <typename T, typename I, typename OT>
+constexpr auto
+nonzeros(vector<sparse_vector_engine<T, I>, OT> const& x) -> pointer_diff
+{
+    return nonzeros(x.engine);
+}
+
+template <typename T, typename I, typename OT>
+constexpr void
+push(vector<sparse_vector_engine<T, I>, OT>& x, pointer_diff i, T const& value)
+//[[expects: i < size(x) and i is greater than the indices of x]]
+{
+    push(x.engine, i, value);
+}
+
+template <typename T0, typename I0, typename OT0, typename ET1, typename OT1>
+constexpr auto
+inner_product(vector<sparse_vector_engine<T0, I0>, OT0> const& x, vector<ET1, OT1> const& y)
+//[[expects: size(x) == size(y)]]
+// Visits only the nonzeros of x
+{
+    using S = Remove_const<decltype(declval<T0>() * y(0))>;
+    auto z = Zero<S>;
+    auto index = first(x.engine.indices);
+    auto value = first(x.engine.values);
+    for (pointer_diff k = 0; k < nonzeros(x); ++k) z = z + value[k] * y(index[k]);
+    return z;
+}
+
+template <typename ET0, typename OT0, typename T1, typename I1, typename OT1>
+constexpr auto
+inner_product(vector<ET0, OT0> const& x, vector<sparse_vector_engine<T1, I1>, OT1> const& y)
+//[[expects: size(x) == size(y)]]
+{
+    using S = Remove_const<decltype(x(0) * declval<T1>())>;
+    auto z = Zero<S>;
+    auto index = first(y.engine.indices);
+    auto value = first(y.engine.values);
+    for (pointer_diff k = 0; k < nonzeros(y); ++k) z = z + x(index[k]) * value[k];
+    return z;
+}
+
+template <typename T0, typename I0, typename OT0, typename T1, typename I1, typename OT1>
+constexpr auto
+inner_product(vector<sparse_vector_engine<T0, I0>, OT0> const& x, vector<sparse_vector_engine<T1, I1>, OT1> const& y)
+//[[expects: size(x) == size(y)]]
+// Merges the indices of the nonzeros of x and y
+{
+    using S = Remove_const<decltype(declval<T0>() * declval<T1>())>;
+    auto z = Zero<S>;
+    auto i = Zero<pointer_diff>;
+    auto j = Zero<pointer_diff>;
+    while (i < nonzeros(x) and j < nonzeros(y)) {
+        auto p = static_cast<pointer_diff>(x.engine.indices[i]);
+        auto q = static_cast<pointer_diff>(y.engine.indices[j]);
+        if (p < q) {
+            increment(i);
+        } else if (q < p) {
+            increment(j);
+        } else {
+            z = z + x.engine.values[i] * y.engine.values[j];
+            increment(i);
+            increment(j);
+        }
+    }
+    return z;
+}
+
+template <typename I = pointer_diff, typename ET, typename OT>
+auto
+to_sparse(vector<ET, OT> const& x) -> sparse_vector<Value_type<ET>, I>
+{
+    using T = Value_type<ET>;
+    sparse_vector<T, I> y(size(x));
+    for (pointer_diff i = 0; i < size(x); ++i) {
+        if (x(i) != Zero<T>) push(y, i, x(i));
+    }
+    return y;
+}
+
+template <typename T, typename I, typename OT>
+auto
+to_dense(vector<sparse_vector_engine<T, I>, OT> const& x) -> dynamic_vector<T>
+{
+    dynamic_vector<T> y(size(x), Zero<T>);
+    for (pointer_diff k = 0; k < nonzeros(x); ++k) {
+        y(static_cast<pointer_diff>(x.engine.indices[k])) = x.engine.values[k];
+    }
+    return y;
+}
+
+template <typename T, typename I = pointer_diff>
+struct coo_matrix_engine
+{
+    // The nonzero elements as (row, column, value) triplets in any order, where
+    // the values of repeated positions add
+    array_single_ended<I> row_indices;
+    array_single_ended<I> column_indices;
+    array_single_ended<T> values;
+    pointer_diff row_count{};
+    pointer_diff column_count{};
+
+    constexpr
+    coo_matrix_engine() = default;
+
+    constexpr
+    coo_matrix_engine(pointer_diff rows, pointer_diff columns)
+        : row_count{rows}
+        , column_count{columns}
+    {}
+};
+
+template <typename T, typename I>
+struct value_type_t<coo_matrix_engine<T, I>>
+{
+    using type = Remove_const<T>;
+};
+
+template <typename T, typename I>
+struct scalar_type_t<coo_matrix_engine<T, I>>
+{
+    using type = T;
+};
+
+template <typename T, typename I>
+struct scalar_type_t<coo_matrix_engine<T, I> const>
+{
+    using type = T const;
+};
+
+template <typename T, typename I>
+constexpr auto
+rows(coo_matrix_engine<T, I> const& x) -> pointer_diff
+{
+    return x.row_count;
+}
+
+template <typename T, typename I>
+constexpr auto
+columns(coo_matrix_engine<T, I> const& x) -> pointer_diff
+{
+    return x.column_count;
+}
+
+template <typename T, typename I>
+constexpr auto
+nonzeros(coo_matrix_engine<T, I> const& x) -> pointer_diff
+{
+    return size(x.values);
+}
+
+template <typename T, typename I>
+constexpr void
+push(coo_matrix_engine<T, I>& x, pointer_diff i, pointer_diff j, T const& value)
+//[[expects: i < rows(x) and j < columns(x)]]
+{
+    push(x.row_indices, static_cast<I>(i));
+    push(x.column_indices, static_cast<I>(j));
+    push(x.values, value);
+}
+
+template <typename T, typename I>
+void
+multiply_sparse(coo_matrix_engine<T, I> const& a, Pointer_type<T const> x, Pointer_type<T> y)
+// y += a x
+{
+    auto r = first(a.row_indices);
+    auto c = first(a.column_indices);
+    auto v = first(a.values);
+    for (pointer_diff k = 0; k < nonzeros(a); ++k) y[r[k]] = y[r[k]] + v[k] * x[c[k]];
+}
+
+template <typename I>
+auto
+counting_offsets(Pointer_type<I const> keys, pointer_diff n, pointer_diff k) -> array_single_ended<pointer_diff>
+//[[expects: each of the n keys is in [0, k)]]
+// Returns the k + 1 positions at which the elements with each key start in
+// the keys sorted, the last of which is n
+{
+    array_single_ended<pointer_diff> offsets(successor(k), Zero<pointer_diff>);
+    for (pointer_diff i = 0; i < n; ++i) increment(offsets[successor(static_cast<pointer_diff>(keys[i]))]);
+    for (pointer_diff i = 0; i < k; ++i) offsets[successor(i)] = offsets[successor(i)] + offsets[i];
+    return offsets;
+}
+
+inline constexpr pointer_diff sparse_sort_insertion_threshold = 32;
+
+template <typename I, typename T>
+void
+sift_down_by_index(Pointer_type<I> indices, Pointer_type<T> values, pointer_diff i, pointer_diff n)
+// Moves the pair at i down the heap of the first n pairs, with the greatest
+// index at the root
+{
+    auto index = indices[i];
+    auto value = values[i];
+    while (true) {
+        auto child = successor(twice(i));
+        if (!(child < n)) break;
+        if (successor(child) < n and indices[child] < indices[successor(child)]) increment(child);
+        if (!(index < indices[child])) break;
+        indices[i] = indices[child];
+        values[i] = values[child];
+        i = child;
+    }
+    indices[i] = index;
+    values[i] = value;
+}
+
+template <typename I, typename T>
+void
+sort_by_index(Pointer_type<I> indices, Pointer_type<T> values, pointer_diff n)
+// Sorts the pairs (indices[i], values[i]) by index, with insertion sort for
+// the short rows of most matrices and with heap sort for the long rows that
+// are not already sorted, so that no row takes more than O(n log n) time
+{
+    if (n < sparse_sort_insertion_threshold) {
+        for (pointer_diff i = 1; i < n; ++i) {
+            auto index = indices[i];
+            auto value = values[i];
+            auto j = i;
+            while (0 < j and index < indices[predecessor(j)]) {
+                indices[j] = indices[predecessor(j)];
+                values[j] = values[predecessor(j)];
+                decrement(j);
+            }
+            indices[j] = index;
+            values[j] = value;
+        }
+        return;
+    }
+    auto sorted = true;
+    for (pointer_diff i = 1; i < n; ++i) sorted = sorted and !(indices[i] < indices[predecessor(i)]);
+    if (sorted) return;
+    for (auto i = half(n); 0 < i; ) {
+        decrement(i);
+        sift_down_by_index(indices, values, i, n);
+    }
+    for (auto i = predecessor(n); 0 < i; decrement(i)) {
+        swap(indices[0], indices[i]);
+        swap(values[0], values[i]);
+        sift_down_by_index(indices, values, 0, i);
+    }
+}
+
+template <typename T, typename I = pointer_diff>
+struct csr_matrix_engine
+{
+    // Row i has its nonzero elements at [offsets[i], offsets[i + 1]) of
+    // column_indices and values, in increasing order of column
+    array_single_ended<pointer_diff> offsets;
+    array_single_ended<I> column_indices;
+    array_single_ended<T> values;
+    pointer_diff column_count{};
+
+    constexpr
+    csr_matrix_engine() = default;
+
+    constexpr
+    csr_matrix_engine(pointer_diff rows, pointer_diff columns)
+        : offsets(successor(rows), Zero<pointer_diff>)
+        , column_count{columns}
+    {}
+
+    explicit
+    csr_matrix_engine(coo_matrix_engine<T, I> const& x)
+        : column_indices(nonzeros(x), I{})
+        , values(nonzeros(x), Zero<T>)
+        , column_count{columns(x)}
+    {
+        // The triplets are distributed to their rows in one pass, which is
+        // sequential when they are generated row by row, and each row is
+        // sorted by column, after which the values of repeated positions are
+        // adjacent and are added
+        auto n = nonzeros(x);
+        offsets = counting_offsets(first(x.row_indices), n, rows(x));
+        auto next = offsets;
+        for (pointer_diff k = 0; k < n; ++k) {
+            auto& p = next[static_cast<pointer_diff>(x.row_indices[k])];
+            column_indices[p] = x.column_indices[k];
+            values[p] = x.values[k];
+            increment(p);
+        }
+        for (pointer_diff i = 0; i < rows(x); ++i) {
+            sort_by_index(first(column_indices) + offsets[i], first(values) + offsets[i], offsets[successor(i)] - offsets[i]);
+        }
+        auto r = Zero<pointer_diff>;
+        auto k = Zero<pointer_diff>;
+        for (pointer_diff i = 0; i < rows(x); ++i) {
+            auto l = offsets[successor(i)];
+            offsets[i] = r;
+            while (k < l) {
+                if (offsets[i] < r and column_indices[predecessor(r)] == column_indices[k]) {
+                    values[predecessor(r)] = values[predecessor(r)] + values[k];
+                } else {
+                    column_indices[r] = column_indices[k];
+                    values[r] = values[k];
+                    increment(r);
+                }
+                increment(k);
+            }
+        }
+        offsets[rows(x)] = r;
+        while (r < size(values)) {
+            pop(column_indices);
+            pop(values);
+        }
+    }
+
+    constexpr auto
+    operator()(pointer_diff i, pointer_diff j) const -> T const&
+    {
+        auto f = first(column_indices) + offsets[i];
+        auto l = first(column_indices) + offsets[successor(i)];
+        auto cur = search_binary_lower(f, l, static_cast<I>(j));
+        if (cur == l or load(cur) != static_cast<I>(j)) return Zero<T>;
+        return values[cur - first(column_indices)];
+    }
+};
+
+template <typename T, typename I>
+struct value_type_t<csr_matrix_engine<T, I>>
+{
+    using type = Remove_const<T>;
+};
+
+template <typename T, typename I>
+struct scalar_type_t<csr_matrix_engine<T, I>>
+{
+    using type = T;
+};
+
+template <typename T, typename I>
+struct scalar_type_t<csr_matrix_engine<T, I> const>
+{
+    using type = T const;
+};
+
+template <typename T, typename I>
+constexpr auto
+operator==(csr_matrix_engine<T, I> const& x, csr_matrix_engine<T, I> const& y) -> bool
+{
+    return
+        x.column_count == y.column_count and
+        x.offsets == y.offsets and
+        x.column_indices == y.column_indices and
+        x.values == y.values;
+}
+
+template <typename T, typename I>
+constexpr auto
+rows(csr_matrix_engine<T, I> const& x) -> pointer_diff
+{
+    return predecessor(size(x.offsets));
+}
+
+template <typename T, typename I>
+constexpr auto
+columns(csr_matrix_engine<T, I> const& x) -> pointer_diff
+{
+    return x.column_count;
+}
+
+template <typename T, typename I>
+constexpr auto
+nonzeros(csr_matrix_engine<T, I> const& x) -> pointer_diff
+{
+    return size(x.values);
+}
+
+template <typename T, typename I = pointer_diff>
+using sparse_matrix = matrix<csr_matrix_engine<T, I>, matrix_operation_t>;
+
+template <typename T, typename I, typename OT>
+constexpr auto
+nonzeros(matrix<csr_matrix_engine<T, I>, OT> const& x) -> pointer_diff
+{
+    return nonzeros(x.engine);
+}
+
+inline constexpr pointer_diff sparse_parallel_grain = 65536;
+
+template <typename T, typename I>
+auto
+sparse_row_of(csr_matrix_engine<T, I> const& a, pointer_diff k) -> pointer_diff
+// Returns the first row whose nonzeros start at or after position k
+{
+    return search_binary_lower(first(a.offsets), limit(a.offsets) - 1, k) - first(a.offsets);
+}
+
+template <typename T, typename I, Invocable<pointer_diff, pointer_diff> F>
+void
+for_each_sparse_rows(csr_matrix_engine<T, I> const& a, F fun, pointer_diff workers)
+// Calls fun(i0, i1) on the calling thread and on workers for disjoint row
+// ranges covering the rows of a, each with about the same number of nonzeros
+{
+    auto z = nonzeros(a);
+    auto w = parallel_workers(z, sparse_parallel_grain, workers);
+    for_each_worker(w, [&a, &fun, z, w](pointer_diff t){
+        auto i0 = sparse_row_of(a, z * t / w);
+        auto i1 = successor(t) == w ? rows(a) : sparse_row_of(a, z * successor(t) / w);
+        fun(i0, i1);
+    });
+}
+
+template <typename T, typename I>
+void
+multiply_sparse_rows(csr_matrix_engine<T, I> const& a, Pointer_type<T const> x, Pointer_type<T> y, pointer_diff i0, pointer_diff i1)
+// y[i] += row i of a times x, for i in [i0, i1)
+{
+    auto o = first(a.offsets);
+    auto c = first(a.column_indices);
+    auto v = first(a.values);
+    for (auto i = i0; i < i1; ++i) {
+        auto s = Zero<T>;
+        for (auto k = o[i]; k < o[successor(i)]; ++k) s = s + v[k] * x[c[k]];
+        y[i] = y[i] + s;
+    }
+}
+
+template <typename T, typename I>
+void
+multiply_sparse(csr_matrix_engine<T, I> const& a, Pointer_type<T const> x, Pointer_type<T> y, pointer_diff workers = hardware_concurrency())
+// y += a x
+{
+    for_each_sparse_rows(a, [&a, x, y](pointer_diff i0, pointer_diff i1){
+        multiply_sparse_rows(a, x, y, i0, i1);
+    }, workers);
+}
+
+template <typename T, typename I>
+void
+multiply_sparse(csr_matrix_engine<T, I> const& a, matrix_view<T const> b, matrix_view<T> c, pointer_diff workers = hardware_concurrency())
+//[[expects: columns(a) == b.rows and c.rows == rows(a) and c.columns == b.columns]]
+// c += a b, adding a multiple of a row of b to a row of c for each nonzero
+{
+    for_each_sparse_rows(a, [&a, b, c](pointer_diff i0, pointer_diff i1){
+        auto o = first(a.offsets);
+        for (auto i = i0; i < i1; ++i) {
+            for (auto k = o[i]; k < o[successor(i)]; ++k) {
+                auto r = static_cast<pointer_diff>(a.column_indices[k]);
+                auto v = a.values[k];
+                for (pointer_diff j = 0; j < c.columns; ++j) c(i, j) = c(i, j) + v * b(r, j);
+            }
+        }
+    }, workers);
+}
+
+template <typename OT, typename T0, typename I0, typename OT0, typename ET1, typename OT1>
+struct matrix_multiplication_t<OT, matrix<csr_matrix_engine<T0, I0>, OT0>, vector<ET1, OT1>>
+{
+    using op_t = OT;
+    using return_type = vector<dynamic_vector_engine<T0, array_allocator<T0>>, op_t>;
+
+    static auto
+    mul(matrix<csr_matrix_engine<T0, I0>, OT0> const& x, vector<ET1, OT1> const& y) -> return_type
+    //[[expects: columns(x) == size(y)]]
+    {
+        return_type z(rows(x), Zero<T0>);
+        multiply_sparse(x.engine, first(y), first(z));
+        return z;
+    }
+};
+
+template <typename OT, typename T0, typename I0, typename OT0, typename ET1, typename OT1>
+struct matrix_multiplication_t<OT, matrix<csr_matrix_engine<T0, I0>, OT0>, matrix<ET1, OT1>>
+{
+    using op_t = OT;
+    using return_type = matrix<dynamic_matrix_engine<T0>, op_t>;
+
+    static auto
+    mul(matrix<csr_matrix_engine<T0, I0>, OT0> const& x, matrix<ET1, OT1> const& y) -> return_type
+    //[[expects: columns(x) == rows(y)]]
+    {
+        return_type z(rows(x), columns(y), Zero<T0>);
+        multiply_sparse(x.engine, view(y), view(z));
+        return z;
+    }
+};
+
+template <typename I = pointer_diff, typename ET, typename OT>
+auto
+to_sparse(matrix<ET, OT> const& x) -> sparse_matrix<Value_type<ET>, I>
+{
+    using T = Value_type<ET>;
+    sparse_matrix<T, I> y{csr_matrix_engine<T, I>(rows(x), columns(x))};
+    auto& e = y.engine;
+    for (pointer_diff i = 0; i < rows(x); ++i) {
+        for (pointer_diff j = 0; j < columns(x); ++j) {
+            if (x(i, j) != Zero<T>) {
+                push(e.column_indices, static_cast<I>(j));
+                push(e.values, x(i, j));
+            }
+        }
+        e.offsets[successor(i)] = size(e.values);
+    }
+    return y;
+}
+
+template <typename T, typename I, typename OT>
+auto
+to_dense(matrix<csr_matrix_engine<T, I>, OT> const& x) -> dynamic_matrix<T>
+{
+    dynamic_matrix<T> y(rows(x), columns(x), Zero<T>);
+    auto const& e = x.engine;
+    for (pointer_diff i = 0; i < rows(x); ++i) {
+        for (auto k = e.offsets[i]; k < e.offsets[successor(i)]; ++k) {
+            y(i, static_cast<pointer_diff>(e.column_indices[k])) = e.values[k];
+        }
+    }
+    return y;
+}
+
+}
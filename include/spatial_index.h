@@ -0,0 +1,465 @@
+#pragma once
+
+#include "affine_space.h"
+#include "parallel.h"
+#include "swap.h"
+
+namespace elements {
+
+inline constexpr pointer_diff kd_tree_leaf = 16;
+
+inline constexpr pointer_diff spatial_index_parallel_grain = 65536;
+
+inline constexpr pointer_diff grid_index_cells_per_point = 8;
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+requires Totally_ordered<S>
+void
+kd_tree_select(point_cloud<S, k, alloc>& x, Pointer_type<pointer_diff> indices, pointer_diff i, pointer_diff j, pointer_diff m, pointer_diff d)
+//[[expects: i <= m and m < j and j <= size(x) and d < k]]
+// Permutes the points [i, j) of x together with their indices so that
+// coordinate d of the point at m is not less than that of any point before it
+// and not greater than that of any point after it, by quickselect with Hoare
+// partitioning around the median of three
+{
+    Pointer_type<S> c[static_cast<size_t>(k)];
+    for (pointer_diff l = 0; l < k; ++l) c[l] = first(x.coordinates[l]);
+    auto key = c[d];
+    auto exchange = [&c, indices](pointer_diff a, pointer_diff b){
+        for (pointer_diff l = 0; l < k; ++l) swap(c[l][a], c[l][b]);
+        swap(indices[a], indices[b]);
+    };
+    while (successor(i) < j) {
+        S p = median(key[i], key[i + half(j - i)], key[predecessor(j)]);
+        auto l = i;
+        auto r = predecessor(j);
+        while (l <= r) {
+            while (key[l] < p) increment(l);
+            while (p < key[r]) decrement(r);
+            if (l <= r) {
+                exchange(l, r);
+                increment(l);
+                decrement(r);
+            }
+        }
+        // [i, r] is not greater than p, [l, j) is not less, and (r, l) is p
+        if (m <= r) j = successor(r);
+        else if (l <= m) i = l;
+        else return;
+    }
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+requires Totally_ordered<S>
+void
+kd_tree_build(point_cloud<S, k, alloc>& x, Pointer_type<pointer_diff> indices, pointer_diff i, pointer_diff j, pointer_diff depth, pointer_diff workers)
+// Arranges the points [i, j) of x as the subtree at depth, splitting the
+// workers between the two subtrees of each node large enough to share
+{
+    if (j - i <= kd_tree_leaf) return;
+    auto m = i + half(j - i);
+    kd_tree_select(x, indices, i, j, m, depth % k);
+    auto w = half(workers);
+    if (is_zero(w) or j - i < spatial_index_parallel_grain) {
+        kd_tree_build(x, indices, i, m, successor(depth), workers);
+        kd_tree_build(x, indices, successor(m), j, successor(depth), workers);
+        return;
+    }
+    for_each_worker(2, [&x, indices, i, j, m, depth, workers, w](pointer_diff t){
+        if (is_zero(t)) kd_tree_build(x, indices, i, m, successor(depth), workers - w);
+        else kd_tree_build(x, indices, successor(m), j, successor(depth), w);
+    });
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc = array_allocator<S>>
+requires Totally_ordered<S>
+struct kd_tree
+{
+    // The tree is implicit in the order of the points: a range of more than
+    // kd_tree_leaf of them is a node whose middle point splits it by
+    // coordinate depth mod k into the ranges before and after that point,
+    // its subtrees, and any other range is a leaf. indices maps each point
+    // to its position in the input
+    point_cloud<S, k, alloc> points;
+    array_single_ended<pointer_diff> indices;
+
+    constexpr
+    kd_tree() = default;
+
+    template <Cursor C, Limit<C> L>
+    requires Same_as<Decay<Value_type<C>>, point<S, k>>
+    kd_tree(C cur, L lim, pointer_diff workers = hardware_concurrency())
+    {
+        auto n = Zero<pointer_diff>;
+        while (precedes(cur, lim)) {
+            push(points, load(cur));
+            push(indices, n);
+            increment(cur);
+            increment(n);
+        }
+        kd_tree_build(points, first(indices), 0, n, 0, workers);
+    }
+};
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+constexpr auto
+size(kd_tree<S, k, alloc> const& x) -> pointer_diff
+{
+    return size(x.indices);
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+constexpr auto
+is_empty(kd_tree<S, k, alloc> const& x) -> bool
+{
+    return is_empty(x.indices);
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+void
+kd_tree_nearest(
+    kd_tree<S, k, alloc> const& x, point<S, k> const& y, pointer_diff i, pointer_diff j, pointer_diff depth,
+    pointer_diff m, Pointer_type<S> nearest, Pointer_type<pointer_diff> dst, pointer_diff& count)
+// Inserts the points [i, j) of the subtree at depth into the count nearest
+// candidates, visiting the subtree on the side of y first and the other one
+// only if the splitting plane is no farther than the m:th nearest so far
+{
+    auto insert = [&x, m, nearest, dst, &count](pointer_diff l, S const& q){
+        if (count < m or !(nearest[predecessor(m)] < q)) insert_nearest(nearest, dst, count, m, q, x.indices[l]);
+    };
+    if (j - i <= kd_tree_leaf) {
+        for_each_quadrance(x.points, y, i, j, insert);
+        return;
+    }
+    auto h = i + half(j - i);
+    auto d = depth % k;
+    auto e = y(d) - x.points.coordinates[d][h];
+    auto near_left = e < Zero<S>;
+    for_each_quadrance(x.points, y, h, successor(h), insert);
+    if (near_left) kd_tree_nearest(x, y, i, h, successor(depth), m, nearest, dst, count);
+    else kd_tree_nearest(x, y, successor(h), j, successor(depth), m, nearest, dst, count);
+    if (count == m and nearest[predecessor(m)] < e * e) return;
+    if (near_left) kd_tree_nearest(x, y, successor(h), j, successor(depth), m, nearest, dst, count);
+    else kd_tree_nearest(x, y, i, h, successor(depth), m, nearest, dst, count);
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+auto
+nearest_neighbours(kd_tree<S, k, alloc> const& x, point<S, k> const& y, pointer_diff m, Pointer_type<pointer_diff> dst) -> pointer_diff
+// Stores the input positions of the min(m, size(x)) points of x nearest to
+// y in dst, in the same order as for a point_cloud, and returns their number
+{
+    m = min(m, size(x));
+    if (is_zero(m)) return m;
+    array_single_ended<S> nearest(m, Zero<S>);
+    auto count = Zero<pointer_diff>;
+    kd_tree_nearest(x, y, 0, size(x), 0, m, first(nearest), dst, count);
+    return m;
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc>
+auto
+nearest(kd_tree<S, k, alloc> const& x, point<S, k> const& y) -> pointer_diff
+//[[expects: !is_empty(x)]]
+// Returns the input position of the point of x nearest to y
+{
+    auto q = Zero<S>;
+    auto i = Zero<pointer_diff>;
+    auto count = Zero<pointer_diff>;
+    kd_tree_nearest(x, y, 0, size(x), 0, 1, &q, &i, count);
+    return i;
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc, Invocable<pointer_diff> P>
+void
+kd_tree_within(kd_tree<S, k, alloc> const& x, point<S, k> const& y, S const& q, pointer_diff i, pointer_diff j, pointer_diff depth, P& proc)
+{
+    auto within = [&x, &q, &proc](pointer_diff l, S const& q_l){
+        if (!(q < q_l)) proc(x.indices[l]);
+    };
+    if (j - i <= kd_tree_leaf) {
+        for_each_quadrance(x.points, y, i, j, within);
+        return;
+    }
+    auto h = i + half(j - i);
+    auto d = depth % k;
+    auto e = y(d) - x.points.coordinates[d][h];
+    auto near_left = e < Zero<S>;
+    auto both = !(q < e * e);
+    if (both) for_each_quadrance(x.points, y, h, successor(h), within);
+    if (near_left or both) kd_tree_within(x, y, q, i, h, successor(depth), proc);
+    if (!near_left or both) kd_tree_within(x, y, q, successor(h), j, successor(depth), proc);
+}
+
+template <Semiring S, pointer_diff k, Invocable auto alloc, Invocable<pointer_diff> P>
+void
+for_each_within(kd_tree<S, k, alloc> const& x, point<S, k> const& y, S const& r, P proc)
+// Calls proc with the input position of each point of x at distance at most
+// r, that is at quadrance at most r r, from y, in no particular order
+{
+    if (is_empty(x)) return;
+    kd_tree_within(x, y, r * r, 0, size(x), 0, proc);
+}
+
+template <Arithmetic S>
+constexpr auto
+grid_coordinate(S const& a, S const& origin, S const& cell, pointer_diff cells) -> pointer_diff
+//[[expects: 0 < cell and 0 < cells]]
+// Returns the index of the interval of length cell starting at origin that
+// contains a, clamped to [0, cells)
+{
+    if (!(origin < a)) return 0;
+    if (!(a - origin < cell * static_cast<S>(cells))) return predecessor(cells);
+    return min(static_cast<pointer_diff>((a - origin) / cell), predecessor(cells));
+}
+
+template <pointer_diff k, Invocable<array_k<pointer_diff, k> const&> P>
+void
+for_each_grid_row(array_k<pointer_diff, k> const& lo, array_k<pointer_diff, k> const& hi, P proc)
+//[[expects: lo[j] <= hi[j] for each j]]
+// Calls proc(c) for each c in the box [lo, hi] whose last coordinate is
+// lo[k - 1], in row-major order, that is once for each row of the box
+{
+    auto c = lo;
+    while (true) {
+        proc(c);
+        auto j = predecessor(k);
+        while (true) {
+            if (is_zero(j)) return;
+            decrement(j);
+            if (c[j] < hi[j]) {
+                increment(c[j]);
+                break;
+            }
+            c[j] = lo[j];
+        }
+    }
+}
+
+template <Arithmetic S, pointer_diff k, Invocable auto alloc = array_allocator<S>>
+struct grid_index
+{
+    // Space is divided into cubes of side cell from origin, cells[j] of them
+    // along coordinate j, and the points are sorted by cube, taken in
+    // row-major order, so that the points of a run of cubes along the last
+    // coordinate from c to d are the range [offsets[c], offsets[d + 1]).
+    // Points outside the cubes count as in the nearest one
+    point_cloud<S, k, alloc> points;
+    array_single_ended<pointer_diff> indices;
+    array_single_ended<pointer_diff> offsets;
+    point<S, k> origin;
+    S cell{One<S>};
+    array_k<pointer_diff, k> cells = array_k<pointer_diff, k>(One<pointer_diff>);
+
+    constexpr
+    grid_index()
+        : offsets(2, Zero<pointer_diff>)
+    {}
+
+    template <Cursor C, Limit<C> L>
+    requires Same_as<Decay<Value_type<C>>, point<S, k>>
+    grid_index(C cur, L lim, S const& cell_size, pointer_diff workers = hardware_concurrency())
+    //[[expects: 0 < cell_size]]
+    //[[expects axiom: the coordinates of the points are finite]]
+        : cell{cell_size}
+    {
+        // The points are distributed to their cubes by a counting sort, in
+        // which each worker counts and then places its own share of them
+        point_cloud<S, k, alloc> x;
+        while (precedes(cur, lim)) {
+            push(x, load(cur));
+            increment(cur);
+        }
+        auto n = size(x);
+        point<S, k> top;
+        if (!is_zero(n)) {
+            origin = x(0);
+            top = x(0);
+        }
+        for (pointer_diff j = 0; j < k; ++j) {
+            auto c = first(x.coordinates[j]);
+            for (pointer_diff i = 0; i < n; ++i) {
+                if (c[i] < origin(j)) origin(j) = c[i];
+                if (top(j) < c[i]) top(j) = c[i];
+            }
+        }
+        // A wide extent with a small side would need more counts than there
+        // is memory for, so the side is doubled until there are at most
+        // grid_index_cells_per_point cubes per point
+        auto total_max = max(n, One<pointer_diff>) * grid_index_cells_per_point;
+        auto total = One<pointer_diff>;
+        while (true) {
+            total = One<pointer_diff>;
+            pointer_diff j = 0;
+            while (j < k) {
+                auto extent = (top(j) - origin(j)) / cell;
+                if (!(extent < static_cast<S>(total_max))) break;
+                cells[j] = successor(static_cast<pointer_diff>(extent));
+                if (total_max / cells[j] < total) break;
+                total = total * cells[j];
+                increment(j);
+            }
+            if (j == k) break;
+            cell = cell + cell;
+        }
+        array_single_ended<pointer_diff> keys(n, Zero<pointer_diff>);
+        auto w = parallel_workers(n, spatial_index_parallel_grain, workers);
+        array_single_ended<pointer_diff> counts(w * total, Zero<pointer_diff>);
+        for_each_worker(w, [this, &x, &keys, &counts, n, w, total](pointer_diff t){
+            for (auto i = n * t / w; i < n * successor(t) / w; ++i) {
+                auto key = Zero<pointer_diff>;
+                for (pointer_diff j = 0; j < k; ++j) {
+                    key = key * cells[j] + grid_coordinate(x.coordinates[j][i], origin(j), cell, cells[j]);
+                }
+                keys[i] = key;
+                increment(counts[t * total + key]);
+            }
+        });
+        offsets = array_single_ended<pointer_diff>(successor(total), Zero<pointer_diff>);
+        auto r = Zero<pointer_diff>;
+        for (pointer_diff c = 0; c < total; ++c) {
+            offsets[c] = r;
+            for (pointer_diff t = 0; t < w; ++t) {
+                auto count = counts[t * total + c];
+                counts[t * total + c] = r;
+                r = r + count;
+            }
+        }
+        offsets[total] = r;
+        for (pointer_diff j = 0; j < k; ++j) points.coordinates[j] = array_single_ended<S, alloc>(n, Zero<S>);
+        indices = array_single_ended<pointer_diff>(n, Zero<pointer_diff>);
+        for_each_worker(w, [this, &x, &keys, &counts, n, w, total](pointer_diff t){
+            for (auto i = n * t / w; i < n * successor(t) / w; ++i) {
+                auto& p = counts[t * total + keys[i]];
+                for (pointer_diff j = 0; j < k; ++j) points.coordinates[j][p] = x.coordinates[j][i];
+                indices[p] = i;
+                increment(p);
+            }
+        });
+    }
+};
+
+template <Arithmetic S, pointer_diff k, Invocable auto alloc>
+constexpr auto
+size(grid_index<S, k, alloc> const& x) -> pointer_diff
+{
+    return size(x.indices);
+}
+
+template <Arithmetic S, pointer_diff k, Invocable auto alloc>
+constexpr auto
+is_empty(grid_index<S, k, alloc> const& x) -> bool
+{
+    return is_empty(x.indices);
+}
+
+template <Arithmetic S, pointer_diff k, Invocable auto alloc>
+constexpr auto
+grid_cube(grid_index<S, k, alloc> const& x, array_k<pointer_diff, k> const& c) -> pointer_diff
+// Returns the position of cube c in row-major order
+{
+    auto key = Zero<pointer_diff>;
+    for (pointer_diff j = 0; j < k; ++j) key = key * x.cells[j] + c[j];
+    return key;
+}
+
+template <Arithmetic S, pointer_diff k, Invocable auto alloc, Invocable<pointer_diff, S const&> P>
+void
+for_each_grid_run(grid_index<S, k, alloc> const& x, point<S, k> const& y, array_k<pointer_diff, k> c, pointer_diff d, P& proc)
+//[[expects: c[k - 1] <= d]]
+// Calls proc(l, q) for each point l in the cubes from c to c with its last
+// coordinate replaced by d, where q is the quadrance between point l and y
+{
+    auto i = x.offsets[grid_cube(x, c)];
+    c[predecessor(k)] = d;
+    auto j = x.offsets[successor(grid_cube(x, c))];
+    for_each_quadrance(x.points, y, i, j, proc);
+}
+
+template <Arithmetic S, pointer_diff k, Invocable auto alloc>
+auto
+nearest_neighbours(grid_index<S, k, alloc> const& x, point<S, k> const& y, pointer_diff m, Pointer_type<pointer_diff> dst) -> pointer_diff
+// Stores the input positions of the min(m, size(x)) points of x nearest to
+// y in dst, in the same order as for a point_cloud, and returns their number.
+// The cubes are visited in shells of growing distance s from the cube of y,
+// which ends once the m:th nearest so far is nearer than s cubes
+{
+    m = min(m, size(x));
+    if (is_zero(m)) return m;
+    array_single_ended<S> nearest(m, Zero<S>);
+    auto near = first(nearest);
+    auto count = Zero<pointer_diff>;
+    auto insert = [&x, m, near, dst, &count](pointer_diff l, S const& q){
+        if (count < m or !(near[predecessor(m)] < q)) insert_nearest(near, dst, count, m, q, x.indices[l]);
+    };
+    array_k<pointer_diff, k> c;
+    for (pointer_diff j = 0; j < k; ++j) c[j] = grid_coordinate(y(j), x.origin(j), x.cell, x.cells[j]);
+    auto const last = predecessor(k);
+    for (pointer_diff s = 0; ; ++s) {
+        array_k<pointer_diff, k> lo;
+        array_k<pointer_diff, k> hi;
+        auto covered = true;
+        for (pointer_diff j = 0; j < k; ++j) {
+            lo[j] = max(c[j] - s, Zero<pointer_diff>);
+            hi[j] = min(c[j] + s, predecessor(x.cells[j]));
+            covered = covered and is_zero(lo[j]) and hi[j] == predecessor(x.cells[j]);
+        }
+        for_each_grid_row(lo, hi, [&x, &y, &c, &hi, &insert, s, last](array_k<pointer_diff, k> const& row){
+            // A row on the boundary of the shell is new in all its cubes,
+            // any other row only in its cubes at either end
+            auto boundary = false;
+            for (pointer_diff j = 0; j < last; ++j) boundary = boundary or row[j] == c[j] - s or row[j] == c[j] + s;
+            if (boundary) {
+                for_each_grid_run(x, y, row, hi[last], insert);
+                return;
+            }
+            auto cube = row;
+            if (Zero<pointer_diff> <= c[last] - s) {
+                cube[last] = c[last] - s;
+                for_each_grid_run(x, y, cube, cube[last], insert);
+            }
+            if (!is_zero(s) and c[last] + s < x.cells[last]) {
+                cube[last] = c[last] + s;
+                for_each_grid_run(x, y, cube, cube[last], insert);
+            }
+        });
+        if (covered) break;
+        auto bound = static_cast<S>(s) * x.cell;
+        if (count == m and near[predecessor(m)] < bound * bound) break;
+    }
+    return m;
+}
+
+template <Arithmetic S, pointer_diff k, Invocable auto alloc>
+auto
+nearest(grid_index<S, k, alloc> const& x, point<S, k> const& y) -> pointer_diff
+//[[expects: !is_empty(x)]]
+// Returns the input position of the point of x nearest to y
+{
+    auto i = Zero<pointer_diff>;
+    nearest_neighbours(x, y, 1, &i);
+    return i;
+}
+
+template <Arithmetic S, pointer_diff k, Invocable auto alloc, Invocable<pointer_diff> P>
+void
+for_each_within(grid_index<S, k, alloc> const& x, point<S, k> const& y, S const& r, P proc)
+// Calls proc with the input position of each point of x at distance at most
+// r, that is at quadrance at most r r, from y, in no particular order
+{
+    array_k<pointer_diff, k> lo;
+    array_k<pointer_diff, k> hi;
+    for (pointer_diff j = 0; j < k; ++j) {
+        lo[j] = grid_coordinate(y(j) - r, x.origin(j), x.cell, x.cells[j]);
+        hi[j] = grid_coordinate(y(j) + r, x.origin(j), x.cell, x.cells[j]);
+    }
+    auto q = r * r;
+    auto within = [&x, &q, &proc](pointer_diff l, S const& q_l){
+        if (!(q < q_l)) proc(x.indices[l]);
+    };
+    for_each_grid_row(lo, hi, [&x, &y, &hi, &within](array_k<pointer_diff, k> const& row){
+        for_each_grid_run(x, y, row, hi[predecessor(k)], within);
+    });
+}
+
+}
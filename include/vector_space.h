@@ -5,6 +5,7 @@
 #include "array_single_ended.h"
 #include "fill.h"
 #include "map.h"
+#include "parallel.h"
 #include "range.h"
 #include "reduce.h"
 
@@ -297,6 +298,177 @@ reserve(dynamic_vector_engine<T, alloc>& x, Size_type<dynamic_vector_engine<T, a
     reserve(x.elements, capacity);
 }
 
+template <typename ET>
+struct expression_operand_t
+{
+    using type = ET const&;
+};
+
+template <typename ET>
+using Expression_operand_type = typename expression_operand_t<ET>::type;
+
+template <typename Op, typename ET>
+struct unary_expression_engine
+{
+    // Computes op(x(i)) on access, so expressions of vectors are evaluated in
+    // a single pass when assigned, without temporary vectors
+    Expression_operand_type<ET> x;
+    Op op;
+
+    constexpr auto
+    operator()(Size_type<ET> i) const
+    {
+        return op(x(i));
+    }
+};
+
+template <typename Op, typename ET0, typename ET1>
+struct binary_expression_engine
+{
+    // Computes op(x(i), y(i)) on access
+    Expression_operand_type<ET0> x;
+    Expression_operand_type<ET1> y;
+    Op op;
+
+    constexpr auto
+    operator()(Size_type<ET0> i) const
+    {
+        return op(x(i), y(i));
+    }
+};
+
+template <typename Op, typename ET>
+struct expression_operand_t<unary_expression_engine<Op, ET>>
+{
+    // Expressions are held by value, since they are usually temporaries,
+    // and engines with storage by reference
+    using type = unary_expression_engine<Op, ET>;
+};
+
+template <typename Op, typename ET0, typename ET1>
+struct expression_operand_t<binary_expression_engine<Op, ET0, ET1>>
+{
+    using type = binary_expression_engine<Op, ET0, ET1>;
+};
+
+template <typename ET>
+concept Expression_engine = Same_as<Expression_operand_type<ET>, ET>;
+
+template <typename Op, typename ET>
+struct value_type_t<unary_expression_engine<Op, ET>>
+{
+    using type = Remove_const<decltype(declval<Op const&>()(declval<Value_type<ET> const&>()))>;
+};
+
+template <typename Op, typename ET0, typename ET1>
+struct value_type_t<binary_expression_engine<Op, ET0, ET1>>
+{
+    using type = Remove_const<decltype(declval<Op const&>()(declval<Value_type<ET0> const&>(), declval<Value_type<ET1> const&>()))>;
+};
+
+template <typename Op, typename ET>
+struct scalar_type_t<unary_expression_engine<Op, ET>>
+{
+    using type = Value_type<unary_expression_engine<Op, ET>>;
+};
+
+template <typename Op, typename ET0, typename ET1>
+struct scalar_type_t<binary_expression_engine<Op, ET0, ET1>>
+{
+    using type = Value_type<binary_expression_engine<Op, ET0, ET1>>;
+};
+
+template <typename Op, typename ET>
+struct size_type_t<unary_expression_engine<Op, ET>>
+{
+    using type = Size_type<ET>;
+};
+
+template <typename Op, typename ET0, typename ET1>
+struct size_type_t<binary_expression_engine<Op, ET0, ET1>>
+{
+    using type = Size_type<ET0>;
+};
+
+template <typename Op, typename ET>
+constexpr auto
+size(unary_expression_engine<Op, ET> const& x) -> Size_type<ET>
+{
+    return size(x.x);
+}
+
+template <typename Op, typename ET0, typename ET1>
+constexpr auto
+size(binary_expression_engine<Op, ET0, ET1> const& x) -> Size_type<ET0>
+{
+    return size(x.x);
+}
+
+template <typename S>
+struct mul_scalar
+{
+    // Unlike mul_unary, holds the scalar by value, since an expression may
+    // outlive the scalar it was built from
+    S s;
+
+    template <typename T>
+    constexpr auto
+    operator()(T const& x) const
+    {
+        return x * s;
+    }
+};
+
+template <typename S>
+struct mul_scalar_left
+{
+    S s;
+
+    template <typename T>
+    constexpr auto
+    operator()(T const& x) const
+    {
+        return s * x;
+    }
+};
+
+inline constexpr pointer_diff inner_product_lanes = 8;
+
+template <typename ET0, typename ET1>
+constexpr auto
+inner_product_engines(ET0 const& x, ET1 const& y, Size_type<ET0> n)
+// Returns the sum of x(i) y(i) for i in [0, n) in a single pass; for
+// arithmetic scalars the products are accumulated in inner_product_lanes
+// independent sums, which removes the dependency between consecutive
+// additions and lets the lanes vectorize
+{
+    using S = Remove_const<decltype(x(Size_type<ET0>{}) * y(Size_type<ET0>{}))>;
+    if constexpr (Arithmetic<S>) {
+        S r[inner_product_lanes]{};
+        auto i = Zero<Size_type<ET0>>;
+        auto m = n - n % inner_product_lanes;
+        while (i != m) {
+            for (pointer_diff j = 0; j < inner_product_lanes; ++j) r[j] = r[j] + x(i + j) * y(i + j);
+            i = i + inner_product_lanes;
+        }
+        while (i != n) {
+            r[0] = r[0] + x(i) * y(i);
+            increment(i);
+        }
+        auto z = Zero<S>;
+        for (pointer_diff j = 0; j < inner_product_lanes; ++j) z = z + r[j];
+        return z;
+    } else {
+        auto z = Zero<S>;
+        auto i = Zero<Size_type<ET0>>;
+        while (i != n) {
+            z = z + x(i) * y(i);
+            increment(i);
+        }
+        return z;
+    }
+}
+
 template <typename>
 struct engine_type_t;
 
@@ -322,6 +494,11 @@ struct vector
         : engine{capacity}
     {}
 
+    explicit constexpr
+    vector(ET const& x)
+        : engine{x}
+    {}
+
     constexpr
     vector(Size_type<ET> size, Scalar_type<ET> const& x)
         : engine(size, size, x)
@@ -332,6 +509,21 @@ struct vector
         : engine(capacity, size, x)
     {}
 
+    template <Expression_engine ET1, typename OT1>
+    constexpr
+    vector(vector<ET1, OT1> const& x)
+    {
+        assign(*this, x);
+    }
+
+    template <Expression_engine ET1, typename OT1>
+    constexpr auto
+    operator=(vector<ET1, OT1> const& x) -> vector&
+    {
+        assign(*this, x);
+        return *this;
+    }
+
     constexpr auto
     operator[](Size_type<ET> i) -> Value_type<ET>&
     {
@@ -509,6 +701,30 @@ transpose(vector<ET, OT> const& x) -> Transpose_type<vector<ET, OT>>
     return {x};
 }
 
+template <typename ET0, typename OT0, typename ET1, typename OT1>
+constexpr void
+assign(vector<ET0, OT0>& x, vector<ET1, OT1> const& y)
+// Stores the elements of y in x in a single pass, resizing a dynamic x only
+// if the sizes differ; y may refer to x, such as in x = a * x + z, since
+// each element of x is read only to compute the same element
+//[[expects: Is_dynamic_vector<vector<ET0, OT0>> or size(x) == size(y)]]
+{
+    auto n = size(y.engine);
+    if constexpr (Is_dynamic_vector<vector<ET0, OT0>>) {
+        if (size(x) != n) x = vector<ET0, OT0>(n, Zero<Scalar_type<ET0>>);
+    }
+    auto dst = first(x);
+    for (Size_type<ET1> i = 0; i < n; ++i) dst[i] = y.engine(i);
+}
+
+template <typename ET0, typename OT0, typename ET1, typename OT1>
+constexpr auto
+inner_product(vector<ET0, OT0> const& x, vector<ET1, OT1> const& y)
+//[[expects: size(x) == size(y)]]
+{
+    return inner_product_engines(x.engine, y.engine, size(x.engine));
+}
+
 struct matrix_operation_t;
 
 template <typename T, pointer_diff k>
@@ -636,13 +852,9 @@ struct matrix_addition_t<OT, vector<ET0, OT0>, vector<ET1, OT1>>
     static auto
     add(vector<ET0, OT0> const& x, vector<ET1, OT1> const& y) -> return_type
     {
+        using expression_type = binary_expression_engine<add_op<Scalar_type<ET0>>, ET0, ET1>;
         return_type z;
-        if constexpr (Is_dynamic_vector<return_type>) {
-            reserve(engine(z), size(x));
-            map(first(x), limit(x), first(y), insert_sink{}(back{engine(z).elements}), add_op<Scalar_type<ET0>>{});
-        } else {
-            map(first(x), limit(x), first(y), first(z), add_op<Scalar_type<ET0>>{});
-        }
+        assign(z, vector<expression_type, op_t>{expression_type{x.engine, y.engine, {}}});
         return z;
     }
 };
@@ -675,13 +887,9 @@ struct matrix_negation_t<OT, vector<ET0, OT0>>
     static auto
     neg(vector<ET0, OT0> const& x) -> return_type
     {
+        using expression_type = unary_expression_engine<neg_op<Scalar_type<ET0>>, ET0>;
         return_type y;
-        if constexpr (Is_dynamic_vector<return_type>) {
-            reserve(y, size(x));
-            map(first(x), limit(x), insert_sink{}(back{engine(y).elements}), neg_op<Scalar_type<ET0>>{});
-        } else {
-            map(first(x), limit(x), first(y), neg_op<Scalar_type<ET0>>{});
-        }
+        assign(y, vector<expression_type, op_t>{expression_type{x.engine, {}}});
         return y;
     }
 };
@@ -712,13 +920,9 @@ struct matrix_subtraction_t<OT, vector<ET0, OT0>, vector<ET1, OT1>>
     static auto
     sub(vector<ET0, OT0> const& x, vector<ET1, OT1> const& y) -> return_type
     {
+        using expression_type = binary_expression_engine<sub_op<Scalar_type<ET0>>, ET0, ET1>;
         return_type z;
-        if constexpr (Is_dynamic_vector<return_type>) {
-            reserve(z, size(x));
-            map(first(x), limit(x), first(y), insert_sink{}(back{engine(z).elements}), sub_op<Scalar_type<ET0>>{});
-        } else {
-            map(first(x), limit(x), first(y), first(z), sub_op<Scalar_type<ET0>>{});
-        }
+        assign(z, vector<expression_type, op_t>{expression_type{x.engine, y.engine, {}}});
         return z;
     }
 };
@@ -751,13 +955,9 @@ struct matrix_multiplication_t<OT, vector<ET0, OT0>, S1>
     static auto
     mul(vector<ET0, OT0> const& x, S1 const& s) -> return_type
     {
+        using expression_type = unary_expression_engine<mul_scalar<S1>, ET0>;
         return_type y;
-        if constexpr (Is_dynamic_vector<return_type>) {
-            reserve(y, size(x));
-            map(first(x), limit(x), insert_sink{}(back{engine(y).elements}), mul_unary<Scalar_type<vector<ET0, OT0>>>{s});
-        } else {
-            map(first(x), limit(x), first(y), mul_unary<Scalar_type<vector<ET0, OT0>>>{s});
-        }
+        assign(y, vector<expression_type, op_t>{expression_type{x.engine, {s}}});
         return y;
     }
 };
@@ -772,13 +972,9 @@ struct matrix_multiplication_t<OT, S0, vector<ET1, OT1>>
     static auto
     mul(S0 const& s, vector<ET1, OT1> const& x) -> return_type
     {
+        using expression_type = unary_expression_engine<mul_scalar_left<S0>, ET1>;
         return_type y;
-        if constexpr (Is_dynamic_vector<return_type>) {
-            reserve(y, size(x));
-            map(first(x), limit(x), insert_sink{}(back{engine(y).elements}), mul_unary<Scalar_type<vector<ET1, OT1>>>{s});
-        } else {
-            map(first(x), limit(x), first(y), mul_unary<Scalar_type<vector<ET1, OT1>>>{s});
-        }
+        assign(y, vector<expression_type, op_t>{expression_type{x.engine, {s}}});
         return y;
     }
 };
@@ -792,25 +988,10 @@ struct matrix_multiplication_t<OT, vector<ET0, OT0>, vector<ET1, OT1>>
     using return_type = typename Matrix_multiplication_scalar_t_type<op_t, scalar0_type, scalar1_type>::type;
 
     static auto
-    mul(vector<ET0, OT0> const& x, vector<ET0, OT0> const& y) -> return_type
+    mul(vector<ET0, OT0> const& x, vector<ET1, OT1> const& y) -> return_type
     //[[expects: size(x) == size(y)]]
     {
-        vector<ET0, OT0> z;
-        if constexpr (Is_dynamic_vector<vector<ET0, OT0>>) {
-            reserve(z, size(x));
-            map(first(x), limit(x), first(y), insert_sink{}(back{engine(z).elements}), mul_op<Scalar_type<vector<ET0, OT0>>>{});
-            return reduce(
-                first(z),
-                limit(z),
-                add_op<Scalar_type<vector<ET0, OT0>>>{},
-                Zero<Scalar_type<vector<ET0, OT0>>>);
-        } else {
-            return reduce(
-                first(z),
-                map(first(x), limit(x), first(y), first(z), mul_op<Scalar_type<vector<ET0, OT0>>>{}),
-                add_op<Scalar_type<vector<ET0, OT0>>>{},
-                Zero<Scalar_type<vector<ET0, OT0>>>);
-        }
+        return inner_product(x, y);
     }
 };
 
@@ -877,4 +1058,843 @@ struct matrix_operation_t
     using multiplication_t = matrix_multiplication_t<OTR, OP0, OP1>;
 };
 
+struct matrix_expression_operation_t;
+
+template <typename T, pointer_diff k>
+using static_expression_vector = vector<static_vector_engine<T, k>, matrix_expression_operation_t>;
+
+template <typename T, Invocable auto alloc = array_allocator<T>>
+using dynamic_expression_vector = vector<dynamic_vector_engine<T, alloc>, matrix_expression_operation_t>;
+
+template <typename OT, typename OP0, typename OP1>
+struct matrix_expression_addition_t;
+
+template <typename OT, typename ET0, typename OT0, typename ET1, typename OT1>
+struct matrix_expression_addition_t<OT, vector<ET0, OT0>, vector<ET1, OT1>>
+{
+    using engine_type = binary_expression_engine<add_op<Scalar_type<ET0>>, ET0, ET1>;
+    using op_t = OT;
+    using return_type = vector<engine_type, op_t>;
+
+    static constexpr auto
+    add(vector<ET0, OT0> const& x, vector<ET1, OT1> const& y) -> return_type
+    {
+        return return_type{engine_type{x.engine, y.engine, {}}};
+    }
+};
+
+template <typename OT, typename OP>
+struct matrix_expression_negation_t;
+
+template <typename OT, typename ET0, typename OT0>
+struct matrix_expression_negation_t<OT, vector<ET0, OT0>>
+{
+    using engine_type = unary_expression_engine<neg_op<Scalar_type<ET0>>, ET0>;
+    using op_t = OT;
+    using return_type = vector<engine_type, op_t>;
+
+    static constexpr auto
+    neg(vector<ET0, OT0> const& x) -> return_type
+    {
+        return return_type{engine_type{x.engine, {}}};
+    }
+};
+
+template <typename OT, typename OP0, typename OP1>
+struct matrix_expression_subtraction_t;
+
+template <typename OT, typename ET0, typename OT0, typename ET1, typename OT1>
+struct matrix_expression_subtraction_t<OT, vector<ET0, OT0>, vector<ET1, OT1>>
+{
+    using engine_type = binary_expression_engine<sub_op<Scalar_type<ET0>>, ET0, ET1>;
+    using op_t = OT;
+    using return_type = vector<engine_type, op_t>;
+
+    static constexpr auto
+    sub(vector<ET0, OT0> const& x, vector<ET1, OT1> const& y) -> return_type
+    {
+        return return_type{engine_type{x.engine, y.engine, {}}};
+    }
+};
+
+template <typename OT, typename OP0, typename OP1>
+struct matrix_expression_multiplication_t;
+
+template <typename OT, typename ET0, typename OT0, typename S1>
+struct matrix_expression_multiplication_t<OT, vector<ET0, OT0>, S1>
+{
+    using engine_type = unary_expression_engine<mul_scalar<S1>, ET0>;
+    using op_t = OT;
+    using return_type = vector<engine_type, op_t>;
+
+    static constexpr auto
+    mul(vector<ET0, OT0> const& x, S1 const& s) -> return_type
+    {
+        return return_type{engine_type{x.engine, {s}}};
+    }
+};
+
+template <typename OT, typename S0, typename ET1, typename OT1>
+struct matrix_expression_multiplication_t<OT, S0, vector<ET1, OT1>>
+{
+    using engine_type = unary_expression_engine<mul_scalar_left<S0>, ET1>;
+    using op_t = OT;
+    using return_type = vector<engine_type, op_t>;
+
+    static constexpr auto
+    mul(S0 const& s, vector<ET1, OT1> const& x) -> return_type
+    {
+        return return_type{engine_type{x.engine, {s}}};
+    }
+};
+
+template <typename OT, typename ET0, typename OT0, typename ET1, typename OT1>
+struct matrix_expression_multiplication_t<OT, vector<ET0, OT0>, vector<ET1, OT1>>
+{
+    static constexpr auto
+    mul(vector<ET0, OT0> const& x, vector<ET1, OT1> const& y)
+    //[[expects: size(x) == size(y)]]
+    {
+        return inner_product(x, y);
+    }
+};
+
+struct matrix_expression_operation_t
+{
+    // Returns expressions instead of vectors from vector operations, which
+    // are evaluated in a single pass when assigned to a vector
+    template <typename OTR, typename OP0, typename OP1>
+    using addition_t = matrix_expression_addition_t<OTR, OP0, OP1>;
+
+    template <typename OTR, typename OP>
+    using negation_t = matrix_expression_negation_t<OTR, OP>;
+
+    template <typename OTR, typename OP0, typename OP1>
+    using subtraction_t = matrix_expression_subtraction_t<OTR, OP0, OP1>;
+
+    template <typename OTR, typename OP0, typename OP1>
+    using multiplication_t = matrix_expression_multiplication_t<OTR, OP0, OP1>;
+};
+
+struct row_major {};
+
+struct column_major {};
+
+template <typename L>
+constexpr auto
+matrix_row_stride(pointer_diff, pointer_diff columns) -> pointer_diff
+{
+    if constexpr (Same_as<L, row_major>) return columns;
+    else return 1;
+}
+
+template <typename L>
+constexpr auto
+matrix_column_stride(pointer_diff rows, pointer_diff) -> pointer_diff
+{
+    if constexpr (Same_as<L, row_major>) return 1;
+    else return rows;
+}
+
+template <typename T, pointer_diff r, pointer_diff c, typename L = row_major>
+struct static_matrix_engine
+{
+    array_k<T, r * c> elements;
+
+    constexpr
+    static_matrix_engine() = default;
+
+    constexpr
+    static_matrix_engine(pointer_diff, pointer_diff, T const& x)
+    //[[expects: rows == r and columns == c]]
+    {
+        fill(first(elements), limit(elements), x);
+    }
+
+    constexpr auto
+    operator()(pointer_diff i, pointer_diff j) -> T&
+    {
+        return elements[i * matrix_row_stride<L>(r, c) + j * matrix_column_stride<L>(r, c)];
+    }
+
+    constexpr auto
+    operator()(pointer_diff i, pointer_diff j) const -> T const&
+    {
+        return elements[i * matrix_row_stride<L>(r, c) + j * matrix_column_stride<L>(r, c)];
+    }
+};
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+struct value_type_t<static_matrix_engine<T, r, c, L>>
+{
+    using type = Remove_const<T>;
+};
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+struct scalar_type_t<static_matrix_engine<T, r, c, L>>
+{
+    using type = T;
+};
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+struct scalar_type_t<static_matrix_engine<T, r, c, L> const>
+{
+    using type = T const;
+};
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+struct cursor_type_t<static_matrix_engine<T, r, c, L>>
+{
+    using type = Pointer_type<T>;
+};
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+struct cursor_type_t<static_matrix_engine<T, r, c, L> const>
+{
+    using type = Pointer_type<T const>;
+};
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+struct size_type_t<static_matrix_engine<T, r, c, L>>
+{
+    using type = Difference_type<Pointer_type<T>>;
+    static constexpr auto value = r * c;
+};
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+constexpr auto
+operator==(static_matrix_engine<T, r, c, L> const& x, static_matrix_engine<T, r, c, L> const& y) -> bool
+{
+    return x.elements == y.elements;
+}
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+constexpr auto
+first(static_matrix_engine<T, r, c, L>& x) -> Cursor_type<static_matrix_engine<T, r, c, L>>
+{
+    return first(x.elements);
+}
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+constexpr auto
+first(static_matrix_engine<T, r, c, L> const& x) -> Cursor_type<static_matrix_engine<T, r, c, L> const>
+{
+    return first(x.elements);
+}
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+constexpr auto
+limit(static_matrix_engine<T, r, c, L>& x) -> Cursor_type<static_matrix_engine<T, r, c, L>>
+{
+    return limit(x.elements);
+}
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+constexpr auto
+limit(static_matrix_engine<T, r, c, L> const& x) -> Cursor_type<static_matrix_engine<T, r, c, L> const>
+{
+    return limit(x.elements);
+}
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+constexpr auto
+rows(static_matrix_engine<T, r, c, L> const&) -> pointer_diff
+{
+    return r;
+}
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+constexpr auto
+columns(static_matrix_engine<T, r, c, L> const&) -> pointer_diff
+{
+    return c;
+}
+
+template <typename T, typename L = row_major, Invocable auto alloc = array_allocator<T>>
+struct dynamic_matrix_engine
+{
+    array_single_ended<T, alloc> elements;
+    pointer_diff row_count{};
+    pointer_diff column_count{};
+
+    constexpr
+    dynamic_matrix_engine() = default;
+
+    constexpr
+    dynamic_matrix_engine(pointer_diff rows, pointer_diff columns, T const& x)
+        : elements(rows * columns, rows * columns, x)
+        , row_count{rows}
+        , column_count{columns}
+    {}
+
+    constexpr auto
+    operator()(pointer_diff i, pointer_diff j) -> T&
+    {
+        return elements[i * matrix_row_stride<L>(row_count, column_count) + j * matrix_column_stride<L>(row_count, column_count)];
+    }
+
+    constexpr auto
+    operator()(pointer_diff i, pointer_diff j) const -> T const&
+    {
+        return elements[i * matrix_row_stride<L>(row_count, column_count) + j * matrix_column_stride<L>(row_count, column_count)];
+    }
+};
+
+template <typename T, typename L, Invocable auto alloc>
+struct value_type_t<dynamic_matrix_engine<T, L, alloc>>
+{
+    using type = Remove_const<T>;
+};
+
+template <typename T, typename L, Invocable auto alloc>
+struct scalar_type_t<dynamic_matrix_engine<T, L, alloc>>
+{
+    using type = T;
+};
+
+template <typename T, typename L, Invocable auto alloc>
+struct scalar_type_t<dynamic_matrix_engine<T, L, alloc> const>
+{
+    using type = T const;
+};
+
+template <typename T, typename L, Invocable auto alloc>
+struct cursor_type_t<dynamic_matrix_engine<T, L, alloc>>
+{
+    using type = Pointer_type<T>;
+};
+
+template <typename T, typename L, Invocable auto alloc>
+struct cursor_type_t<dynamic_matrix_engine<T, L, alloc> const>
+{
+    using type = Pointer_type<T const>;
+};
+
+template <typename T, typename L, Invocable auto alloc>
+struct size_type_t<dynamic_matrix_engine<T, L, alloc>>
+{
+    using type = Difference_type<Pointer_type<T>>;
+};
+
+template <typename T, typename L, Invocable auto alloc>
+constexpr auto
+operator==(dynamic_matrix_engine<T, L, alloc> const& x, dynamic_matrix_engine<T, L, alloc> const& y) -> bool
+{
+    return x.row_count == y.row_count and x.column_count == y.column_count and x.elements == y.elements;
+}
+
+template <typename T, typename L, Invocable auto alloc>
+constexpr auto
+first(dynamic_matrix_engine<T, L, alloc>& x) -> Cursor_type<dynamic_matrix_engine<T, L, alloc>>
+{
+    return first(x.elements);
+}
+
+template <typename T, typename L, Invocable auto alloc>
+constexpr auto
+first(dynamic_matrix_engine<T, L, alloc> const& x) -> Cursor_type<dynamic_matrix_engine<T, L, alloc> const>
+{
+    return first(x.elements);
+}
+
+template <typename T, typename L, Invocable auto alloc>
+constexpr auto
+limit(dynamic_matrix_engine<T, L, alloc>& x) -> Cursor_type<dynamic_matrix_engine<T, L, alloc>>
+{
+    return limit(x.elements);
+}
+
+template <typename T, typename L, Invocable auto alloc>
+constexpr auto
+limit(dynamic_matrix_engine<T, L, alloc> const& x) -> Cursor_type<dynamic_matrix_engine<T, L, alloc> const>
+{
+    return limit(x.elements);
+}
+
+template <typename T, typename L, Invocable auto alloc>
+constexpr auto
+rows(dynamic_matrix_engine<T, L, alloc> const& x) -> pointer_diff
+{
+    return x.row_count;
+}
+
+template <typename T, typename L, Invocable auto alloc>
+constexpr auto
+columns(dynamic_matrix_engine<T, L, alloc> const& x) -> pointer_diff
+{
+    return x.column_count;
+}
+
+template <typename ET, typename OT>
+struct matrix
+{
+    ET engine;
+
+    constexpr
+    matrix() = default;
+
+    explicit constexpr
+    matrix(ET const& x)
+        : engine{x}
+    {}
+
+    constexpr
+    matrix(pointer_diff rows, pointer_diff columns, Scalar_type<ET> const& x)
+        : engine(rows, columns, x)
+    {}
+
+    constexpr auto
+    operator()(pointer_diff i, pointer_diff j) -> Scalar_type<ET>&
+    {
+        return engine(i, j);
+    }
+
+    constexpr auto
+    operator()(pointer_diff i, pointer_diff j) const -> Scalar_type<ET> const&
+    {
+        return engine(i, j);
+    }
+};
+
+template <typename ET, typename OT>
+struct engine_type_t<matrix<ET, OT>>
+{
+    using type = ET;
+};
+
+template <typename ET, typename OT>
+struct value_type_t<matrix<ET, OT>>
+{
+    using type = Value_type<ET>;
+};
+
+template <typename ET, typename OT>
+struct scalar_type_t<matrix<ET, OT>>
+{
+    using type = Scalar_type<ET>;
+};
+
+template <typename ET, typename OT>
+struct scalar_type_t<matrix<ET, OT> const>
+{
+    using type = Scalar_type<ET const>;
+};
+
+template <typename ET, typename OT>
+struct cursor_type_t<matrix<ET, OT>>
+{
+    using type = Cursor_type<ET>;
+};
+
+template <typename ET, typename OT>
+struct cursor_type_t<matrix<ET, OT> const>
+{
+    using type = Cursor_type<ET const>;
+};
+
+template <typename ET, typename OT>
+struct size_type_t<matrix<ET, OT>>
+{
+    using type = Size_type<ET>;
+};
+
+template <typename ET, typename OT>
+constexpr auto
+operator==(matrix<ET, OT> const& x, matrix<ET, OT> const& y) -> bool
+{
+    return x.engine == y.engine;
+}
+
+template <typename ET, typename OT>
+constexpr auto
+first(matrix<ET, OT>& x) -> Cursor_type<matrix<ET, OT>>
+{
+    return first(x.engine);
+}
+
+template <typename ET, typename OT>
+constexpr auto
+first(matrix<ET, OT> const& x) -> Cursor_type<matrix<ET, OT> const>
+{
+    return first(x.engine);
+}
+
+template <typename ET, typename OT>
+constexpr auto
+limit(matrix<ET, OT>& x) -> Cursor_type<matrix<ET, OT>>
+{
+    return limit(x.engine);
+}
+
+template <typename ET, typename OT>
+constexpr auto
+limit(matrix<ET, OT> const& x) -> Cursor_type<matrix<ET, OT> const>
+{
+    return limit(x.engine);
+}
+
+template <typename ET, typename OT>
+constexpr auto
+rows(matrix<ET, OT> const& x) -> pointer_diff
+{
+    return rows(x.engine);
+}
+
+template <typename ET, typename OT>
+constexpr auto
+columns(matrix<ET, OT> const& x) -> pointer_diff
+{
+    return columns(x.engine);
+}
+
+template <typename T, pointer_diff r, pointer_diff c, typename L = row_major>
+using static_matrix = matrix<static_matrix_engine<T, r, c, L>, matrix_operation_t>;
+
+template <typename T, typename L = row_major, Invocable auto alloc = array_allocator<T>>
+using dynamic_matrix = matrix<dynamic_matrix_engine<T, L, alloc>, matrix_operation_t>;
+
+template <typename T>
+struct matrix_view
+{
+    // The element (i, j) is at p[i * row_stride + j * column_stride], which
+    // describes either layout and any block of a matrix without copying it
+    Pointer_type<T> p{};
+    pointer_diff rows{};
+    pointer_diff columns{};
+    pointer_diff row_stride{};
+    pointer_diff column_stride{};
+
+    constexpr auto
+    operator()(pointer_diff i, pointer_diff j) const -> T&
+    {
+        return p[i * row_stride + j * column_stride];
+    }
+};
+
+template <typename T>
+constexpr auto
+submatrix(matrix_view<T> x, pointer_diff i, pointer_diff j, pointer_diff rows, pointer_diff columns) -> matrix_view<T>
+//[[expects: i + rows <= x.rows and j + columns <= x.columns]]
+{
+    return {pointer_to(x(i, j)), rows, columns, x.row_stride, x.column_stride};
+}
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+constexpr auto
+view(static_matrix_engine<T, r, c, L>& x) -> matrix_view<T>
+{
+    return {first(x), r, c, matrix_row_stride<L>(r, c), matrix_column_stride<L>(r, c)};
+}
+
+template <typename T, pointer_diff r, pointer_diff c, typename L>
+constexpr auto
+view(static_matrix_engine<T, r, c, L> const& x) -> matrix_view<T const>
+{
+    return {first(x), r, c, matrix_row_stride<L>(r, c), matrix_column_stride<L>(r, c)};
+}
+
+template <typename T, typename L, Invocable auto alloc>
+constexpr auto
+view(dynamic_matrix_engine<T, L, alloc>& x) -> matrix_view<T>
+{
+    auto m = x.row_count;
+    auto n = x.column_count;
+    return {first(x), m, n, matrix_row_stride<L>(m, n), matrix_column_stride<L>(m, n)};
+}
+
+template <typename T, typename L, Invocable auto alloc>
+constexpr auto
+view(dynamic_matrix_engine<T, L, alloc> const& x) -> matrix_view<T const>
+{
+    auto m = x.row_count;
+    auto n = x.column_count;
+    return {first(x), m, n, matrix_row_stride<L>(m, n), matrix_column_stride<L>(m, n)};
+}
+
+template <typename ET, typename OT>
+constexpr auto
+view(matrix<ET, OT>& x)
+{
+    return view(x.engine);
+}
+
+template <typename ET, typename OT>
+constexpr auto
+view(matrix<ET, OT> const& x)
+{
+    return view(x.engine);
+}
+
+// The product is computed by the loop structure of Goto and van de Geijn: a
+// depth block of b is packed into panels of kernel_columns columns that stay
+// in the L3 cache, a row block of a into panels of kernel_rows rows that stay
+// in the L2 cache, and the micro-kernel keeps a kernel_rows by kernel_columns
+// tile of the product in registers while streaming one panel of each.
+
+template <typename T>
+inline constexpr pointer_diff matrix_kernel_rows = 4;
+
+template <typename T>
+inline constexpr pointer_diff matrix_kernel_columns = 8;
+
+#if defined(__AVX2__) and defined(__FMA__)
+
+template <>
+inline constexpr pointer_diff matrix_kernel_rows<double> = 6;
+
+#endif
+
+inline constexpr pointer_diff matrix_block_rows = 96;
+
+inline constexpr pointer_diff matrix_block_depth = 256;
+
+inline constexpr pointer_diff matrix_block_columns = 2048;
+
+inline constexpr pointer_diff matrix_blocking_threshold = 32768;
+
+inline constexpr pointer_diff matrix_parallel_grain = 128;
+
+template <typename T>
+void
+pack_matrix_rows(matrix_view<T const> x, pointer_diff mr, Pointer_type<T> dst)
+// Copies x into panels of mr rows, each stored column by column, padding the
+// last panel with zeros
+{
+    for (pointer_diff i = 0; i < x.rows; i = i + mr) {
+        auto h = min(mr, x.rows - i);
+        for (pointer_diff p = 0; p < x.columns; ++p) {
+            for (pointer_diff r = 0; r < mr; ++r) {
+                at(dst) = r < h ? x(i + r, p) : Zero<T>;
+                increment(dst);
+            }
+        }
+    }
+}
+
+template <typename T>
+void
+pack_matrix_columns(matrix_view<T const> x, pointer_diff nr, Pointer_type<T> dst)
+// Copies x into panels of nr columns, each stored row by row, padding the
+// last panel with zeros
+{
+    for (pointer_diff j = 0; j < x.columns; j = j + nr) {
+        auto w = min(nr, x.columns - j);
+        for (pointer_diff p = 0; p < x.rows; ++p) {
+            for (pointer_diff c = 0; c < nr; ++c) {
+                at(dst) = c < w ? x(p, j + c) : Zero<T>;
+                increment(dst);
+            }
+        }
+    }
+}
+
+#if defined(__AVX2__) and defined(__FMA__)
+
+inline void
+multiply_matrix_kernel_fma(pointer_diff kc, Pointer_type<double const> a, Pointer_type<double const> b, Pointer_type<double> z)
+// Holds the 6 by 8 tile in twelve registers; each step loads a row of the
+// b panel into two of them and broadcasts each element of a column of the
+// a panel
+{
+    __m256d t[12];
+    for (auto& x : t) x = _mm256_setzero_pd();
+    for (pointer_diff p = 0; p < kc; ++p) {
+        auto b0 = _mm256_loadu_pd(b);
+        auto b1 = _mm256_loadu_pd(b + 4);
+        for (pointer_diff r = 0; r < 6; ++r) {
+            auto x = _mm256_broadcast_sd(a + r);
+            t[twice(r)] = _mm256_fmadd_pd(x, b0, t[twice(r)]);
+            t[successor(twice(r))] = _mm256_fmadd_pd(x, b1, t[successor(twice(r))]);
+        }
+        a = a + 6;
+        b = b + 8;
+    }
+    for (pointer_diff r = 0; r < 6; ++r) {
+        _mm256_storeu_pd(z + 8 * r, t[twice(r)]);
+        _mm256_storeu_pd(z + 8 * r + 4, t[successor(twice(r))]);
+    }
+}
+
+#endif
+
+template <typename T>
+void
+multiply_matrix_kernel(pointer_diff kc, Pointer_type<T const> a, Pointer_type<T const> b, Pointer_type<T> z)
+// Stores the product of a packed panel of a and a packed panel of b, both of
+// depth kc, as a row-major tile of matrix_kernel_rows<T> by
+// matrix_kernel_columns<T> in z
+{
+    constexpr auto mr = matrix_kernel_rows<T>;
+    constexpr auto nr = matrix_kernel_columns<T>;
+#if defined(__AVX2__) and defined(__FMA__)
+    if constexpr (Same_as<T, double>) {
+        multiply_matrix_kernel_fma(kc, a, b, z);
+        return;
+    }
+#endif
+    T t[mr * nr];
+    for (auto& x : t) x = Zero<T>;
+    for (pointer_diff p = 0; p < kc; ++p) {
+        for (pointer_diff r = 0; r < mr; ++r) {
+            for (pointer_diff c = 0; c < nr; ++c) t[r * nr + c] = t[r * nr + c] + a[r] * b[c];
+        }
+        a = a + mr;
+        b = b + nr;
+    }
+    for (pointer_diff i = 0; i < mr * nr; ++i) z[i] = t[i];
+}
+
+template <typename T>
+void
+multiply_matrix_naive(matrix_view<T const> a, matrix_view<T const> b, matrix_view<T> c)
+//[[expects: a.columns == b.rows and c.rows == a.rows and c.columns == b.columns]]
+// c += a b
+{
+    for (pointer_diff i = 0; i < a.rows; ++i) {
+        for (pointer_diff p = 0; p < a.columns; ++p) {
+            auto x = a(i, p);
+            for (pointer_diff j = 0; j < b.columns; ++j) c(i, j) = c(i, j) + x * b(p, j);
+        }
+    }
+}
+
+template <typename T>
+void
+multiply_matrix_blocked(matrix_view<T const> a, matrix_view<T const> b, matrix_view<T> c)
+//[[expects: a.columns == b.rows and c.rows == a.rows and c.columns == b.columns]]
+// c += a b
+{
+    constexpr auto mr = matrix_kernel_rows<T>;
+    constexpr auto nr = matrix_kernel_columns<T>;
+    auto m = a.rows;
+    auto k = a.columns;
+    auto n = b.columns;
+    auto round_up = [](pointer_diff x, pointer_diff y){ return (x + y - 1) / y * y; };
+    auto kc_max = min(k, matrix_block_depth);
+    array_single_ended<T> a_packed(round_up(min(m, matrix_block_rows), mr) * kc_max, Zero<T>);
+    array_single_ended<T> b_packed(round_up(min(n, matrix_block_columns), nr) * kc_max, Zero<T>);
+    auto ap = first(a_packed);
+    auto bp = first(b_packed);
+    T tile[mr * nr];
+    for (pointer_diff jc = 0; jc < n; jc = jc + matrix_block_columns) {
+        auto nc = min(matrix_block_columns, n - jc);
+        for (pointer_diff pc = 0; pc < k; pc = pc + matrix_block_depth) {
+            auto kc = min(matrix_block_depth, k - pc);
+            pack_matrix_columns(submatrix(b, pc, jc, kc, nc), nr, bp);
+            for (pointer_diff ic = 0; ic < m; ic = ic + matrix_block_rows) {
+                auto mc = min(matrix_block_rows, m - ic);
+                pack_matrix_rows(submatrix(a, ic, pc, mc, kc), mr, ap);
+                for (pointer_diff jr = 0; jr < nc; jr = jr + nr) {
+                    for (pointer_diff ir = 0; ir < mc; ir = ir + mr) {
+                        multiply_matrix_kernel<T>(kc, ap + ir * kc, bp + jr * kc, tile);
+                        auto h = min(mr, mc - ir);
+                        auto w = min(nr, nc - jr);
+                        for (pointer_diff i = 0; i < h; ++i) {
+                            for (pointer_diff j = 0; j < w; ++j) {
+                                auto& x = c(ic + ir + i, jc + jr + j);
+                                x = x + tile[i * nr + j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+void
+multiply_matrix_parallel(matrix_view<T const> a, matrix_view<T const> b, matrix_view<T> c, pointer_diff workers = hardware_concurrency())
+//[[expects: a.columns == b.rows and c.rows == a.rows and c.columns == b.columns]]
+// c += a b, with each worker computing a range of columns of c, aligned to
+// the kernel width, into its own packing buffers
+{
+    constexpr auto nr = matrix_kernel_columns<T>;
+    auto n = c.columns;
+    auto w = parallel_workers(n, matrix_parallel_grain, workers);
+    auto panels = (n + nr - 1) / nr;
+    for_each_worker(w, [=](pointer_diff i){
+        auto j0 = min(n, panels * i / w * nr);
+        auto j1 = min(n, panels * successor(i) / w * nr);
+        if (j0 == j1) return;
+        multiply_matrix_blocked(a, submatrix(b, 0, j0, b.rows, j1 - j0), submatrix(c, 0, j0, c.rows, j1 - j0));
+    });
+}
+
+template <typename T>
+void
+multiply_matrix(matrix_view<T const> a, matrix_view<T const> b, matrix_view<T> c, pointer_diff workers = hardware_concurrency())
+//[[expects: a.columns == b.rows and c.rows == a.rows and c.columns == b.columns]]
+// c += a b, without packing products too small to amortize it
+{
+    if (a.rows * a.columns * b.columns < matrix_blocking_threshold) multiply_matrix_naive(a, b, c);
+    else multiply_matrix_parallel(a, b, c, workers);
+}
+
+template <typename OT, typename T0, typename T1, pointer_diff r, pointer_diff k, pointer_diff c, typename L0, typename L1>
+struct matrix_multiplication_engine_t<OT, static_matrix_engine<T0, r, k, L0>, static_matrix_engine<T1, k, c, L1>>
+{
+    using scalar_t = Matrix_multiplication_scalar_t_type<OT, T0, T1>;
+    using engine_type = static_matrix_engine<typename scalar_t::type, r, c, L0>;
+};
+
+template <typename OT, typename T0, typename L0, Invocable auto alloc0, typename T1, typename L1, Invocable auto alloc1>
+struct matrix_multiplication_engine_t<OT, dynamic_matrix_engine<T0, L0, alloc0>, dynamic_matrix_engine<T1, L1, alloc1>>
+{
+    using scalar_t = Matrix_multiplication_scalar_t_type<OT, T0, T1>;
+    using engine_type = dynamic_matrix_engine<typename scalar_t::type, L0>;
+};
+
+template <typename OT, typename ET0, typename OT0, typename ET1, typename OT1>
+struct matrix_multiplication_t<OT, matrix<ET0, OT0>, matrix<ET1, OT1>>
+{
+    using engine_type = Matrix_multiplication_engine_type<OT, ET0, ET1>;
+    using op_t = OT;
+    using return_type = matrix<engine_type, op_t>;
+
+    static auto
+    mul(matrix<ET0, OT0> const& x, matrix<ET1, OT1> const& y) -> return_type
+    //[[expects: columns(x) == rows(y)]]
+    {
+        return_type z(rows(x), columns(y), Zero<Scalar_type<engine_type>>);
+        multiply_matrix(view(x), view(y), view(z));
+        return z;
+    }
+};
+
+template <typename ET0, typename OT0, typename ET1, typename OT1>
+inline auto
+operator*(matrix<ET0, OT0> const& x, matrix<ET1, OT1> const& y)
+{
+    return Matrix_multiplication_t_type<Matrix_operation_selector_type<OT0, OT1>, matrix<ET0, OT0>, matrix<ET1, OT1>>::mul(x, y);
+}
+
+template <typename OT, typename ET0, typename OT0, typename ET1, typename OT1>
+struct matrix_multiplication_t<OT, matrix<ET0, OT0>, vector<ET1, OT1>>
+{
+    using scalar_type = typename Matrix_multiplication_scalar_t_type<OT, Scalar_type<ET0>, Scalar_type<ET1>>::type;
+    using op_t = OT;
+    using return_type = vector<dynamic_vector_engine<scalar_type, array_allocator<scalar_type>>, op_t>;
+
+    static auto
+    mul(matrix<ET0, OT0> const& x, vector<ET1, OT1> const& y) -> return_type
+    //[[expects: columns(x) == size(y)]]
+    // Treats y as a matrix of one column, for which packing does not pay off
+    {
+        return_type z(rows(x), Zero<scalar_type>);
+        multiply_matrix_naive(
+            view(x),
+            matrix_view<Scalar_type<ET1> const>{first(y), size(y), 1, 1, 0},
+            matrix_view<scalar_type>{first(z), rows(x), 1, 1, 0});
+        return z;
+    }
+};
+
+template <typename ET0, typename OT0, typename ET1, typename OT1>
+inline auto
+operator*(matrix<ET0, OT0> const& x, vector<ET1, OT1> const& y)
+{
+    return Matrix_multiplication_t_type<Matrix_operation_selector_type<OT0, OT1>, matrix<ET0, OT0>, vector<ET1, OT1>>::mul(x, y);
+}
+
 }
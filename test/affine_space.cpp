@@ -64,3 +64,97 @@ SCENARIO ("Using points", "[point]")
         REQUIRE (e::quadrance(p0, p2) == 25);
     }
 }
+
+SCENARIO ("Using point clouds", "[point_cloud]")
+{
+    e::pointer_diff n = 1000;
+    e::point_cloud<double, 3> x(n);
+    for (e::pointer_diff i = 0; i < n; ++i) {
+        e::point<double, 3> p;
+        p(0) = static_cast<double>(i % 17);
+        p(1) = static_cast<double>(i % 29) - 10.0;
+        p(2) = static_cast<double>((i * 7) % 13);
+        e::push(x, p);
+    }
+    e::point<double, 3> origin;
+    origin(0) = 3.0;
+    origin(1) = -2.0;
+    origin(2) = 5.0;
+
+    REQUIRE (e::size(x) == n);
+    REQUIRE (x(20)(0) == 3.0);
+    REQUIRE (x(20)(1) == 10.0);
+
+    SECTION ("Quadrances")
+    {
+        e::array_single_ended<double> q(n, 0.0);
+        e::quadrances(x, origin, e::first(q));
+        for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (q[i] == e::quadrance(x(i), origin));
+
+        auto y = x;
+        e::store(y, 5, origin);
+        REQUIRE (y(5) == origin);
+        e::quadrances(x, y, e::first(q));
+        REQUIRE (q[5] == e::quadrance(x(5), origin));
+        REQUIRE (q[6] == 0.0);
+    }
+
+    SECTION ("Translations and affine transformations")
+    {
+        e::static_vector<double, 3> v;
+        v(0) = 1.0;
+        v(1) = -1.0;
+        v(2) = 0.5;
+        auto y = x;
+        e::translate(y, v);
+        REQUIRE (y(123) == x(123) + v);
+
+        e::static_matrix<double, 3, 3> a;
+        a(0, 1) = -1.0;
+        a(1, 0) = 1.0;
+        a(2, 2) = 2.0;
+        auto z = x;
+        e::transform(z, a, v);
+        for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::transform(x(i), a, v));
+        REQUIRE (z(20)(0) == -10.0 + 1.0);
+        REQUIRE (z(20)(1) == 3.0 - 1.0);
+    }
+
+    SECTION ("Nearest neighbours")
+    {
+        for (e::pointer_diff m : {0, 1, 5, 40}) {
+            e::array_single_ended<e::pointer_diff> nearest(m, 0);
+            REQUIRE (e::nearest_neighbours(x, origin, m, e::first(nearest)) == m);
+
+            // The expected indices are selected by repeatedly taking the least
+            // remaining quadrance, preferring the lower index
+            e::array_single_ended<bool> taken(n, false);
+            for (e::pointer_diff j = 0; j < m; ++j) {
+                e::pointer_diff best = -1;
+                for (e::pointer_diff i = 0; i < n; ++i) {
+                    if (!taken[i] and (best < 0 or e::quadrance(x(i), origin) < e::quadrance(x(best), origin))) best = i;
+                }
+                taken[best] = true;
+                REQUIRE (nearest[j] == best);
+            }
+        }
+
+        e::point_cloud<double, 3> few;
+        e::push(few, origin);
+        e::array_single_ended<e::pointer_diff> nearest(3, -1);
+        REQUIRE (e::nearest_neighbours(few, origin, 3, e::first(nearest)) == 1);
+        REQUIRE (nearest[0] == 0);
+
+        e::point_cloud<double, 3> queries;
+        for (e::pointer_diff i = 0; i < 50; ++i) e::push(queries, x(i * 13));
+        for (e::pointer_diff workers : {1, 3}) {
+            e::array_single_ended<e::pointer_diff> all(50 * 4, 0);
+            e::nearest_neighbours(x, queries, 4, e::first(all), workers);
+            for (e::pointer_diff i = 0; i < 50; ++i) {
+                e::pointer_diff expected[4];
+                e::nearest_neighbours(x, queries(i), 4, expected);
+                for (e::pointer_diff j = 0; j < 4; ++j) REQUIRE (all[i * 4 + j] == expected[j]);
+            }
+        }
+    }
+}
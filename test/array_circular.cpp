@@ -307,6 +307,90 @@ SCENARIO ("Using circular array", "[array_circular]")
         REQUIRE (e::limit(x0) - e::first(x0) == 0);
     }
 
+    SECTION ("Two-segment view")
+    {
+        auto seg = e::segments(x);
+        REQUIRE (e::size(seg.m0) == 5);
+        REQUIRE (e::is_empty(seg.m1));
+
+        e::pop_first(x);
+        e::pop_first(x);
+        e::push(x, 5);
+        e::push(x, 6);
+        seg = e::segments(x);
+        REQUIRE (e::size(seg.m0) == 3);
+        REQUIRE (e::size(seg.m1) == 2);
+        CHECK (seg.m0[0] == 2);
+        CHECK (seg.m0[2] == 4);
+        CHECK (seg.m1[0] == 5);
+        CHECK (seg.m1[1] == 6);
+
+        e::array_circular<int> const& y = x;
+        auto const_seg = e::segments(y);
+        REQUIRE (e::size(const_seg.m0) + e::size(const_seg.m1) == e::size(y));
+
+        e::array_circular<int> z;
+        seg = e::segments(z);
+        REQUIRE (e::is_empty(seg.m0));
+        REQUIRE (e::is_empty(seg.m1));
+    }
+
+    SECTION ("Bulk operations")
+    {
+        int src[7] = {5, 6, 7, 8, 9, 10, 11};
+        int dst[12] = {};
+
+        e::pop_n(x, 3);
+        REQUIRE (e::size(x) == 2);
+        CHECK (x[0] == 3);
+        CHECK (x[1] == 4);
+
+        auto cur = e::push_n(x, src, 3);
+        REQUIRE (cur == src + 3);
+        REQUIRE (e::size(x) == 5);
+        REQUIRE (e::capacity(x) == 5);
+        REQUIRE (!e::is_empty(e::segments(x).m1));
+        REQUIRE (e::copy_out(x, dst) == dst + 5);
+        CHECK (dst[0] == 3);
+        CHECK (dst[1] == 4);
+        CHECK (dst[2] == 5);
+        CHECK (dst[3] == 6);
+        CHECK (dst[4] == 7);
+
+        e::push_n(x, cur, 4);
+        REQUIRE (e::size(x) == 9);
+        REQUIRE (e::capacity(x) == 10);
+        for (int i = 0; i < 9; ++i) CHECK (x[i] == i + 3);
+
+        REQUIRE (e::copy_out(x, 4, dst) == dst + 4);
+        e::pop_n(x, 4);
+        REQUIRE (e::size(x) == 5);
+        CHECK (dst[3] == 6);
+        CHECK (x[0] == 7);
+
+        int const more[4] = {12, 13, 14, 15};
+        e::push_n(x, more, 4);
+        auto seg = e::segments(x);
+        REQUIRE (e::size(seg.m0) == 6);
+        REQUIRE (e::size(seg.m1) == 3);
+        REQUIRE (e::copy_out(x, dst) == dst + 9);
+        for (int i = 0; i < 9; ++i) CHECK (dst[i] == i + 7);
+
+        e::pop_n(x, 9);
+        REQUIRE (e::is_empty(x));
+        REQUIRE (e::capacity(x) == 0);
+
+        e::array_circular<e::array_circular<int>> y;
+        e::array_circular<int> elems[2] = {x, x};
+        e::push(elems[1], 1);
+        e::push_n(y, elems, 2);
+        REQUIRE (e::size(y) == 2);
+        REQUIRE (e::is_empty(y[0]));
+        REQUIRE (y[1][0] == 1);
+        e::pop_n(y, 1);
+        REQUIRE (e::size(y[0]) == 1);
+    }
+
     SECTION ("Monadic interface")
     {
         auto fn0 = [](int const& i){
@@ -308,6 +308,12 @@ SCENARIO ("Using double-ended array", "[array_double_ended]")
         REQUIRE (e::capacity(x0) == 0);
         REQUIRE (e::limit(x0) - e::first(x0) == 0);
         REQUIRE (e::limit_of_storage(x0) - e::first(x0) == 0);
+
+        e::push_first(x0, 1);
+        e::push_first(x0, 0);
+        REQUIRE (e::size(x0) == 2);
+        CHECK (x0[0] == 0);
+        CHECK (x0[1] == 1);
     }
 
     SECTION ("Monadic interface")
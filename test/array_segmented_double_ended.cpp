@@ -227,6 +227,55 @@ SCENARIO ("Using segmented double-ended array", "[array_segmented_double_ended]"
         REQUIRE (y[6] == 3);
     }
 
+    SECTION ("Recycling segments")
+    {
+        e::array_segmented_double_ended<int, 4> y;
+        for (int i = 0; i < 8; ++i) e::push(y, i);
+
+        REQUIRE (e::size(y) == 8);
+        REQUIRE (y.pool_size == 0);
+
+        auto storage = e::first_of_storage(e::load(e::first(y.index)));
+        e::pop_first(y);
+        e::pop_first(y);
+
+        REQUIRE (e::size(y) == 6);
+        REQUIRE (y.pool_size == 1);
+        REQUIRE (y[0] == 2);
+
+        e::push(y, 8);
+        e::push(y, 9);
+        e::push(y, 10);
+
+        REQUIRE (e::size(y) == 9);
+        REQUIRE (y.pool_size == 0);
+        REQUIRE (e::first_of_storage(e::load(e::predecessor(e::limit(y.index)))) == storage);
+        REQUIRE (y[8] == 10);
+
+        int next = 11;
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE (e::load(e::first(y)) == next - 9);
+            e::pop_first(y);
+            e::push(y, next);
+            ++next;
+            REQUIRE (e::size(y) == 9);
+            REQUIRE (e::capacity(y.index) <= 4);
+        }
+
+        while (!e::is_empty(y)) e::pop_first(y);
+
+        REQUIRE (e::size(y) == 0);
+        REQUIRE (y.pool_size == 1);
+
+        e::push_first(y, 0);
+        e::push(y, 1);
+
+        REQUIRE (e::size(y) == 2);
+        REQUIRE (y.pool_size == 0);
+        REQUIRE (y[0] == 0);
+        REQUIRE (y[1] == 1);
+    }
+
     SECTION ("Monadic interface")
     {
         auto fn0 = [](int const& i){
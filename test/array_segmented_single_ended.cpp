@@ -164,6 +164,37 @@ SCENARIO ("Using segmented single-ended array", "[array_segmented_single_ended]"
         }
     }
 
+    SECTION ("Recycling segments")
+    {
+        e::array_segmented_single_ended<int, 2> y;
+        for (int i = 0; i < 5; ++i) e::push(y, i);
+
+        REQUIRE (y.pool_size == 0);
+
+        auto storage = e::first(e::load(e::predecessor(e::limit(y.index))));
+        e::pop(y);
+
+        REQUIRE (e::size(y) == 4);
+        REQUIRE (y.pool_size == 1);
+
+        e::push(y, 5);
+
+        REQUIRE (e::size(y) == 5);
+        REQUIRE (y.pool_size == 0);
+        REQUIRE (e::first(e::load(e::predecessor(e::limit(y.index)))) == storage);
+        REQUIRE (y[4] == 5);
+
+        while (!e::is_empty(y)) e::pop(y);
+
+        REQUIRE (y.pool_size == 1);
+
+        e::push(y, 6);
+
+        REQUIRE (y.pool_size == 0);
+        REQUIRE (e::first(e::load(e::first(y.index))) == storage);
+        REQUIRE (y[0] == 6);
+    }
+
     SECTION ("Monadic interface")
     {
         auto fn0 = [](int const& i){
@@ -0,0 +1,90 @@
+#include "catch.hpp"
+
+#include <string>
+
+#include "binary_counter.h"
+#include "reduce.h"
+
+namespace e = elements;
+
+struct expression
+{
+    std::string s;
+};
+
+auto operator==(expression const& x, expression const& y) -> bool
+{
+    return x.s == y.s;
+}
+
+template <typename T, typename Op>
+auto flush(e::binary_counter<T, Op>& counter) -> T
+{
+    e::transpose_op<T, Op> transposed_op(counter.op);
+    return e::reduce_nonzeroes(e::first(counter), e::limit(counter), transposed_op, counter.zero);
+}
+
+SCENARIO ("Binary counter", "[binary_counter]")
+{
+    auto tree = [](expression const& x, expression const& y){ return expression{"(" + x.s + y.s + ")"}; };
+    using tree_op = decltype(tree);
+
+    SECTION ("Adding elements")
+    {
+        e::binary_counter<expression, tree_op> counter(tree, {});
+
+        REQUIRE (e::is_empty(counter));
+
+        counter({"a"});
+        counter({"b"});
+        counter({"c"});
+
+        REQUIRE (!e::is_empty(counter));
+        REQUIRE (counter.occupied == 3);
+        REQUIRE (e::size(counter) == 2);
+        REQUIRE (flush(counter).s == "((ab)c)");
+    }
+
+    SECTION ("Adding ranges")
+    {
+        expression x[21];
+        for (int i = 0; i < 21; ++i) x[i].s = std::string(1, static_cast<char>('a' + i));
+
+        for (int m = 0; m <= 21; ++m) {
+            for (int i = 0; i <= m; ++i) {
+                e::binary_counter<expression, tree_op> single(tree, {});
+                e::binary_counter<expression, tree_op> batched(tree, {});
+                for (int j = 0; j < m; ++j) single(x[j]);
+                for (int j = 0; j < i; ++j) batched(x[j]);
+                batched(x + i, x + m);
+
+                REQUIRE (batched.occupied == single.occupied);
+                REQUIRE (flush(batched).s == flush(single).s);
+            }
+        }
+    }
+
+    SECTION ("Adding arithmetic ranges")
+    {
+        double x[1000];
+        for (int i = 0; i < 1000; ++i) x[i] = 1.0 / (i + 1);
+        auto add = [](double const& a, double const& b){ return a + b; };
+        using add_op = decltype(add);
+
+        for (int i : {0, 1, 3, 8, 13}) {
+            e::binary_counter<double, add_op> single(add, 0.0);
+            e::binary_counter<double, add_op> batched(add, 0.0);
+            for (int j = 0; j < 1000; ++j) single(x[j]);
+            for (int j = 0; j < i; ++j) batched(x[j]);
+            batched(static_cast<double const*>(x) + i, static_cast<double const*>(x) + 1000);
+
+            REQUIRE (batched.occupied == single.occupied);
+            REQUIRE (flush(batched) == flush(single));
+        }
+
+        e::binary_counter<double, add_op> mutable_range(add, 0.0);
+        mutable_range(x, x + 1000);
+
+        REQUIRE (mutable_range.occupied == 1000);
+    }
+}
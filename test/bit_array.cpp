@@ -0,0 +1,154 @@
+#include "catch.hpp"
+
+#include "bit_array.h"
+
+namespace e = elements;
+
+SCENARIO ("Using bit arrays", "[bit_array]")
+{
+    SECTION ("Construction, access and cursors")
+    {
+        e::bit_array<> x(70, e::bit{1});
+        REQUIRE (e::size(x) == 70);
+        REQUIRE (e::popcount(x) == 70);
+        e::store(x, 3, e::bit{0});
+        e::store(x, 69, e::bit{0});
+        REQUIRE (x(3) == e::bit{0});
+        REQUIRE (x(4) == e::bit{1});
+        REQUIRE (e::popcount(x) == 68);
+
+        e::bit_array<> y;
+        for (e::pointer_diff i = 0; i < 70; ++i) e::push(y, x(i));
+        REQUIRE (y == x);
+        REQUIRE (e::is_empty(e::bit_array<>{}));
+
+        auto cur = e::first(x);
+        auto ones = 0;
+        while (e::precedes(cur, e::limit(x))) {
+            if (e::load(cur).v) ++ones;
+            e::increment(cur);
+        }
+        REQUIRE (ones == 68);
+        REQUIRE (e::limit(x) - e::first(x) == 70);
+        cur = e::first(x) + 3;
+        e::store(cur, e::bit{1});
+        REQUIRE (x(3) == e::bit{1});
+        REQUIRE (e::load(cur) == e::bit{1});
+    }
+
+    SECTION ("Connectives")
+    {
+        for (e::pointer_diff n : {0, 1, 63, 64, 65, 1000}) {
+            e::bit_array<> x(n);
+            e::bit_array<> y(n);
+            for (e::pointer_diff i = 0; i < n; ++i) {
+                e::store(x, i, e::bit{(i * 3 + i / 7) % 5 == 0});
+                e::store(y, i, e::bit{(i * 11 + i / 7) % 3 == 0});
+            }
+            e::bit_array<> z(n);
+
+            e::map_bits(x, y, z, e::contradiction);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::contradiction(x(i), y(i)));
+            e::map_bits(x, y, z, e::conjunction);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::conjunction(x(i), y(i)));
+            e::map_bits(x, y, z, e::nonimplication);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::nonimplication(x(i), y(i)));
+            e::map_bits(x, y, z, e::projection_left);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::projection_left(x(i), y(i)));
+            e::map_bits(x, y, z, e::converse_nonimplication);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::converse_nonimplication(x(i), y(i)));
+            e::map_bits(x, y, z, e::projection_right);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::projection_right(x(i), y(i)));
+            e::map_bits(x, y, z, e::nonequivalence);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::nonequivalence(x(i), y(i)));
+            e::map_bits(x, y, z, e::disjunction);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::disjunction(x(i), y(i)));
+            e::map_bits(x, y, z, e::nondisjunction);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::nondisjunction(x(i), y(i)));
+            e::map_bits(x, y, z, e::equivalence);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::equivalence(x(i), y(i)));
+            e::map_bits(x, y, z, e::nonprojection_right);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::nonprojection_right(x(i), y(i)));
+            e::map_bits(x, y, z, e::converse_implication);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::converse_implication(x(i), y(i)));
+            e::map_bits(x, y, z, e::nonprojection_left);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::nonprojection_left(x(i), y(i)));
+            e::map_bits(x, y, z, e::implication);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::implication(x(i), y(i)));
+            e::map_bits(x, y, z, e::nonconjunction);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::nonconjunction(x(i), y(i)));
+            e::map_bits(x, y, z, e::tautology);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z(i) == e::tautology(x(i), y(i)));
+
+            REQUIRE (e::size(z) == n);
+            REQUIRE (e::popcount(z) == e::rank(z, n));
+        }
+
+        e::bit_array<> x(200);
+        e::bit_array<> y(200);
+        for (e::pointer_diff i = 0; i < 200; ++i) {
+            e::store(x, i, e::bit{(i * 3 + i / 7) % 5 == 0});
+            e::store(y, i, e::bit{(i * 11 + i / 7) % 3 == 0});
+        }
+        auto z = x;
+        e::map_bits(z, y, z, e::disjunction);
+        auto w = x;
+        e::map_bits(x, y, w, e::disjunction);
+        REQUIRE (z == w);
+    }
+
+    SECTION ("Counting, searching, rank and select")
+    {
+        e::bit_array<> x(5000);
+        for (e::pointer_diff i = 0; i < 5000; ++i) e::store(x, i, e::bit{(i * 7 + i / 7) % 13 == 0});
+        e::store(x, 4999, e::bit{1});
+        e::pointer_diff count = 0;
+        for (e::pointer_diff i = 0; i < e::size(x); ++i) {
+            REQUIRE (e::rank(x, i) == count);
+            if (x(i).v) {
+                REQUIRE (e::select(x, count) == i);
+                ++count;
+            }
+        }
+        REQUIRE (e::popcount(x) == count);
+        REQUIRE (e::rank(x, e::size(x)) == count);
+
+        auto i = e::find_first_set(x);
+        auto visited = 0;
+        while (i < e::size(x)) {
+            REQUIRE (e::select(x, visited) == i);
+            ++visited;
+            i = e::find_first_set(x, i + 1);
+        }
+        REQUIRE (visited == count);
+
+        e::bit_array<> sparse(4000);
+        REQUIRE (e::find_first_set(sparse) == 4000);
+        e::store(sparse, 3001, e::bit{1});
+        REQUIRE (e::find_first_set(sparse) == 3001);
+        REQUIRE (e::find_first_set(sparse, 3001) == 3001);
+        REQUIRE (e::find_first_set(sparse, 3002) == 4000);
+        REQUIRE (e::find_first_set(sparse, 4000) == 4000);
+    }
+
+    SECTION ("Rank and select dictionaries")
+    {
+        for (e::pointer_diff n : {0, 100, 512, 70000, 200003}) {
+            for (e::pointer_diff b : {3, 1000}) {
+                e::bit_array<> x(n);
+                for (e::pointer_diff i = 0; i < n; ++i) e::store(x, i, e::bit{(i * 7 + i / 7) % b == 0});
+                e::rank_select<> y(x);
+                REQUIRE (e::size(y) == n);
+                REQUIRE (e::popcount(y) == e::popcount(x));
+                for (e::pointer_diff i = 0; i <= n; i = i + 1 + i % 61) {
+                    REQUIRE (e::rank(y, i) == e::rank(x, i));
+                }
+                REQUIRE (e::rank(y, n) == e::rank(x, n));
+                for (e::pointer_diff j = 0; j < e::popcount(x); j = j + 1 + j % 37) {
+                    REQUIRE (e::select(y, j) == e::select(x, j));
+                }
+                if (!e::is_zero(e::popcount(y))) REQUIRE (e::select(y, e::popcount(y) - 1) == e::select(x, e::popcount(x) - 1));
+            }
+        }
+    }
+}
@@ -0,0 +1,141 @@
+#include "catch.hpp"
+
+#include <thread>
+
+#include "array_single_ended.h"
+#include "complexity.h"
+#include "search_binary.h"
+
+namespace e = elements;
+
+using instrumented_array = e::array_single_ended<e::instrumented<int>>;
+
+auto make_instrumented(e::pointer_diff n) -> instrumented_array
+{
+    instrumented_array x;
+    e::reserve(x, n);
+    for (e::pointer_diff i = 0; i < n; ++i) {
+        e::instrumented<int> y;
+        y.value = static_cast<int>(i);
+        e::push(x, y);
+    }
+    return x;
+}
+
+void compare_all(e::instrumented<int> const* f, e::instrumented<int> const* l)
+{
+    auto const* i = f;
+    while (i != l) {
+        auto const* j = f;
+        while (j != l) {
+            (void)(*i < *j);
+            ++j;
+        }
+        ++i;
+    }
+}
+
+void compare_adjacent(e::instrumented<int> const* f, e::instrumented<int> const* l)
+{
+    while (f != l) {
+        (void)(*f == *f);
+        ++f;
+    }
+}
+
+SCENARIO ("Operation counting", "[complexity]")
+{
+    e::pointer_diff sizes[] = {16, 32, 64, 128, 256};
+    e::operation_counts table[5];
+    auto setup = [](e::pointer_diff n){ return make_instrumented(n); };
+    using counts = e::instrumented_base;
+
+    SECTION ("Measuring")
+    {
+        auto x = e::measure_operations(8, setup, [](instrumented_array& a){
+            compare_adjacent(e::first(a), e::limit(a));
+        });
+
+        REQUIRE (x.n == 8);
+        REQUIRE (x.counts[counts::n] == 8);
+        REQUIRE (x.counts[counts::equal] == 8);
+        REQUIRE (x.counts[counts::less] == 0);
+        REQUIRE (x.counts[counts::copy] == 0);
+        REQUIRE (x.ns >= 0.0);
+    }
+
+    SECTION ("Linear")
+    {
+        auto lim = e::tabulate_operations(sizes, sizes + 5, setup, [](instrumented_array& a){
+            compare_adjacent(e::first(a), e::limit(a));
+        }, table);
+
+        REQUIRE (lim == table + 5);
+        REQUIRE (table[4].n == 256);
+        REQUIRE (table[4].counts[counts::equal] == 256);
+
+        auto fit = e::fit_growth(table, lim, counts::equal);
+
+        REQUIRE (fit.model == e::complexity::linear);
+        REQUIRE (fit.coefficient == Approx(1.0));
+        REQUIRE (fit.deviation == Approx(0.0).margin(1e-9));
+
+        auto none = e::fit_growth(table, lim, counts::copy);
+
+        REQUIRE (none.model == e::complexity::constant);
+        REQUIRE (none.coefficient == 0.0);
+    }
+
+    SECTION ("Linearithmic")
+    {
+        auto lim = e::tabulate_operations(sizes, sizes + 5, setup, [](instrumented_array& a){
+            auto f = e::first(a);
+            auto l = e::limit(a);
+            for (auto i = f; i != l; ++i) {
+                e::search_binary_lower(f, l, *i);
+            }
+        }, table);
+        auto fit = e::fit_growth(table, lim, counts::less);
+
+        REQUIRE (fit.model == e::complexity::linearithmic);
+    }
+
+    SECTION ("Quadratic")
+    {
+        auto lim = e::tabulate_operations(sizes, sizes + 5, setup, [](instrumented_array& a){
+            compare_all(e::first(a), e::limit(a));
+        }, table);
+        auto fit = e::fit_growth(table, lim, counts::less);
+
+        REQUIRE (fit.model == e::complexity::quadratic);
+        REQUIRE (fit.coefficient == Approx(1.0));
+    }
+
+    SECTION ("Threads")
+    {
+        auto lim = e::tabulate_operations(sizes, sizes + 5, setup, [](instrumented_array& a){
+            auto f = e::first(a);
+            auto m = f + e::size(a) / 2;
+            auto l = e::limit(a);
+            std::thread t0{[f, m]{ compare_adjacent(f, m); }};
+            std::thread t1{[m, l]{ compare_adjacent(m, l); }};
+            t0.join();
+            t1.join();
+        }, table);
+
+        REQUIRE (table[0].counts[counts::equal] == 16);
+        REQUIRE (table[4].counts[counts::equal] == 256);
+        REQUIRE (e::fit_growth(table, lim, counts::equal).model == e::complexity::linear);
+    }
+
+    SECTION ("Regressions")
+    {
+        e::growth_fit expected{e::complexity::linear, 1.0, 0.0};
+
+        REQUIRE (!e::is_regression({e::complexity::linear, 1.05, 0.0}, expected));
+        REQUIRE (e::is_regression({e::complexity::linear, 1.2, 0.0}, expected));
+        REQUIRE (e::is_regression({e::complexity::linear, 1.05, 0.0}, expected, 0.01));
+        REQUIRE (e::is_regression({e::complexity::quadratic, 0.01, 0.0}, expected));
+        REQUIRE (!e::is_regression({e::complexity::logarithmic, 10.0, 0.0}, expected));
+    }
+}
@@ -1,6 +1,8 @@
 #include "catch.hpp"
 
+#include "array_segmented_single_ended.h"
 #include "copy.h"
+#include "list_unrolled.h"
 
 namespace e = elements;
 
@@ -22,6 +24,36 @@ SCENARIO ("Copying", "[copy]")
         CHECK (y[4] == 4);
     }
 
+    SECTION ("Copying segmented sequences to an array")
+    {
+        e::list_unrolled<int, 2> z;
+        e::array_segmented_single_ended<int, 2> w;
+        for (int i : {0, 1, 2, 3, 4}) {
+            e::push_last(z, i);
+            e::push(w, i);
+        }
+
+        auto cur = e::copy(e::successor(e::first(z)), e::last(z), y);
+
+        REQUIRE(cur == y + 3);
+
+        CHECK (y[0] == 1);
+        CHECK (y[1] == 2);
+        CHECK (y[2] == 3);
+        CHECK (y[3] == 8);
+        CHECK (y[4] == 9);
+
+        cur = e::copy(e::first(w), e::limit(w), y);
+
+        REQUIRE(cur == y + 5);
+
+        CHECK (y[0] == 0);
+        CHECK (y[1] == 1);
+        CHECK (y[2] == 2);
+        CHECK (y[3] == 3);
+        CHECK (y[4] == 4);
+    }
+
     SECTION ("Copying an array into itelf")
     {
         auto cur = e::copy(x, x + 5, x);
@@ -105,3 +137,215 @@ SCENARIO ("Copying", "[copy]")
         }
     }
 }
+
+SCENARIO ("Copying large arrays with a predicate", "[copy]")
+{
+    SECTION ("Copying 32-bit integers with a predicate")
+    {
+        int x[1000];
+        for (int i = 0; i < 1000; ++i) x[i] = (i * 37) % 1009;
+        auto pred = [](int a){ return a % 3 == 0; };
+
+        for (int n : {0, 1, 7, 8, 9, 15, 16, 17, 255, 256, 257, 1000}) {
+            int y[1016];
+            for (int i = 0; i < 1016; ++i) y[i] = -1;
+            auto cur = e::copy_if(+x, x + n, +y, pred);
+            auto k = 0;
+            for (int i = 0; i < n; ++i) {
+                if (pred(x[i])) {
+                    REQUIRE (y[k] == x[i]);
+                    ++k;
+                }
+            }
+            REQUIRE (cur == y + k);
+            for (int i = k; i < n + 16; ++i) REQUIRE (y[i] == -1);
+        }
+    }
+
+    SECTION ("Copying unsigned integers with a predicate")
+    {
+        unsigned x[1000];
+        for (int i = 0; i < 1000; ++i) x[i] = static_cast<unsigned>((i * 37) % 1009);
+        auto pred = [](unsigned a){ return a % 3 == 0; };
+
+        for (int n : {0, 1, 7, 8, 9, 15, 16, 17, 255, 256, 257, 1000}) {
+            unsigned y[1016];
+            for (int i = 0; i < 1016; ++i) y[i] = 2000u;
+            auto cur = e::copy_if(+x, x + n, +y, pred);
+            auto k = 0;
+            for (int i = 0; i < n; ++i) {
+                if (pred(x[i])) {
+                    REQUIRE (y[k] == x[i]);
+                    ++k;
+                }
+            }
+            REQUIRE (cur == y + k);
+            for (int i = k; i < n + 16; ++i) REQUIRE (y[i] == 2000u);
+        }
+    }
+
+    SECTION ("Copying single-precision numbers with a predicate")
+    {
+        float x[1000];
+        for (int i = 0; i < 1000; ++i) x[i] = static_cast<float>((i * 37) % 1009);
+        auto pred = [](float a){ return static_cast<int>(a) % 3 == 0; };
+
+        for (int n : {0, 1, 7, 8, 9, 15, 16, 17, 255, 256, 257, 1000}) {
+            float y[1016];
+            for (int i = 0; i < 1016; ++i) y[i] = -1.0f;
+            auto cur = e::copy_if(+x, x + n, +y, pred);
+            auto k = 0;
+            for (int i = 0; i < n; ++i) {
+                if (pred(x[i])) {
+                    REQUIRE (y[k] == x[i]);
+                    ++k;
+                }
+            }
+            REQUIRE (cur == y + k);
+            for (int i = k; i < n + 16; ++i) REQUIRE (y[i] == -1.0f);
+        }
+    }
+
+    SECTION ("Copying double-precision numbers with a predicate")
+    {
+        double x[1000];
+        for (int i = 0; i < 1000; ++i) x[i] = (i * 37) % 1009;
+        auto pred = [](double a){ return static_cast<int>(a) % 3 == 0; };
+
+        for (int n : {0, 1, 7, 8, 9, 15, 16, 17, 255, 256, 257, 1000}) {
+            double y[1016];
+            for (int i = 0; i < 1016; ++i) y[i] = -1.0;
+            auto cur = e::copy_if(+x, x + n, +y, pred);
+            auto k = 0;
+            for (int i = 0; i < n; ++i) {
+                if (pred(x[i])) {
+                    REQUIRE (y[k] == x[i]);
+                    ++k;
+                }
+            }
+            REQUIRE (cur == y + k);
+            for (int i = k; i < n + 16; ++i) REQUIRE (y[i] == -1.0);
+        }
+    }
+
+    SECTION ("Copying 64-bit integers with a predicate")
+    {
+        e::Z<64> x[1000];
+        for (int i = 0; i < 1000; ++i) x[i] = (i * 37) % 1009;
+        auto pred = [](e::Z<64> a){ return a % 3 == 0; };
+
+        for (int n : {0, 1, 7, 8, 9, 15, 16, 17, 255, 256, 257, 1000}) {
+            e::Z<64> y[1016];
+            for (int i = 0; i < 1016; ++i) y[i] = -1;
+            auto cur = e::copy_if(+x, x + n, +y, pred);
+            auto k = 0;
+            for (int i = 0; i < n; ++i) {
+                if (pred(x[i])) {
+                    REQUIRE (y[k] == x[i]);
+                    ++k;
+                }
+            }
+            REQUIRE (cur == y + k);
+            for (int i = k; i < n + 16; ++i) REQUIRE (y[i] == -1);
+        }
+    }
+
+    SECTION ("Copying 16-bit integers with a predicate")
+    {
+        short x[1000];
+        for (int i = 0; i < 1000; ++i) x[i] = static_cast<short>((i * 37) % 1009);
+        auto pred = [](short a){ return a % 3 == 0; };
+
+        for (int n : {0, 1, 7, 8, 9, 15, 16, 17, 255, 256, 257, 1000}) {
+            short y[1016];
+            for (int i = 0; i < 1016; ++i) y[i] = -1;
+            auto cur = e::copy_if(+x, x + n, +y, pred);
+            auto k = 0;
+            for (int i = 0; i < n; ++i) {
+                if (pred(x[i])) {
+                    REQUIRE (y[k] == x[i]);
+                    ++k;
+                }
+            }
+            REQUIRE (cur == y + k);
+            for (int i = k; i < n + 16; ++i) REQUIRE (y[i] == -1);
+        }
+    }
+
+    SECTION ("Copying characters with a predicate")
+    {
+        char x[1000];
+        for (int i = 0; i < 1000; ++i) x[i] = static_cast<char>((i * 37) % 101);
+        auto pred = [](char a){ return a % 3 == 0; };
+
+        for (int n : {0, 1, 7, 8, 9, 15, 16, 17, 255, 256, 257, 1000}) {
+            char y[1016];
+            for (int i = 0; i < 1016; ++i) y[i] = 127;
+            auto cur = e::copy_if(+x, x + n, +y, pred);
+            auto k = 0;
+            for (int i = 0; i < n; ++i) {
+                if (pred(x[i])) {
+                    REQUIRE (y[k] == x[i]);
+                    ++k;
+                }
+            }
+            REQUIRE (cur == y + k);
+            for (int i = k; i < n + 16; ++i) REQUIRE (y[i] == 127);
+        }
+    }
+
+    SECTION ("Copying 32-bit integers with a predicate that returns an integer")
+    {
+        int x[1000];
+        for (int i = 0; i < 1000; ++i) x[i] = (i * 37) % 1009;
+        auto pred = [](int const* p){ return *p & 260; };
+
+        for (int n : {0, 1, 7, 8, 9, 15, 16, 17, 255, 256, 257, 1000}) {
+            int y[1016];
+            for (int i = 0; i < 1016; ++i) y[i] = -1;
+            auto cur = e::copy_select(+x, x + n, +y, pred);
+            auto k = 0;
+            for (int i = 0; i < n; ++i) {
+                if (pred(x + i)) {
+                    REQUIRE (y[k] == x[i]);
+                    ++k;
+                }
+            }
+            REQUIRE (cur == y + k);
+            for (int i = k; i < n + 16; ++i) REQUIRE (y[i] == -1);
+        }
+    }
+
+    SECTION ("Copying 16-bit integers with a predicate that returns an integer")
+    {
+        short x[1000];
+        for (int i = 0; i < 1000; ++i) x[i] = static_cast<short>((i * 37) % 1009);
+        auto pred = [](short const* p){ return *p & 260; };
+
+        for (int n : {0, 1, 7, 8, 9, 15, 16, 17, 255, 256, 257, 1000}) {
+            short y[1016];
+            for (int i = 0; i < 1016; ++i) y[i] = -1;
+            auto cur = e::copy_select(+x, x + n, +y, pred);
+            auto k = 0;
+            for (int i = 0; i < n; ++i) {
+                if (pred(x + i)) {
+                    REQUIRE (y[k] == x[i]);
+                    ++k;
+                }
+            }
+            REQUIRE (cur == y + k);
+            for (int i = k; i < n + 16; ++i) REQUIRE (y[i] == -1);
+        }
+    }
+
+    SECTION ("Copying the elements of an array that do not satisfy a predicate into itself")
+    {
+        int x[600];
+        for (int i = 0; i < 600; ++i) x[i] = i;
+
+        auto cur = e::copy_if_not(+x, x + 600, +x, [](int a){ return a % 3 == 0; });
+
+        REQUIRE (cur == x + 400);
+        for (int i = 0; i < 400; ++i) REQUIRE (x[i] == i / 2 * 3 + 1 + i % 2);
+    }
+}
@@ -1,6 +1,8 @@
 #include "catch.hpp"
 
+#include "array_segmented_single_ended.h"
 #include "count.h"
+#include "list_unrolled.h"
 
 namespace e = elements;
 
@@ -30,4 +32,29 @@ SCENARIO ("Counting", "[count]")
         REQUIRE (e::count(x, x + 5, 2) == 0);
         REQUIRE (e::count_not(x, x + 5, 2) == 5);
     }
+
+    SECTION ("Counting elements in segmented sequences")
+    {
+        e::list_unrolled<int, 2> x;
+        e::array_segmented_single_ended<int, 2> y;
+        for (int i : {0, 1, 0, 0, 4, 0, 6}) {
+            e::push_last(x, i);
+            e::push(y, i);
+        }
+
+        auto is_even = [](int i){ return i % 2 == 0; };
+
+        REQUIRE (e::count_if(e::first(x), e::limit(x), is_even, 0) == 6);
+        REQUIRE (e::count_if_not(e::first(x), e::limit(x), is_even, 0) == 1);
+        REQUIRE (e::count(e::first(x), e::limit(x), 0) == 4);
+        REQUIRE (e::count_not(e::first(x), e::limit(x), 0) == 3);
+
+        REQUIRE (e::count(e::successor(e::first(x)), e::last(x), 0) == 3);
+        REQUIRE (e::count(e::first(x) + 2, e::first(x) + 3, 0) == 1);
+        REQUIRE (e::count(e::first(x), e::first(x), 0) == 0);
+
+        REQUIRE (e::count_if(e::first(y), e::limit(y), is_even, 0) == 6);
+        REQUIRE (e::count(e::first(y), e::limit(y), 0) == 4);
+        REQUIRE (e::count_not(e::first(y), e::limit(y), 0) == 3);
+    }
 }
@@ -1,6 +1,8 @@
 #include "catch.hpp"
 
+#include "array_segmented_single_ended.h"
 #include "fill.h"
+#include "list_unrolled.h"
 
 namespace e = elements;
 
@@ -35,4 +37,32 @@ SCENARIO ("Fill", "[fill]")
         CHECK(x[3] == 0);
         CHECK(x[4] == 0);
     }
+
+    SECTION ("Filling segmented sequences")
+    {
+        e::list_unrolled<int, 2> x;
+        e::array_segmented_single_ended<int, 2> y;
+        for (int i : {0, 1, 2, 3, 4}) {
+            e::push_last(x, i);
+            e::push(y, i);
+        }
+
+        auto cur = e::fill(e::successor(e::first(x)), e::last(x), 7);
+
+        REQUIRE (cur == e::last(x));
+
+        CHECK(x[0] == 0);
+        CHECK(x[1] == 7);
+        CHECK(x[2] == 7);
+        CHECK(x[3] == 7);
+        CHECK(x[4] == 4);
+
+        e::fill(e::first(y), e::limit(y), 7);
+
+        CHECK(y[0] == 7);
+        CHECK(y[1] == 7);
+        CHECK(y[2] == 7);
+        CHECK(y[3] == 7);
+        CHECK(y[4] == 7);
+    }
 }
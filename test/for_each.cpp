@@ -1,6 +1,8 @@
 #include "catch.hpp"
 
+#include "array_segmented_single_ended.h"
 #include "for_each.h"
+#include "list_unrolled.h"
 
 namespace e = elements;
 
@@ -25,6 +27,32 @@ SCENARIO ("For each", "[for_each]")
 
         REQUIRE (sum == 3);
     }
+
+    SECTION ("Summing the integers in segmented sequences")
+    {
+        e::list_unrolled<int, 2> x;
+        e::array_segmented_single_ended<int, 2> y;
+        for (int i : {0, 1, 2, 3, 4, 5, 6}) {
+            e::push_last(x, i);
+            e::push(y, i);
+        }
+
+        int sum = 0;
+        auto cur = e::get<0>(e::for_each(e::first(x), e::limit(x), [&sum](int a){ sum += a; }));
+
+        REQUIRE (sum == 21);
+        REQUIRE (cur == e::limit(x));
+
+        sum = 0;
+        e::for_each(e::successor(e::first(x)), e::last(x), [&sum](int a){ sum += a; });
+
+        REQUIRE (sum == 15);
+
+        sum = 0;
+        e::for_each(e::first(y), e::limit(y), [&sum](int a){ sum += a; });
+
+        REQUIRE (sum == 21);
+    }
 }
 
 SCENARIO ("For each n", "[for_each_n]")
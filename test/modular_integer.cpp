@@ -0,0 +1,50 @@
+#include "catch.hpp"
+
+#include "modular_integer.h"
+
+namespace e = elements;
+
+SCENARIO ("Using modular integers", "[modular_integer]")
+{
+    using R = e::modular_integer<7>;
+
+    static_assert(e::Ring<R>);
+    static_assert(e::Modular_prime_field<R>);
+    static_assert(!e::Modular_prime_field<e::modular_integer<8>>);
+
+    SECTION ("Construction")
+    {
+        REQUIRE (R{9}.v == 2);
+        REQUIRE (R{-1}.v == 6);
+        REQUIRE (R{-7}.v == 0);
+        REQUIRE (R{-15}.v == 6);
+        REQUIRE (e::Zero<R> == R{0});
+        REQUIRE (e::One<R> == R{8});
+    }
+
+    SECTION ("Algebra")
+    {
+        R x{3};
+        R y{5};
+        R z{6};
+
+        REQUIRE (e::axiom_Ring(x, y, z));
+        REQUIRE (x + y == R{1});
+        REQUIRE (x - y == R{5});
+        REQUIRE (-x == R{4});
+        REQUIRE (x * y == R{1});
+        REQUIRE (x / y == R{2});
+        REQUIRE (x * e::reciprocal_op<R>{}(x) == e::One<R>);
+        REQUIRE (e::power(x, 6) == e::One<R>);
+    }
+
+    SECTION ("Number theory")
+    {
+        REQUIRE (e::is_prime(998244353));
+        REQUIRE (!e::is_prime(1));
+        REQUIRE (!e::is_prime(91));
+        REQUIRE (e::primitive_root(7) == 3);
+        REQUIRE (e::primitive_root(998244353) == 3);
+        REQUIRE (e::power_modular(2, 10, 1000) == 24);
+    }
+}
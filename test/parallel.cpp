@@ -0,0 +1,30 @@
+#include "catch.hpp"
+
+#include "parallel.h"
+
+namespace e = elements;
+
+SCENARIO ("Parallel workers", "[parallel]")
+{
+    SECTION ("Number of workers")
+    {
+        REQUIRE (e::parallel_workers(0, 10, 4) == 1);
+        REQUIRE (e::parallel_workers(25, 10, 4) == 2);
+        REQUIRE (e::parallel_workers(1000, 10, 4) == 4);
+        REQUIRE (e::parallel_workers(1000, 10) >= 1);
+    }
+
+    SECTION ("Each worker is called once")
+    {
+        e::atomic<int> calls[8]{};
+        e::for_each_worker(8, [&calls](e::pointer_diff i){ calls[i].fetch_add(1); });
+
+        for (auto& x : calls) {
+            REQUIRE (x.load() == 1);
+        }
+
+        e::for_each_worker(0, [&calls](e::pointer_diff i){ calls[i].fetch_add(1); });
+
+        REQUIRE (calls[0].load() == 1);
+    }
+}
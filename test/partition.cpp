@@ -497,3 +497,239 @@ SCENARIO ("Partitioning", "[partition]")
         }
     }
 }
+
+SCENARIO ("Partitioning large arrays", "[partition]")
+{
+    SECTION ("Block partitioning of 32-bit integers")
+    {
+        for (e::pointer_diff n : {0, 1, 63, 64, 127, 128, 129, 1000, 4099}) {
+            for (int pivot : {-600, -250, 0, 499, 600}) {
+                e::array_single_ended<int> x(n);
+                for (e::pointer_diff i = 0; i < n; ++i) e::push(x, static_cast<int>((i * 7919 + i / 13) % 1001 - 500));
+                auto y = x;
+                auto pred = [pivot](int a){ return pivot <= a; };
+
+                auto cur = e::partition_block(e::first(x), e::limit(x), pred);
+
+                REQUIRE (e::is_partitioned(e::first(x), e::limit(x), pred));
+                REQUIRE (cur == e::partition_point(e::first(x), e::limit(x), pred));
+                e::pointer_diff counts[1001]{};
+                for (e::pointer_diff i = 0; i < n; ++i) {
+                    ++counts[x[i] + 500];
+                    --counts[y[i] + 500];
+                }
+                for (e::pointer_diff j = 0; j < 1001; ++j) REQUIRE (counts[j] == 0);
+            }
+        }
+    }
+
+    SECTION ("Block partitioning with a predicate that returns an integer")
+    {
+        for (e::pointer_diff n : {0, 1, 63, 64, 127, 128, 129, 1000, 4099}) {
+            e::array_single_ended<int> x(n);
+            for (e::pointer_diff i = 0; i < n; ++i) e::push(x, static_cast<int>((i * 7919 + i / 13) % 1001 - 500));
+            auto y = x;
+            auto pred = [](int a){ return a & 260; };
+
+            auto cur = e::partition_block(e::first(x), e::limit(x), pred);
+
+            REQUIRE (e::is_partitioned(e::first(x), e::limit(x), pred));
+            REQUIRE (cur == e::partition_point(e::first(x), e::limit(x), pred));
+            e::pointer_diff counts[1001]{};
+            for (e::pointer_diff i = 0; i < n; ++i) {
+                ++counts[x[i] + 500];
+                --counts[y[i] + 500];
+            }
+            for (e::pointer_diff j = 0; j < 1001; ++j) REQUIRE (counts[j] == 0);
+        }
+    }
+
+    SECTION ("Partitioning 32-bit integers by a pivot")
+    {
+        for (e::pointer_diff n : {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 100, 1000, 4099}) {
+            for (int p : {-600, -250, 0, 499, 600}) {
+                e::array_single_ended<int> x(n);
+                for (e::pointer_diff i = 0; i < n; ++i) e::push(x, static_cast<int>((i * 7919 + i / 13) % 1001 - 500));
+                auto y = x;
+                auto pivot = static_cast<int>(p);
+                auto pred = [pivot](int a){ return !(a < pivot); };
+
+                auto cur = e::partition_less(e::first(x), e::limit(x), pivot);
+
+                REQUIRE (e::is_partitioned(e::first(x), e::limit(x), pred));
+                REQUIRE (cur == e::partition_point(e::first(x), e::limit(x), pred));
+                e::pointer_diff counts[1001]{};
+                for (e::pointer_diff i = 0; i < n; ++i) {
+                    ++counts[x[i] + 500];
+                    --counts[y[i] + 500];
+                }
+                for (e::pointer_diff j = 0; j < 1001; ++j) REQUIRE (counts[j] == 0);
+            }
+        }
+    }
+
+    SECTION ("Partitioning single-precision numbers by a pivot")
+    {
+        for (e::pointer_diff n : {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 100, 1000, 4099}) {
+            for (int p : {-600, -250, 0, 499, 600}) {
+                e::array_single_ended<float> x(n);
+                for (e::pointer_diff i = 0; i < n; ++i) e::push(x, static_cast<float>((i * 7919 + i / 13) % 1001 - 500));
+                auto y = x;
+                auto pivot = static_cast<float>(p);
+                auto pred = [pivot](float a){ return !(a < pivot); };
+
+                auto cur = e::partition_less(e::first(x), e::limit(x), pivot);
+
+                REQUIRE (e::is_partitioned(e::first(x), e::limit(x), pred));
+                REQUIRE (cur == e::partition_point(e::first(x), e::limit(x), pred));
+                e::pointer_diff counts[1001]{};
+                for (e::pointer_diff i = 0; i < n; ++i) {
+                    ++counts[static_cast<e::pointer_diff>(x[i]) + 500];
+                    --counts[static_cast<e::pointer_diff>(y[i]) + 500];
+                }
+                for (e::pointer_diff j = 0; j < 1001; ++j) REQUIRE (counts[j] == 0);
+            }
+        }
+    }
+
+    SECTION ("Partitioning 64-bit integers by a pivot")
+    {
+        for (e::pointer_diff n : {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 100, 1000, 4099}) {
+            for (int p : {-600, -250, 0, 499, 600}) {
+                e::array_single_ended<e::Z<64>> x(n);
+                for (e::pointer_diff i = 0; i < n; ++i) e::push(x, static_cast<e::Z<64>>((i * 7919 + i / 13) % 1001 - 500));
+                auto y = x;
+                auto pivot = static_cast<e::Z<64>>(p);
+                auto pred = [pivot](e::Z<64> a){ return !(a < pivot); };
+
+                auto cur = e::partition_less(e::first(x), e::limit(x), pivot);
+
+                REQUIRE (e::is_partitioned(e::first(x), e::limit(x), pred));
+                REQUIRE (cur == e::partition_point(e::first(x), e::limit(x), pred));
+                e::pointer_diff counts[1001]{};
+                for (e::pointer_diff i = 0; i < n; ++i) {
+                    ++counts[x[i] + 500];
+                    --counts[y[i] + 500];
+                }
+                for (e::pointer_diff j = 0; j < 1001; ++j) REQUIRE (counts[j] == 0);
+            }
+        }
+    }
+
+    SECTION ("Partitioning double-precision numbers by a pivot")
+    {
+        for (e::pointer_diff n : {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 100, 1000, 4099}) {
+            for (int p : {-600, -250, 0, 499, 600}) {
+                e::array_single_ended<double> x(n);
+                for (e::pointer_diff i = 0; i < n; ++i) e::push(x, static_cast<double>((i * 7919 + i / 13) % 1001 - 500));
+                auto y = x;
+                auto pivot = static_cast<double>(p);
+                auto pred = [pivot](double a){ return !(a < pivot); };
+
+                auto cur = e::partition_less(e::first(x), e::limit(x), pivot);
+
+                REQUIRE (e::is_partitioned(e::first(x), e::limit(x), pred));
+                REQUIRE (cur == e::partition_point(e::first(x), e::limit(x), pred));
+                e::pointer_diff counts[1001]{};
+                for (e::pointer_diff i = 0; i < n; ++i) {
+                    ++counts[static_cast<e::pointer_diff>(x[i]) + 500];
+                    --counts[static_cast<e::pointer_diff>(y[i]) + 500];
+                }
+                for (e::pointer_diff j = 0; j < 1001; ++j) REQUIRE (counts[j] == 0);
+            }
+        }
+    }
+
+    SECTION ("Partitioning 16-bit integers by a pivot")
+    {
+        for (e::pointer_diff n : {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 100, 1000, 4099}) {
+            for (int p : {-600, -250, 0, 499, 600}) {
+                e::array_single_ended<short> x(n);
+                for (e::pointer_diff i = 0; i < n; ++i) e::push(x, static_cast<short>((i * 7919 + i / 13) % 1001 - 500));
+                auto y = x;
+                auto pivot = static_cast<short>(p);
+                auto pred = [pivot](short a){ return !(a < pivot); };
+
+                auto cur = e::partition_less(e::first(x), e::limit(x), pivot);
+
+                REQUIRE (e::is_partitioned(e::first(x), e::limit(x), pred));
+                REQUIRE (cur == e::partition_point(e::first(x), e::limit(x), pred));
+                e::pointer_diff counts[1001]{};
+                for (e::pointer_diff i = 0; i < n; ++i) {
+                    ++counts[x[i] + 500];
+                    --counts[y[i] + 500];
+                }
+                for (e::pointer_diff j = 0; j < 1001; ++j) REQUIRE (counts[j] == 0);
+            }
+        }
+    }
+
+    SECTION ("Parallel stable partitioning")
+    {
+        auto n = 3 * e::partition_parallel_grain + 17;
+        auto pred = [](int a){ return a % 3 == 0; };
+        e::array_single_ended<int> x(n);
+        for (e::pointer_diff i = 0; i < n; ++i) e::push(x, static_cast<int>((i * 7919 + i / 13) % 1001 - 500));
+        auto y = x;
+        auto expected = e::partition_stable(e::first(x), e::limit(x), pred);
+
+        for (e::pointer_diff workers : {1, 2, 3}) {
+            auto z = y;
+            auto cur = e::partition_stable_parallel(e::first(z), e::limit(z), pred, workers);
+            REQUIRE (cur - e::first(z) == expected - e::first(x));
+            REQUIRE (z == x);
+        }
+
+        e::array_single_ended<int> empty;
+        REQUIRE (e::partition_stable_parallel(e::first(empty), e::limit(empty), pred) == e::limit(empty));
+    }
+
+    SECTION ("Parallel stable partitioning keeps the order of equivalent elements")
+    {
+        auto n = 3 * e::partition_parallel_grain + 17;
+        e::array_single_ended<e::pair<int, e::pointer_diff>> x(n);
+        for (e::pointer_diff i = 0; i < n; ++i) e::push(x, e::pair<int, e::pointer_diff>{static_cast<int>(i % 7), i});
+        auto pred = [](e::pair<int, e::pointer_diff> const& a){ return a.m0 % 3 == 0; };
+
+        auto cur = e::partition_stable_parallel(e::first(x), e::limit(x), pred, 4);
+
+        REQUIRE (e::is_partitioned(e::first(x), e::limit(x), pred));
+        for (e::pointer_diff i = 1; i < n; ++i) {
+            if (i != cur - e::first(x)) REQUIRE (x[i - 1].m1 < x[i].m1);
+        }
+    }
+
+    SECTION ("Parallel stable partitioning with a predicate that returns an integer")
+    {
+        auto n = 3 * e::partition_parallel_grain + 17;
+        auto pred = [](int a){ return a & 260; };
+        e::array_single_ended<int> x(n);
+        for (e::pointer_diff i = 0; i < n; ++i) e::push(x, static_cast<int>((i * 7919 + i / 13) % 1001 - 500));
+        auto y = x;
+        auto expected = e::partition_stable(e::first(x), e::limit(x), pred);
+
+        for (e::pointer_diff workers : {1, 2, 3}) {
+            auto z = y;
+            auto cur = e::partition_stable_parallel(e::first(z), e::limit(z), pred, workers);
+            REQUIRE (cur - e::first(z) == expected - e::first(x));
+            REQUIRE (z == x);
+        }
+    }
+
+    SECTION ("Parallel copying with a predicate")
+    {
+        auto n = 3 * e::copy_if_parallel_grain + 5;
+        auto pred = [](int a){ return a % 3 == 0; };
+        e::array_single_ended<int> x(n);
+        for (e::pointer_diff i = 0; i < n; ++i) e::push(x, static_cast<int>((i * 7919 + i / 13) % 1001 - 500));
+        e::array_single_ended<int> expected(n, 1);
+        auto count = e::copy_if(e::first(x), e::limit(x), e::first(expected), pred) - e::first(expected);
+
+        for (e::pointer_diff workers : {1, 2, 3}) {
+            e::array_single_ended<int> y(n, 1);
+            auto cur = e::copy_if_parallel(e::first(x), e::limit(x), e::first(y), pred, workers);
+            REQUIRE (cur - e::first(y) == count);
+            REQUIRE (y == expected);
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#include "catch.hpp"
+
+#include "perf_counters.h"
+
+namespace e = elements;
+
+SCENARIO ("Hardware performance counters", "[perf_counters]")
+{
+    e::perf_counters counters;
+
+    SECTION ("Availability")
+    {
+        bool any = false;
+        for (e::size_t i = 0; i < e::n_perf_events; ++i) {
+            REQUIRE (e::is_valid(counters.counts, i) == (0 <= counters.fd[i]));
+            any = any or e::is_valid(counters.counts, i);
+        }
+
+        REQUIRE (e::is_available(counters) == any);
+    }
+
+    SECTION ("Scope")
+    {
+        volatile long sum = 0;
+        {
+            e::perf_scope scope{counters};
+            for (long i = 0; i < 100000; ++i) sum = sum + i;
+        }
+
+        for (e::size_t i = 0; i < e::n_perf_events; ++i) {
+            if (!e::is_valid(counters.counts, i)) {
+                REQUIRE (counters.counts[i] == 0.0);
+            } else {
+                REQUIRE (counters.counts[i] >= 0.0);
+            }
+        }
+        if (e::is_valid(counters.counts, e::perf_instructions)) {
+            REQUIRE (counters.counts[e::perf_instructions] >= 100000.0);
+        }
+
+        auto instructions = counters.counts[e::perf_instructions];
+        {
+            e::perf_scope scope{counters};
+            for (long i = 0; i < 100000; ++i) sum = sum + i;
+        }
+
+        REQUIRE (counters.counts[e::perf_instructions] >= instructions);
+
+        e::clear(counters);
+
+        for (e::size_t i = 0; i < e::n_perf_events; ++i) {
+            REQUIRE (counters.counts[i] == 0.0);
+        }
+    }
+
+    SECTION ("Difference")
+    {
+        e::perf_reading x{100.0, 10.0, 10.0};
+        e::perf_reading y{300.0, 30.0, 20.0};
+
+        REQUIRE (e::perf_difference(x, y) == 400.0);
+        REQUIRE (e::perf_difference(x, x) == 0.0);
+    }
+
+    SECTION ("Instructions per cycle")
+    {
+        e::perf_counts x;
+
+        REQUIRE (e::instructions_per_cycle(x) == 0.0);
+
+        x.valid[e::perf_cycles] = true;
+        x.valid[e::perf_instructions] = true;
+        x[e::perf_cycles] = 100.0;
+        x[e::perf_instructions] = 250.0;
+
+        REQUIRE (e::instructions_per_cycle(x) == 2.5);
+    }
+}
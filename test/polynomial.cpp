@@ -167,3 +167,276 @@ SCENARIO ("Using polynomials", "[polynomial]")
         }
     }
 }
+
+template <typename R>
+auto make_polynomial(e::pointer_diff n, long seed) -> e::polynomial<R>
+{
+    e::array_single_ended<R> a;
+    long x = seed;
+    for (e::pointer_diff i = 0; i < n; ++i) {
+        x = (x * 1103515245 + 12345) % 2147483648;
+        e::emplace(a, R(x % 201 - 100));
+    }
+    return e::polynomial<R>{mv(a)};
+}
+
+template <typename R>
+auto multiply_schoolbook(e::polynomial<R> const& x, e::polynomial<R> const& y) -> e::polynomial<R>
+{
+    auto n = e::degree(x) + 1;
+    auto m = e::degree(y) + 1;
+    e::polynomial<R> z(n + m - 1, e::Zero<R>);
+    e::multiply_schoolbook(e::first(x.coefficients), n, e::first(y.coefficients), m, e::first(z.coefficients));
+    return z;
+}
+
+SCENARIO ("Fast polynomial multiplication", "[polynomial]")
+{
+    SECTION ("Karatsuba")
+    {
+        for (e::pointer_diff n : {1, 31, 32, 33, 100, 257}) {
+            for (e::pointer_diff m : {1, 20, 32, 70, 300}) {
+                auto x = make_polynomial<long>(n, n);
+                auto y = make_polynomial<long>(m, m + 1);
+
+                REQUIRE (x * y == multiply_schoolbook(x, y));
+
+                e::polynomial<long> z(n + m - 1, 0L);
+                e::multiply_karatsuba(e::first(x.coefficients), n, e::first(y.coefficients), m, e::first(z.coefficients), 2);
+
+                REQUIRE (z == multiply_schoolbook(x, y));
+            }
+        }
+    }
+
+    SECTION ("Number theoretic transform")
+    {
+        using R = e::modular_integer<998244353>;
+
+        static_assert(e::Ring<R>);
+        static_assert(e::Modular_prime_field<R>);
+        static_assert(e::modular_primitive_root<998244353> == R{3});
+        static_assert(e::number_theoretic_transform_max_size<998244353> == (1 << 23));
+
+        for (e::pointer_diff n : {64, 100, 1000}) {
+            auto x = make_polynomial<R>(n, n);
+            auto y = make_polynomial<R>(n + 37, n + 1);
+
+            REQUIRE (x * y == multiply_schoolbook(x, y));
+        }
+
+        using S = e::modular_integer<1000003>;
+
+        static_assert(e::Modular_prime_field<S>);
+        static_assert(e::number_theoretic_transform_max_size<1000003> == 2);
+
+        auto x = make_polynomial<S>(100, 1);
+        auto y = make_polynomial<S>(100, 2);
+
+        REQUIRE (x * y == multiply_schoolbook(x, y));
+    }
+
+    SECTION ("Fourier transform")
+    {
+        for (e::pointer_diff n : {64, 100, 1000}) {
+            auto x = make_polynomial<double>(n, n);
+            auto y = make_polynomial<double>(n + 37, n + 1);
+            auto z = e::multiply_fourier(x, y);
+            auto w = multiply_schoolbook(x, y);
+
+            REQUIRE (x * y == w);
+            REQUIRE (e::degree(z) == e::degree(w));
+            for (e::pointer_diff i = 0; i <= e::degree(w); ++i) {
+                REQUIRE (z[i] == Approx(w[i]).margin(1e-6));
+            }
+        }
+    }
+}
+
+SCENARIO ("Polynomial evaluation at many points", "[polynomial]")
+{
+    SECTION ("Batch Horner")
+    {
+        auto p = make_polynomial<long>(9, 3);
+        long x[21];
+        long y[21];
+        for (int i = 0; i < 21; ++i) x[i] = i - 10;
+
+        REQUIRE (e::evaluate(p, x, x + 21, y) == y + 21);
+        for (int i = 0; i < 21; ++i) {
+            REQUIRE (y[i] == e::evaluate(p, x[i]));
+        }
+
+        auto q = make_polynomial<double>(30, 5);
+        double u[13];
+        double v[13];
+        for (int i = 0; i < 13; ++i) u[i] = 0.1 * i - 0.6;
+        e::evaluate(q, u, u + 13, v);
+        for (int i = 0; i < 13; ++i) {
+            REQUIRE (v[i] == e::evaluate(q, u[i]));
+        }
+
+        e::polynomial<long> zero;
+        e::evaluate(zero, x, x + 3, y);
+
+        REQUIRE (y[0] == 0);
+        REQUIRE (y[2] == 0);
+        REQUIRE (e::evaluate(zero, 5L) == 0);
+    }
+
+    SECTION ("Batch Horner for other rings")
+    {
+        using R = e::modular_integer<7>;
+        e::array_single_ended<R> a;
+        e::emplace(a, R{1});
+        e::emplace(a, R{2});
+        e::emplace(a, R{3});
+        e::polynomial p{mv(a)};
+        R x[]{R{0}, R{1}, R{2}};
+        R y[3];
+        e::evaluate(p, x, x + 3, y);
+
+        REQUIRE (y[0] == R{1});
+        REQUIRE (y[1] == R{6});
+        REQUIRE (y[2] == R{17});
+    }
+
+    SECTION ("Estrin")
+    {
+        for (e::pointer_diff n : {1, 2, 3, 4, 5, 8, 13}) {
+            auto p = make_polynomial<long>(n, n);
+            for (long x : {-2L, -1L, 0L, 1L, 2L}) REQUIRE (e::evaluate_estrin(p, x) == e::evaluate(p, x));
+        }
+
+        auto p64 = make_polynomial<long>(64, 64);
+        for (long x : {-1L, 0L, 1L}) REQUIRE (e::evaluate_estrin(p64, x) == e::evaluate(p64, x));
+
+        using R = e::modular_integer<998244353>;
+        for (e::pointer_diff n : {64, 100}) {
+            auto q = make_polynomial<R>(n, n);
+            for (long x : {-2L, 2L, 12345L}) REQUIRE (e::evaluate_estrin(q, R(x)) == e::evaluate(q, R(x)));
+        }
+
+        auto p = make_polynomial<double>(100, 7);
+        double x[5]{-0.9, -0.5, 0.0, 0.5, 0.9};
+        double y[5];
+        e::evaluate_estrin(p, x, x + 5, y);
+        for (int i = 0; i < 5; ++i) {
+            REQUIRE (y[i] == Approx(e::evaluate(p, x[i])));
+        }
+
+        e::polynomial<long> zero;
+
+        REQUIRE (e::evaluate_estrin(zero, 3L) == 0);
+    }
+}
+
+template <typename R>
+auto power_of_t(e::pointer_diff n) -> e::polynomial<R>
+{
+    e::polynomial<R> x(n + 1, e::Zero<R>);
+    x[n] = e::One<R>;
+    return x;
+}
+
+SCENARIO ("Polynomial division and greatest common divisors", "[polynomial]")
+{
+    using R = e::modular_integer<998244353>;
+    using P = e::polynomial<R>;
+
+    SECTION ("Euclidean division")
+    {
+        for (e::pointer_diff n : {1, 5, 100, 700, 1500}) {
+            for (e::pointer_diff m : {1, 3, 130, 600}) {
+                auto x = make_polynomial<R>(n, n);
+                auto y = make_polynomial<R>(m, m + 1);
+                auto qr = e::quotient_remainder(x, y);
+
+                REQUIRE (e::degree(qr.m1) < e::degree(y));
+                REQUIRE (qr.m0 * y + qr.m1 == x);
+                REQUIRE (e::quotient(x, y) == qr.m0);
+                REQUIRE (e::remainder(x, y) == qr.m1);
+            }
+        }
+
+        P c{R{5}};
+
+        REQUIRE (e::quotient_remainder(c, make_polynomial<R>(3, 1)).m1 == c);
+        REQUIRE (e::remainder(make_polynomial<R>(3, 1) * c, c) == e::Zero<P>);
+    }
+
+    SECTION ("Inverse series")
+    {
+        for (e::pointer_diff n : {1, 2, 7, 64, 1000}) {
+            auto x = make_polynomial<R>(n + 5, n);
+            x[0] = R{1};
+            auto y = e::inverse_series(x, n);
+
+            REQUIRE (e::degree(y) < n);
+            REQUIRE (e::truncate(x * y, n) == e::One<P>);
+        }
+    }
+
+    SECTION ("Greatest common divisors")
+    {
+        for (e::pointer_diff n : {2, 10, 70, 300, 2100}) {
+            auto g = e::monic(make_polynomial<R>(n, n));
+            auto x = g * make_polynomial<R>(n + 11, 1);
+            auto y = g * make_polynomial<R>(n + 3, 2);
+            auto d = e::gcd(x, y);
+
+            REQUIRE (d == e::gcd_euclidean(x, y));
+            REQUIRE (e::remainder(d, g) == e::Zero<P>);
+            REQUIRE (e::remainder(x, d) == e::Zero<P>);
+            REQUIRE (e::remainder(y, d) == e::Zero<P>);
+        }
+
+        auto x = make_polynomial<R>(20, 3);
+
+        REQUIRE (e::gcd(x, e::Zero<P>) == e::monic(x));
+        REQUIRE (e::gcd(e::Zero<P>, x) == e::monic(x));
+        REQUIRE (e::gcd(e::Zero<P>, e::Zero<P>) == e::Zero<P>);
+    }
+
+    SECTION ("Half greatest common divisor")
+    {
+        for (e::pointer_diff n : {401, 5001}) {
+            auto x = make_polynomial<R>(n, 4);
+            auto y = make_polynomial<R>(n - 11, 5);
+            auto m = e::half_gcd(x, y);
+            auto ab = e::apply(m, x, y);
+
+            REQUIRE (e::degree(ab.m1) < n / 2);
+            REQUIRE (n / 2 <= e::degree(ab.m0));
+            REQUIRE (e::degree(m.m00 * m.m11 - m.m01 * m.m10) == 0);
+        }
+    }
+
+    SECTION ("Binary field")
+    {
+        using F = e::modular_integer<2>;
+        using Q = e::polynomial<F>;
+
+        // The CRC-32 generator polynomial and t^32 + 1
+        Q crc(33, e::Zero<F>);
+        for (e::pointer_diff i : {32, 26, 23, 22, 16, 12, 11, 10, 8, 7, 5, 4, 2, 1, 0}) crc[i] = F{1};
+        auto x = power_of_t<F>(32) + e::One<Q>;
+
+        REQUIRE (e::gcd(crc, x) == e::gcd_euclidean(crc, x));
+        REQUIRE (e::gcd(crc * x, x * x) == x * e::gcd(crc, x));
+
+        auto y = power_of_t<F>(1000) + power_of_t<F>(3) + e::One<Q>;
+        auto z = power_of_t<F>(700) + power_of_t<F>(1) + e::One<Q>;
+
+        REQUIRE (e::gcd(y * crc, z * crc) == e::gcd_euclidean(y * crc, z * crc));
+    }
+
+    SECTION ("Modular composition")
+    {
+        auto p = make_polynomial<R>(20, 1);
+        auto x = make_polynomial<R>(30, 2);
+        auto m = make_polynomial<R>(25, 3);
+
+        REQUIRE (e::compose_modular(p, x, m) == e::remainder(e::compose_modular(p, x, power_of_t<R>(2000)), m));
+    }
+}
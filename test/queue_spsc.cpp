@@ -0,0 +1,145 @@
+#include "catch.hpp"
+
+#include <future>
+
+#include "array_single_ended.h"
+#include "queue_spsc.h"
+
+namespace e = elements;
+
+void produce(e::queue_spsc<int>* q, int n)
+{
+    int i = 0;
+    int batch[7];
+    while (i < n) {
+        if (i % 3 == 0) {
+            if (e::try_push(*q, i)) ++i;
+        } else {
+            int m = 0;
+            while (m < 7 and i + m < n) {
+                batch[m] = i + m;
+                ++m;
+            }
+            i = i + static_cast<int>(e::try_push_n(*q, batch, m));
+        }
+    }
+}
+
+SCENARIO ("Using single-producer/single-consumer queue", "[queue_spsc]")
+{
+    SECTION ("Push and pop")
+    {
+        e::queue_spsc<int> q{3};
+        REQUIRE (e::capacity(q) == 4);
+
+        int x;
+        REQUIRE (!e::try_pop(q, x));
+
+        REQUIRE (e::try_push(q, 0));
+        REQUIRE (e::try_push(q, 1));
+        REQUIRE (e::try_push(q, 2));
+        REQUIRE (e::try_push(q, 3));
+        REQUIRE (!e::try_push(q, 4));
+
+        REQUIRE (e::try_pop(q, x));
+        REQUIRE (x == 0);
+        REQUIRE (e::try_push(q, 4));
+
+        REQUIRE (e::try_pop(q, x));
+        REQUIRE (x == 1);
+        REQUIRE (e::try_pop(q, x));
+        REQUIRE (x == 2);
+        REQUIRE (e::try_pop(q, x));
+        REQUIRE (x == 3);
+        REQUIRE (e::try_pop(q, x));
+        REQUIRE (x == 4);
+        REQUIRE (!e::try_pop(q, x));
+    }
+
+    SECTION ("Batch push and pop across the wrap")
+    {
+        e::queue_spsc<int> q{8};
+        int src[6] = {0, 1, 2, 3, 4, 5};
+        int dst[8] = {};
+
+        REQUIRE (e::try_push_n(q, src, 6) == 6);
+        REQUIRE (e::try_pop_n(q, 4, dst) == 4);
+        CHECK (dst[3] == 3);
+
+        REQUIRE (e::try_push_n(q, src, 6) == 6);
+        REQUIRE (e::try_push_n(q, src, 6) == 0);
+        REQUIRE (e::try_pop_n(q, 8, dst) == 8);
+        CHECK (dst[0] == 4);
+        CHECK (dst[1] == 5);
+        CHECK (dst[2] == 0);
+        CHECK (dst[7] == 5);
+        REQUIRE (e::try_pop_n(q, 8, dst) == 0);
+    }
+
+    SECTION ("Reserving and committing write regions")
+    {
+        e::queue_spsc<int> q{4};
+        int x;
+
+        auto region = e::reserve(q, 3);
+        REQUIRE (e::size(region) == 3);
+        region[0] = 0;
+        region[1] = 1;
+        e::commit(q, 2);
+        REQUIRE (e::try_pop(q, x));
+        REQUIRE (x == 0);
+
+        region = e::reserve(q, 4);
+        REQUIRE (e::size(region) == 2);
+        region[0] = 2;
+        region[1] = 3;
+        e::commit(q, 2);
+
+        region = e::reserve(q, 4);
+        REQUIRE (e::size(region) == 1);
+        region[0] = 4;
+        e::commit(q, 1);
+        REQUIRE (e::size(e::reserve(q, 4)) == 0);
+
+        int dst[4] = {};
+        REQUIRE (e::try_pop_n(q, 4, dst) == 4);
+        CHECK (dst[0] == 1);
+        CHECK (dst[1] == 2);
+        CHECK (dst[2] == 3);
+        CHECK (dst[3] == 4);
+    }
+
+    SECTION ("Elements with resources")
+    {
+        e::queue_spsc<e::array_single_ended<int>> q{2};
+        e::array_single_ended<int> x;
+        e::push(x, 1);
+        e::push(x, 2);
+        REQUIRE (e::try_push(q, x));
+        REQUIRE (e::try_push(q, e::array_single_ended<int>{}));
+
+        e::array_single_ended<int> dst[2];
+        REQUIRE (e::try_pop_n(q, 1, dst) == 1);
+        REQUIRE (dst[0] == x);
+        REQUIRE (e::try_push_n(q, e::pointer_to(x), 1) == 1);
+    }
+
+    SECTION ("Producer and consumer threads")
+    {
+        e::queue_spsc<int> q{16};
+        int const n = 100000;
+        auto producer = std::async(std::launch::async, produce, &q, n);
+
+        int i = 0;
+        int dst[5];
+        bool ordered = true;
+        while (i < n) {
+            auto m = static_cast<int>(e::try_pop_n(q, 5, dst));
+            for (int j = 0; j < m; ++j) ordered = ordered and dst[j] == i + j;
+            i = i + m;
+        }
+        producer.get();
+        REQUIRE (ordered);
+        REQUIRE (i == n);
+    }
+}
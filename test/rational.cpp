@@ -54,3 +54,114 @@ SCENARIO ("Using rational numbers", "[rational]")
         REQUIRE (2 * z == e::rational{3, 2});
     }
 }
+
+SCENARIO ("Using normalized rational numbers", "[rational]")
+{
+    using Q = e::rational_normalized<long>;
+
+    static_assert(e::Field<Q>);
+    static_assert(e::Same_as<e::Wide_type<long>, e::int128>);
+    static_assert(e::Same_as<e::Wide_type<unsigned>, e::N<64>>);
+
+    SECTION ("Binary greatest common divisor")
+    {
+        REQUIRE (e::gcd_binary(0, 0) == 0);
+        REQUIRE (e::gcd_binary(0, 12) == 12);
+        REQUIRE (e::gcd_binary(-12, 0) == 12);
+        REQUIRE (e::gcd_binary(12, 18) == 6);
+        REQUIRE (e::gcd_binary(-12, 18) == 6);
+        REQUIRE (e::gcd_binary(17, 5) == 1);
+        REQUIRE (e::gcd_binary(e::Min_integral<long>, 6L) == 2);
+        REQUIRE (e::gcd_binary(e::Min_integral<long>, e::Min_integral<long>) == e::N<64>{1} << 63);
+        REQUIRE (e::gcd_binary(std::uint8_t{96}, std::uint8_t{160}) == 32);
+
+        for (long a = -50; a <= 50; ++a) {
+            for (long b = -50; b <= 50; ++b) {
+                long x = a < 0 ? -a : a;
+                long y = b < 0 ? -b : b;
+                while (y != 0) {
+                    auto r = x % y;
+                    x = y;
+                    y = r;
+                }
+                REQUIRE (e::gcd_binary(a, b) == static_cast<unsigned long>(x));
+            }
+        }
+    }
+
+    SECTION ("Normalizing")
+    {
+        REQUIRE (e::normalize(e::rational{6, -4}).p == -3);
+        REQUIRE (e::normalize(e::rational{6, -4}).q == 2);
+
+        Q x{6, -4};
+
+        REQUIRE (x.p == -6);
+        REQUIRE (x.q == 4);
+        REQUIRE (!e::is_normalized(x));
+        REQUIRE (e::normalize(x).p == -3);
+        REQUIRE (e::normalize(x).q == 2);
+        REQUIRE (e::is_normalized(e::normalize(x)));
+        REQUIRE (e::normalize(Q{0, -7}).q == 1);
+    }
+
+    SECTION ("Algebra")
+    {
+        Q x{1, 2};
+        Q y{2, 4};
+        Q z{3, 4};
+
+        REQUIRE (e::axiom_Field(x, y, z));
+        REQUIRE (x == y);
+        REQUIRE (y < z);
+        REQUIRE (x + z == Q{5, 4});
+        REQUIRE (x - z == Q{-1, 4});
+        REQUIRE (x * z == Q{3, 8});
+        REQUIRE (x / z == Q{2, 3});
+        REQUIRE (z / -x == Q{-3, 2});
+        REQUIRE (2L * z == Q{3, 2});
+        REQUIRE (z * 2L == Q{3, 2});
+    }
+
+    SECTION ("Large terms")
+    {
+        long const big = 1L << 40;
+        Q x{big - 1, big};
+        Q y{1, big};
+
+        auto s = x + y;
+
+        REQUIRE (s == e::One<Q>);
+        REQUIRE (s.p == 1);
+        REQUIRE (s.q == 1);
+
+        Q u{big + 1, 3 * (big - 1)};
+        Q v{3 * (big - 1), big + 3};
+        auto w = u * v;
+
+        REQUIRE (w == Q{big + 1, big + 3});
+        REQUIRE (e::is_normalized(w));
+
+        auto const max = e::Max_integral<long>;
+
+        REQUIRE (Q{max - 1, 3} < Q{max, 3});
+        REQUIRE (e::One<Q> < Q{max, max - 1});
+        REQUIRE (Q{max, max - 1} == Q{max, max - 1});
+    }
+
+    SECTION ("Long accumulation")
+    {
+        Q s;
+        e::rational<long> t;
+        for (long i = 1; i <= 100000; ++i) {
+            Q x{(i % 7) - 3, 1 + i % 16};
+            s = s + x;
+            t = e::normalize(t + e::rational<long>{(i % 7) - 3, 1 + i % 16});
+        }
+        auto n = e::normalize(s);
+
+        REQUIRE (n.p == t.p);
+        REQUIRE (n.q == t.q);
+        REQUIRE (n.q <= 720720);
+    }
+}
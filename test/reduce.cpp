@@ -1,5 +1,7 @@
 #include "catch.hpp"
 
+#include "array_segmented_single_ended.h"
+#include "list_unrolled.h"
 #include "reduce.h"
 
 namespace e = elements;
@@ -19,6 +21,31 @@ SCENARIO ("Reduction", "[reduce]")
 
         REQUIRE (e::reduce_nonempty(x, x + 5, e::add) == 10);
     }
+
+    SECTION ("Reduction of segmented sequences")
+    {
+        e::list_unrolled<int, 2> y;
+        e::array_segmented_single_ended<int, 2> z;
+        for (int i : {1, 2, 3, 4, 5, 6, 7}) {
+            e::push_last(y, i);
+            e::push(z, i);
+        }
+
+        REQUIRE (e::reduce(e::first(y), e::limit(y), e::add_op<int>{}, 0) == 28);
+        REQUIRE (e::reduce(e::successor(e::first(y)), e::last(y), e::add_op<int>{}, 0) == 20);
+        REQUIRE (e::reduce(e::first(y) + 2, e::first(y) + 3, e::add_op<int>{}, 0) == 3);
+        REQUIRE (e::reduce(e::last(y), e::last(y), e::add_op<int>{}, 5) == 5);
+
+        REQUIRE (e::reduce(e::first(z), e::limit(z), e::add_op<int>{}, 0) == 28);
+
+        // A zero that is not an identity is only returned for an empty range
+        REQUIRE (e::reduce(e::first(y), e::limit(y), e::add_op<int>{}, 5) == 28);
+        REQUIRE (e::reduce(e::first(y) + 2, e::limit(y), e::add_op<int>{}, 5) == 25);
+        REQUIRE (e::reduce(e::first(y) + 2, e::first(y) + 4, e::add_op<int>{}, 5) == 7);
+        auto cur = e::first(y);
+        e::segment_cursor(cur) = e::limit(e::load(e::index_cursor(cur)));
+        REQUIRE (e::reduce(cur, e::limit(y), e::add_op<int>{}, 5) == e::reduce(cur, e::limit(y), e::add_op<int>{}, 0));
+    }
 }
 
 SCENARIO ("Balanced reduction", "[reduce]")
@@ -30,3 +57,36 @@ SCENARIO ("Balanced reduction", "[reduce]")
         REQUIRE(e::reduce_balanced(x, x + 5, e::add, 0) == 10);
     }
 }
+
+SCENARIO ("Parallel balanced reduction", "[reduce]")
+{
+    SECTION ("Parallel balanced reduction of array")
+    {
+        int x[]{0, 1, 2, 3, 4};
+
+        REQUIRE (e::reduce_balanced_parallel(x, x, e::add, 0) == 0);
+        REQUIRE (e::reduce_balanced_parallel(x, x + 5, e::add, 0) == 10);
+        REQUIRE (e::reduce_balanced_parallel(x, x + 5, e::add, 0, 4) == 10);
+    }
+
+    SECTION ("Independence of the number of workers")
+    {
+        e::pointer_diff n = 5 * e::reduce_balanced_block + 123;
+        e::array_single_ended<double> x(n);
+        for (e::pointer_diff i = 0; i < n; ++i) {
+            e::push(x, 1.0 / static_cast<double>(i + 1) + (i % 7 == 0 ? 1e8 : 0.0));
+        }
+        auto add = [](double const& a, double const& b){ return a + b; };
+        auto sum = e::reduce_balanced_parallel(e::first(x), e::limit(x), add, 0.0, 1);
+
+        for (e::pointer_diff w = 2; w <= 8; ++w) {
+            REQUIRE (e::reduce_balanced_parallel(e::first(x), e::limit(x), add, 0.0, w) == sum);
+        }
+        REQUIRE (sum == Approx(e::reduce_balanced(e::first(x), e::limit(x), add, 0.0)));
+
+        long sequence[]{1, 2, 3};
+        auto square = [](long const* c){ return *c * *c; };
+
+        REQUIRE (e::reduce_balanced_parallel(sequence, sequence + 3, e::add, square, 0L, 2) == 14);
+    }
+}
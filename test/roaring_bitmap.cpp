@@ -0,0 +1,141 @@
+#include "catch.hpp"
+
+#include "roaring_bitmap.h"
+
+namespace e = elements;
+
+template <typename Op>
+auto
+sorted_merge(e::array_single_ended<e::N<32>> const& x, e::array_single_ended<e::N<32>> const& y, Op keep) -> e::array_single_ended<e::N<32>>
+{
+    e::array_single_ended<e::N<32>> z;
+    e::pointer_diff i = 0;
+    e::pointer_diff j = 0;
+    while (i < e::size(x) or j < e::size(y)) {
+        auto in_x = i < e::size(x) and (j == e::size(y) or x[i] <= y[j]);
+        auto in_y = j < e::size(y) and (i == e::size(x) or y[j] <= x[i]);
+        auto a = in_x ? x[i] : y[j];
+        if (keep(in_x, in_y)) e::push(z, a);
+        if (in_x) ++i;
+        if (in_y) ++j;
+    }
+    return z;
+}
+
+SCENARIO ("Using roaring bitmaps", "[roaring_bitmap]")
+{
+    auto values = [](e::roaring_bitmap<> const& x){
+        e::array_single_ended<e::N<32>> v;
+        e::for_each_value(x, [&v](e::N<32> a){ e::push(v, a); });
+        return v;
+    };
+    auto sample = [](e::N<32> first, e::N<32> limit, e::N<32> step){
+        e::array_single_ended<e::N<32>> v;
+        for (auto a = first; a < limit; a = a + step) e::push(v, a);
+        return v;
+    };
+
+    // Sparse values, a dense chunk that needs a bitmap, long runs, and
+    // chunks only in one of the two
+    auto a = sample(0, 300000, 7);
+    auto b = sample(65536, 65536 * 3, 3);
+    for (e::N<32> v = 1000000; v < 1200000; ++v) e::push(b, v);
+    e::push(b, 0xffffffff);
+    e::array_single_ended<e::N<32>> c;
+    for (e::N<32> v = 0; v < 6000; ++v) e::push(c, v * 11);
+    e::push(c, 1000005);
+
+    e::roaring_bitmap<> x(e::first(a), e::limit(a));
+    e::roaring_bitmap<> y(e::first(b), e::limit(b));
+    e::roaring_bitmap<> z(e::first(c), e::limit(c));
+
+    SECTION ("Construction and membership")
+    {
+        REQUIRE (e::size(x) == e::size(a));
+        REQUIRE (values(x) == a);
+        REQUIRE (values(y) == b);
+        REQUIRE (values(z) == c);
+        REQUIRE (x.containers[0].kind == e::roaring_kind::bitmap);
+        REQUIRE (z.containers[1].kind == e::roaring_kind::array);
+        REQUIRE (e::contains(x, 14));
+        REQUIRE (!e::contains(x, 15));
+        REQUIRE (e::contains(y, 0xffffffff));
+        REQUIRE (!e::contains(y, 0xfffffffe));
+        REQUIRE (e::is_empty(e::roaring_bitmap<>{}));
+
+        e::roaring_bitmap<> w;
+        for (e::pointer_diff i = e::size(b); 0 < i; --i) e::insert(w, b[i - 1]);
+        e::insert(w, 65536);
+        REQUIRE (w == y);
+    }
+
+    SECTION ("Run containers")
+    {
+        auto w = y;
+        e::run_optimize(w);
+        REQUIRE (w == y);
+        REQUIRE (values(w) == b);
+        auto runs = 0;
+        for (e::pointer_diff i = 0; i < e::size(w.containers); ++i) runs = runs + (w.containers[i].kind == e::roaring_kind::run);
+        REQUIRE (runs == 4);
+        for (e::N<32> v = 999990; v < 1200010; ++v) REQUIRE (e::contains(w, v) == (1000000 <= v and v < 1200000));
+
+        e::insert(w, 999999);
+        e::insert(w, 1200000);
+        REQUIRE (e::contains(w, 999999));
+        REQUIRE (e::size(w) == e::size(y) + 2);
+    }
+
+    SECTION ("Set operations")
+    {
+        auto or_ = [](bool p, bool q){ return p or q; };
+        auto and_ = [](bool p, bool q){ return p and q; };
+        auto minus = [](bool p, bool q){ return p and !q; };
+        auto u = y;
+        e::run_optimize(u);
+        // Chunks of about 2000 values, which intersect as arrays
+        auto d = sample(5, 400000, 29);
+        auto v = sample(1, 400000, 31);
+        e::roaring_bitmap<> s_d(e::first(d), e::limit(d));
+        e::roaring_bitmap<> s_v(e::first(v), e::limit(v));
+        for (auto const* p : {&x, &z, &s_d}) {
+            for (auto const* q : {&y, &z, &u, &s_v}) {
+                auto s = values(*p);
+                auto t = values(*q);
+                REQUIRE (values(e::set_union(*p, *q)) == sorted_merge(s, t, or_));
+                REQUIRE (values(e::set_intersection(*p, *q)) == sorted_merge(s, t, and_));
+                REQUIRE (values(e::set_difference(*p, *q)) == sorted_merge(s, t, minus));
+                REQUIRE (values(e::set_difference(*q, *p)) == sorted_merge(t, s, minus));
+            }
+        }
+        REQUIRE (e::is_empty(e::set_difference(x, x)));
+        REQUIRE (e::set_union(x, e::roaring_bitmap<>{}) == x);
+        REQUIRE (e::set_intersection(z, z) == z);
+    }
+
+    SECTION ("Serialization")
+    {
+        auto w = y;
+        e::run_optimize(w);
+        for (auto const* p : {&x, &w, &z}) {
+            auto n = e::serialized_size(*p);
+            e::array_single_ended<e::N<64>> buffer(n / 8 + 1, 0);
+            // An odd offset checks that no aligned access is assumed
+            auto dst = reinterpret_cast<e::Pointer_type<e::byte>>(e::first(buffer)) + 1;
+            REQUIRE (e::serialize(*p, dst) == dst + n);
+            e::roaring_view view{dst};
+            REQUIRE (e::size(view) == e::size(*p));
+            REQUIRE (e::to_roaring(view) == *p);
+            for (e::N<32> v = 0; v < 1300000; v = v + 5) REQUIRE (e::contains(view, v) == e::contains(*p, v));
+            REQUIRE (e::contains(view, 0xffffffff) == e::contains(*p, 0xffffffff));
+        }
+        e::roaring_bitmap<> empty;
+        auto n = e::serialized_size(empty);
+        REQUIRE (n == 8);
+        e::array_single_ended<e::N<64>> buffer(n / 8 + 1, 0);
+        e::serialize(empty, reinterpret_cast<e::Pointer_type<e::byte>>(e::first(buffer)));
+        e::roaring_view view{reinterpret_cast<e::Pointer_type<e::byte const>>(e::first(buffer))};
+        REQUIRE (e::size(view) == 0);
+        REQUIRE (!e::contains(view, 3));
+    }
+}
@@ -0,0 +1,227 @@
+#include "catch.hpp"
+
+#include "scan.h"
+
+namespace e = elements;
+
+struct affine
+{
+    e::pointer_diff a{1};
+    e::pointer_diff b{0};
+
+    auto operator<=>(affine const&) const = default;
+};
+
+SCENARIO ("Scans", "[scan]")
+{
+    SECTION ("Scans with an arbitrary operation")
+    {
+        int x[]{3, 1, 4, 1, 5, 9};
+        int y[6]{};
+        auto max = [](int a, int b){ return a < b ? b : a; };
+
+        REQUIRE (e::scan_inclusive(x, x + 6, y, max) == y + 6);
+        REQUIRE (y[0] == 3);
+        REQUIRE (y[2] == 4);
+        REQUIRE (y[5] == 9);
+        REQUIRE (e::scan_exclusive(x, x + 6, y, max, 0) == y + 6);
+        REQUIRE (y[0] == 0);
+        REQUIRE (y[1] == 3);
+        REQUIRE (y[5] == 5);
+        REQUIRE (e::scan_inclusive(x, x, y, max) == y);
+
+        e::array_single_ended<int> z;
+        for (int i : {1, 2, 3, 4}) e::push(z, i);
+        e::scan_inclusive(e::first(z), e::limit(z), e::first(z), e::multiply);
+        REQUIRE (z[2] == 6);
+        REQUIRE (z[3] == 24);
+    }
+
+    SECTION ("Summing scans of 32-bit integers")
+    {
+        for (e::pointer_diff n : {0, 1, 7, 8, 15, 16, 17, 33, 1000}) {
+            e::array_single_ended<int> x(n);
+            for (e::pointer_diff i = 0; i < n; ++i) e::push(x, static_cast<int>((i * 7 + i / 5) % 13) - 4);
+            e::array_single_ended<int> inclusive(n, 0);
+            e::array_single_ended<int> exclusive(n, 0);
+            auto sum = 3;
+            for (e::pointer_diff i = 0; i < n; ++i) {
+                exclusive[i] = sum;
+                sum = sum + x[i];
+                inclusive[i] = sum;
+            }
+
+            e::array_single_ended<int> y(n, 0);
+            REQUIRE (e::scan_inclusive(e::first(x), e::limit(x), e::first(y), e::add, 3) == e::limit(y));
+            REQUIRE (y == inclusive);
+            REQUIRE (e::scan_exclusive(e::first(x), e::limit(x), e::first(y), e::add_op<int>{}, 3) == e::limit(y));
+            REQUIRE (y == exclusive);
+            auto z = x;
+            e::scan_exclusive(e::first(z), e::limit(z), e::first(z), e::add, 3);
+            REQUIRE (z == exclusive);
+            z = x;
+            e::scan_inclusive(e::first(z), e::limit(z), e::first(z), e::add);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z[i] + 3 == inclusive[i]);
+        }
+    }
+
+    SECTION ("Summing scans of unsigned integers")
+    {
+        for (e::pointer_diff n : {0, 1, 7, 8, 15, 16, 17, 33, 1000}) {
+            e::array_single_ended<unsigned> x(n);
+            for (e::pointer_diff i = 0; i < n; ++i) e::push(x, static_cast<unsigned>((i * 7 + i / 5) % 13) - 4u);
+            e::array_single_ended<unsigned> inclusive(n, 0u);
+            e::array_single_ended<unsigned> exclusive(n, 0u);
+            auto sum = 3u;
+            for (e::pointer_diff i = 0; i < n; ++i) {
+                exclusive[i] = sum;
+                sum = sum + x[i];
+                inclusive[i] = sum;
+            }
+
+            e::array_single_ended<unsigned> y(n, 0u);
+            REQUIRE (e::scan_inclusive(e::first(x), e::limit(x), e::first(y), e::add, 3u) == e::limit(y));
+            REQUIRE (y == inclusive);
+            REQUIRE (e::scan_exclusive(e::first(x), e::limit(x), e::first(y), e::add_op<unsigned>{}, 3u) == e::limit(y));
+            REQUIRE (y == exclusive);
+            auto z = x;
+            e::scan_exclusive(e::first(z), e::limit(z), e::first(z), e::add, 3u);
+            REQUIRE (z == exclusive);
+            z = x;
+            e::scan_inclusive(e::first(z), e::limit(z), e::first(z), e::add);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z[i] + 3u == inclusive[i]);
+        }
+    }
+
+    SECTION ("Summing scans of 64-bit integers")
+    {
+        for (e::pointer_diff n : {0, 1, 7, 8, 15, 16, 17, 33, 1000}) {
+            e::array_single_ended<long long> x(n);
+            for (e::pointer_diff i = 0; i < n; ++i) e::push(x, (i * 7 + i / 5) % 13 - 4);
+            e::array_single_ended<long long> inclusive(n, 0ll);
+            e::array_single_ended<long long> exclusive(n, 0ll);
+            auto sum = 3ll;
+            for (e::pointer_diff i = 0; i < n; ++i) {
+                exclusive[i] = sum;
+                sum = sum + x[i];
+                inclusive[i] = sum;
+            }
+
+            e::array_single_ended<long long> y(n, 0ll);
+            REQUIRE (e::scan_inclusive(e::first(x), e::limit(x), e::first(y), e::add, 3ll) == e::limit(y));
+            REQUIRE (y == inclusive);
+            REQUIRE (e::scan_exclusive(e::first(x), e::limit(x), e::first(y), e::add_op<long long>{}, 3ll) == e::limit(y));
+            REQUIRE (y == exclusive);
+            auto z = x;
+            e::scan_exclusive(e::first(z), e::limit(z), e::first(z), e::add, 3ll);
+            REQUIRE (z == exclusive);
+            z = x;
+            e::scan_inclusive(e::first(z), e::limit(z), e::first(z), e::add);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z[i] + 3ll == inclusive[i]);
+        }
+    }
+
+    SECTION ("Summing scans of single-precision numbers")
+    {
+        // Small whole numbers add exactly in any order, also as floating point
+        for (e::pointer_diff n : {0, 1, 7, 8, 15, 16, 17, 33, 1000}) {
+            e::array_single_ended<float> x(n);
+            for (e::pointer_diff i = 0; i < n; ++i) e::push(x, static_cast<float>((i * 7 + i / 5) % 13) - 4.0f);
+            e::array_single_ended<float> inclusive(n, 0.0f);
+            e::array_single_ended<float> exclusive(n, 0.0f);
+            auto sum = 3.0f;
+            for (e::pointer_diff i = 0; i < n; ++i) {
+                exclusive[i] = sum;
+                sum = sum + x[i];
+                inclusive[i] = sum;
+            }
+
+            e::array_single_ended<float> y(n, 0.0f);
+            REQUIRE (e::scan_inclusive(e::first(x), e::limit(x), e::first(y), e::add, 3.0f) == e::limit(y));
+            REQUIRE (y == inclusive);
+            REQUIRE (e::scan_exclusive(e::first(x), e::limit(x), e::first(y), e::add_op<float>{}, 3.0f) == e::limit(y));
+            REQUIRE (y == exclusive);
+            auto z = x;
+            e::scan_exclusive(e::first(z), e::limit(z), e::first(z), e::add, 3.0f);
+            REQUIRE (z == exclusive);
+            z = x;
+            e::scan_inclusive(e::first(z), e::limit(z), e::first(z), e::add);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z[i] + 3.0f == inclusive[i]);
+        }
+    }
+
+    SECTION ("Summing scans of double-precision numbers")
+    {
+        for (e::pointer_diff n : {0, 1, 7, 8, 15, 16, 17, 33, 1000}) {
+            e::array_single_ended<double> x(n);
+            for (e::pointer_diff i = 0; i < n; ++i) e::push(x, static_cast<double>((i * 7 + i / 5) % 13) - 4.0);
+            e::array_single_ended<double> inclusive(n, 0.0);
+            e::array_single_ended<double> exclusive(n, 0.0);
+            auto sum = 3.0;
+            for (e::pointer_diff i = 0; i < n; ++i) {
+                exclusive[i] = sum;
+                sum = sum + x[i];
+                inclusive[i] = sum;
+            }
+
+            e::array_single_ended<double> y(n, 0.0);
+            REQUIRE (e::scan_inclusive(e::first(x), e::limit(x), e::first(y), e::add, 3.0) == e::limit(y));
+            REQUIRE (y == inclusive);
+            REQUIRE (e::scan_exclusive(e::first(x), e::limit(x), e::first(y), e::add_op<double>{}, 3.0) == e::limit(y));
+            REQUIRE (y == exclusive);
+            auto z = x;
+            e::scan_exclusive(e::first(z), e::limit(z), e::first(z), e::add, 3.0);
+            REQUIRE (z == exclusive);
+            z = x;
+            e::scan_inclusive(e::first(z), e::limit(z), e::first(z), e::add);
+            for (e::pointer_diff i = 0; i < n; ++i) REQUIRE (z[i] + 3.0 == inclusive[i]);
+        }
+    }
+
+    SECTION ("Scanning at compile time")
+    {
+        constexpr auto scanned = [](){
+            int x[]{1, 2, 3};
+            e::scan_inclusive(x, x + 3, x, e::add);
+            return x[2];
+        }();
+        static_assert(scanned == 6);
+    }
+
+    SECTION ("Parallel scans")
+    {
+        for (e::pointer_diff n : {0, 5, 65536 * 3 + 1}) {
+            e::array_single_ended<long long> x(n);
+            for (e::pointer_diff i = 0; i < n; ++i) e::push(x, (i * 7 + i / 5) % 13 - 4);
+            e::array_single_ended<long long> inclusive(n, 0);
+            e::array_single_ended<long long> exclusive(n, 0);
+            e::scan_inclusive(e::first(x), e::limit(x), e::first(inclusive), e::add);
+            e::scan_exclusive(e::first(x), e::limit(x), e::first(exclusive), e::add, 0ll);
+            for (e::pointer_diff w : {1, 2, 3, 8}) {
+                e::array_single_ended<long long> y(n, 0);
+                REQUIRE (e::scan_inclusive_parallel(e::first(x), e::limit(x), e::first(y), e::add, 0ll, w) == e::limit(y));
+                REQUIRE (y == inclusive);
+                auto z = x;
+                REQUIRE (e::scan_exclusive_parallel(e::first(z), e::limit(z), e::first(z), e::add, 0ll, w) == e::limit(z));
+                REQUIRE (z == exclusive);
+            }
+        }
+
+        // Composition of affine maps modulo a prime is associative but does
+        // not commute
+        auto compose = [](affine const& f, affine const& g){
+            return affine{f.a * g.a % 65521, (f.b * g.a + g.b) % 65521};
+        };
+        auto n = 65536 * 2 + 3;
+        e::array_single_ended<affine> f(n);
+        for (e::pointer_diff i = 0; i < n; ++i) e::push(f, affine{i % 7 + 1, i % 11});
+        e::array_single_ended<affine> serial(n, affine{});
+        e::array_single_ended<affine> parallel(n, affine{});
+        e::scan_inclusive(e::first(f), e::limit(f), e::first(serial), compose);
+        e::scan_inclusive_parallel(e::first(f), e::limit(f), e::first(parallel), compose, affine{1, 0}, 2);
+        REQUIRE (parallel == serial);
+        e::scan_exclusive(e::first(f), e::limit(f), e::first(serial), compose, affine{1, 0});
+        e::scan_exclusive_parallel(e::first(f), e::limit(f), e::first(parallel), compose, affine{1, 0}, 3);
+        REQUIRE (parallel == serial);
+    }
+}
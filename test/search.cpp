@@ -1,5 +1,7 @@
 #include "catch.hpp"
 
+#include "array_segmented_single_ended.h"
+#include "list_unrolled.h"
 #include "search.h"
 
 namespace e = elements;
@@ -132,6 +134,40 @@ SCENARIO ("Linear search", "[search]")
         }
     }
 
+    SECTION ("search, search_if on segmented sequences")
+    {
+        e::list_unrolled<int, 2> y;
+        e::array_segmented_single_ended<int, 2> z;
+        for (int i : {1, 3, 5, 6, 7, 8, 9}) {
+            e::push_last(y, i);
+            e::push(z, i);
+        }
+
+        auto cur = e::search_if(e::first(y), e::limit(y), is_even);
+        REQUIRE (e::load(cur) == 6);
+
+        cur = e::search_if(e::first(y), e::first(y) + 3, is_even);
+        REQUIRE (cur == e::first(y) + 3);
+
+        cur = e::search_if_not(e::first(y) + 3, e::limit(y), is_even);
+        REQUIRE (e::load(cur) == 7);
+
+        cur = e::search(e::successor(e::first(y)), e::last(y), 9);
+        REQUIRE (cur == e::last(y));
+
+        cur = e::search_not(e::first(y), e::limit(y), 1);
+        REQUIRE (e::load(cur) == 3);
+
+        auto cur_z = e::search_if(e::first(z), e::limit(z), is_even);
+        REQUIRE (e::load(cur_z) == 6);
+
+        cur_z = e::search(e::first(z), e::limit(z), 9);
+        REQUIRE (e::load(cur_z) == 9);
+
+        cur_z = e::search(e::first(z), e::limit(z), 2);
+        REQUIRE (cur_z == e::limit(z));
+    }
+
     SECTION ("search_if_n, search_if_not_n")
     {
         SECTION ("Searcing for an even element")
@@ -0,0 +1,135 @@
+#include "catch.hpp"
+
+#include <cstdint>
+
+#include "sparse.h"
+
+namespace e = elements;
+
+SCENARIO ("Using sparse vectors", "[sparse]")
+{
+    e::dynamic_vector<int> x(10, 0);
+    x(1) = 3;
+    x(4) = -2;
+    x(9) = 5;
+    auto const y = e::to_sparse(x);
+
+    REQUIRE (e::size(y) == 10);
+    REQUIRE (e::nonzeros(y) == 3);
+    REQUIRE (y(0) == 0);
+    REQUIRE (y(1) == 3);
+    REQUIRE (y(4) == -2);
+    REQUIRE (y(8) == 0);
+    REQUIRE (y(9) == 5);
+    REQUIRE (e::to_dense(y) == x);
+
+    e::dynamic_vector<int> z(10, 0);
+    for (e::pointer_diff i = 0; i < 10; ++i) z(i) = static_cast<int>(i) - 4;
+    auto w = e::to_sparse<std::int32_t>(z);
+
+    REQUIRE (e::nonzeros(w) == 9);
+    REQUIRE (y * z == x * z);
+    REQUIRE (z * y == x * z);
+    REQUIRE (y * w == x * z);
+    REQUIRE (w * y == x * z);
+}
+
+SCENARIO ("Using sparse matrices", "[sparse]")
+{
+    SECTION ("Construction from triplets")
+    {
+        e::coo_matrix_engine<int> x(3, 4);
+        e::push(x, 2, 1, 7);
+        e::push(x, 0, 3, 1);
+        e::push(x, 0, 0, 2);
+        e::push(x, 2, 1, -3);
+        e::push(x, 1, 2, 5);
+        e::push(x, 0, 3, 1);
+        e::sparse_matrix<int> const y{e::csr_matrix_engine<int>(x)};
+
+        REQUIRE (e::rows(y) == 3);
+        REQUIRE (e::columns(y) == 4);
+        REQUIRE (e::nonzeros(y) == 4);
+        REQUIRE (y(0, 0) == 2);
+        REQUIRE (y(0, 3) == 2);
+        REQUIRE (y(1, 2) == 5);
+        REQUIRE (y(2, 1) == 4);
+        REQUIRE (y(1, 1) == 0);
+        REQUIRE (y(2, 3) == 0);
+
+        auto d = e::to_dense(y);
+        REQUIRE (d(0, 3) == 2);
+        REQUIRE (d(2, 2) == 0);
+        REQUIRE (e::to_sparse(d) == y);
+
+        e::coo_matrix_engine<int> long_row(2, 3000);
+        for (e::pointer_diff j = 2999; j >= 0; --j) {
+            e::push(long_row, 1, (j * 17) % 3000, static_cast<int>(j % 3000));
+            if (j % 2 == 0) e::push(long_row, 1, (j * 17) % 3000, 1);
+        }
+        e::csr_matrix_engine<int> const r(long_row);
+        REQUIRE (e::nonzeros(r) == 3000);
+        for (e::pointer_diff k = 1; k < 3000; ++k) REQUIRE (r.column_indices[k - 1] < r.column_indices[k]);
+        REQUIRE (r(1, 17) == 1);
+        REQUIRE (r(1, 34) == 2 + 1);
+
+        e::coo_matrix_engine<int> longer_row(2, 100000);
+        for (e::pointer_diff j = 0; j < 100000; ++j) e::push(longer_row, 0, (j * 7919) % 100000, static_cast<int>(j % 5 + 1));
+        for (e::pointer_diff j = 0; j < 100000; ++j) e::push(longer_row, 1, j, 1);
+        e::csr_matrix_engine<int> const s(longer_row);
+        REQUIRE (e::nonzeros(s) == 2 * 100000);
+        for (e::pointer_diff k = 1; k < e::nonzeros(s); ++k) {
+            if (k != s.offsets[1]) REQUIRE (s.column_indices[k - 1] < s.column_indices[k]);
+        }
+        REQUIRE (s(0, 0) == 1);
+        REQUIRE (s(0, 7919) == 2);
+        REQUIRE (s(1, 99999) == 1);
+
+        e::coo_matrix_engine<int> empty(5, 5);
+        e::csr_matrix_engine<int> z(empty);
+        REQUIRE (e::rows(z) == 5);
+        REQUIRE (e::nonzeros(z) == 0);
+    }
+
+    SECTION ("Sparse products")
+    {
+        e::pointer_diff m = 500;
+        e::pointer_diff n = 300;
+        e::coo_matrix_engine<long, std::int32_t> x(m, n);
+        for (e::pointer_diff i = 0; i < m; ++i) {
+            // Rows of very different lengths, to test the balancing of workers
+            for (e::pointer_diff j = 0; j < n; j = j + 1 + i % 37) {
+                e::push(x, i, (j * 7 + i) % n, (i + j) % 9 - 4L);
+            }
+        }
+        e::sparse_matrix<long, std::int32_t> a{e::csr_matrix_engine<long, std::int32_t>(x)};
+        auto d = e::to_dense(a);
+        e::dynamic_vector<long> v(n, 0L);
+        for (e::pointer_diff j = 0; j < n; ++j) v(j) = j % 5 - 2;
+
+        auto expected = d * v;
+        REQUIRE (e::size(expected) == m);
+        REQUIRE (a * v == expected);
+
+        for (e::pointer_diff workers : {1, 2, 3, 16}) {
+            e::dynamic_vector<long> y(m, 0L);
+            e::multiply_sparse(a.engine, e::first(v), e::first(y), workers);
+            REQUIRE (y == expected);
+        }
+
+        e::dynamic_vector<long> y(m, 0L);
+        e::multiply_sparse(x, e::first(v), e::first(y));
+        REQUIRE (y == expected);
+
+        e::dynamic_matrix<long> b(n, 7, 0L);
+        for (e::pointer_diff i = 0; i < n; ++i) {
+            for (e::pointer_diff j = 0; j < 7; ++j) b(i, j) = (i * j) % 11 - 5;
+        }
+        REQUIRE (a * b == d * b);
+        for (e::pointer_diff workers : {1, 4}) {
+            e::dynamic_matrix<long> c(m, 7, 0L);
+            e::multiply_sparse(a.engine, e::view(std::as_const(b)), e::view(c), workers);
+            REQUIRE (c == d * b);
+        }
+    }
+}
@@ -0,0 +1,192 @@
+#include "catch.hpp"
+
+#include "spatial_index.h"
+
+namespace e = elements;
+
+SCENARIO ("Using spatial indices", "[spatial_index]")
+{
+    e::pointer_diff n = 2000;
+    e::array_single_ended<e::point<double, 3>> x(n);
+    e::point_cloud<double, 3> cloud(n);
+    for (e::pointer_diff i = 0; i < n; ++i) {
+        e::point<double, 3> p;
+        p(0) = static_cast<double>((i * 37) % 101) * 0.5;
+        p(1) = static_cast<double>((i * 53) % 67) - 20.0;
+        p(2) = static_cast<double>(i % 7);
+        e::push(x, p);
+        e::push(cloud, p);
+    }
+    e::array_single_ended<e::point<double, 3>> queries(102);
+    for (e::pointer_diff i = 0; i < 100; ++i) {
+        e::point<double, 3> p;
+        p(0) = static_cast<double>(((i * 17 + 3) * 37) % 101) * 0.5 + 0.25 * static_cast<double>(i % 3);
+        p(1) = static_cast<double>(((i * 17 + 3) * 53) % 67) - 20.0 - 0.5 * static_cast<double>(i % 5);
+        p(2) = static_cast<double>((i * 17 + 3) % 7);
+        e::push(queries, p);
+    }
+    e::push(queries, e::point<double, 3>{});
+    auto far = e::point<double, 3>{};
+    far(0) = 1000.0;
+    far(1) = -1000.0;
+    e::push(queries, far);
+
+    SECTION ("Nearest neighbours in a k-d tree")
+    {
+        e::kd_tree<double, 3> tree(e::first(x), e::limit(x));
+
+        REQUIRE (e::size(tree) == n);
+        for (e::pointer_diff m : {1, 4, 25}) {
+            for (e::pointer_diff i = 0; i < e::size(queries); ++i) {
+                e::array_single_ended<e::pointer_diff> expected(m, 0);
+                e::array_single_ended<e::pointer_diff> actual(m, -1);
+                e::nearest_neighbours(cloud, queries[i], m, e::first(expected));
+                REQUIRE (e::nearest_neighbours(tree, queries[i], m, e::first(actual)) == m);
+                REQUIRE (actual == expected);
+                if (m == 1) REQUIRE (e::nearest(tree, queries[i]) == expected[0]);
+            }
+        }
+    }
+
+    SECTION ("Points within a distance in a k-d tree")
+    {
+        e::kd_tree<double, 3> tree(e::first(x), e::limit(x));
+
+        for (double r : {0.0, 1.0, 2.5, 7.0}) {
+            for (e::pointer_diff i = 0; i < e::size(queries); ++i) {
+                e::array_single_ended<bool> found(n, false);
+                auto count = e::pointer_diff{0};
+                e::for_each_within(tree, queries[i], r, [&found, &count](e::pointer_diff j){
+                    found[j] = true;
+                    ++count;
+                });
+                e::array_single_ended<bool> inside(n, false);
+                auto expected = e::pointer_diff{0};
+                for (e::pointer_diff j = 0; j < n; ++j) {
+                    inside[j] = e::quadrance(x[j], queries[i]) <= r * r;
+                    if (inside[j]) ++expected;
+                }
+                REQUIRE (found == inside);
+                REQUIRE (count == expected);
+            }
+        }
+    }
+
+    SECTION ("Empty k-d trees")
+    {
+        e::kd_tree<double, 3> empty(e::first(x), e::first(x));
+
+        REQUIRE (e::is_empty(empty));
+        e::array_single_ended<e::pointer_diff> nearest(3, -1);
+        REQUIRE (e::nearest_neighbours(empty, far, 3, e::first(nearest)) == 0);
+    }
+
+    SECTION ("Nearest neighbours in grids")
+    {
+        for (double cell : {0.75, 3.0, 50.0}) {
+            e::grid_index<double, 3> grid(e::first(x), e::limit(x), cell);
+
+            REQUIRE (e::size(grid) == n);
+            for (e::pointer_diff m : {1, 4, 25}) {
+                for (e::pointer_diff i = 0; i < e::size(queries); ++i) {
+                    e::array_single_ended<e::pointer_diff> expected(m, 0);
+                    e::array_single_ended<e::pointer_diff> actual(m, -1);
+                    e::nearest_neighbours(cloud, queries[i], m, e::first(expected));
+                    REQUIRE (e::nearest_neighbours(grid, queries[i], m, e::first(actual)) == m);
+                    REQUIRE (actual == expected);
+                    if (m == 1) REQUIRE (e::nearest(grid, queries[i]) == expected[0]);
+                }
+            }
+        }
+    }
+
+    SECTION ("Points within a distance in grids")
+    {
+        for (double cell : {0.75, 3.0, 50.0}) {
+            e::grid_index<double, 3> grid(e::first(x), e::limit(x), cell);
+
+            for (double r : {0.0, 1.0, 2.5, 7.0}) {
+                for (e::pointer_diff i = 0; i < e::size(queries); ++i) {
+                    e::array_single_ended<bool> found(n, false);
+                    auto count = e::pointer_diff{0};
+                    e::for_each_within(grid, queries[i], r, [&found, &count](e::pointer_diff j){
+                        found[j] = true;
+                        ++count;
+                    });
+                    e::array_single_ended<bool> inside(n, false);
+                    auto expected = e::pointer_diff{0};
+                    for (e::pointer_diff j = 0; j < n; ++j) {
+                        inside[j] = e::quadrance(x[j], queries[i]) <= r * r;
+                        if (inside[j]) ++expected;
+                    }
+                    REQUIRE (found == inside);
+                    REQUIRE (count == expected);
+                }
+            }
+        }
+    }
+
+    SECTION ("Grids over a wide extent")
+    {
+        e::array_single_ended<e::point<double, 3>> y(4);
+        for (double c : {0.0, 1.0, 1.0e12, -1.0e12}) {
+            e::point<double, 3> p;
+            p(0) = c;
+            p(1) = -c;
+            p(2) = c;
+            e::push(y, p);
+        }
+        e::grid_index<double, 3> grid(e::first(y), e::limit(y), 0.001);
+
+        REQUIRE (e::size(grid) == 4);
+        REQUIRE (e::size(grid.offsets) <= 4 * e::grid_index_cells_per_point + 1);
+        REQUIRE (e::nearest(grid, e::point<double, 3>{}) == 0);
+        REQUIRE (e::nearest(grid, y[2]) == 2);
+        auto calls = 0;
+        e::for_each_within(grid, e::point<double, 3>{}, 2.0, [&calls](e::pointer_diff){ ++calls; });
+        REQUIRE (calls == 2);
+    }
+
+    SECTION ("Empty grids")
+    {
+        e::grid_index<double, 3> empty(e::first(x), e::first(x), 1.0);
+
+        REQUIRE (e::is_empty(empty));
+        auto calls = 0;
+        e::for_each_within(empty, far, 10.0, [&calls](e::pointer_diff){ ++calls; });
+        REQUIRE (calls == 0);
+    }
+
+    SECTION ("Parallel construction")
+    {
+        e::pointer_diff big = 3 * e::spatial_index_parallel_grain;
+        e::array_single_ended<e::point<double, 3>> y(big);
+        e::point_cloud<double, 3> z(big);
+        for (e::pointer_diff i = 0; i < big; ++i) {
+            e::point<double, 3> p;
+            p(0) = static_cast<double>((i * 37) % 101) * 0.5;
+            p(1) = static_cast<double>((i * 53) % 67) - 20.0;
+            p(2) = static_cast<double>(i % 1009);
+            e::push(y, p);
+            e::push(z, p);
+        }
+        e::kd_tree<double, 3> serial_tree(e::first(y), e::limit(y), 1);
+        e::kd_tree<double, 3> parallel_tree(e::first(y), e::limit(y), 4);
+        e::grid_index<double, 3> serial_grid(e::first(y), e::limit(y), 4.0, 1);
+        e::grid_index<double, 3> parallel_grid(e::first(y), e::limit(y), 4.0, 3);
+
+        REQUIRE (parallel_grid.indices == serial_grid.indices);
+        REQUIRE (parallel_grid.offsets == serial_grid.offsets);
+        for (e::pointer_diff i = 0; i < 20; ++i) {
+            e::array_single_ended<e::pointer_diff> expected(8, 0);
+            e::array_single_ended<e::pointer_diff> actual(8, -1);
+            e::nearest_neighbours(z, queries[i], 8, e::first(expected));
+            e::nearest_neighbours(serial_tree, queries[i], 8, e::first(actual));
+            REQUIRE (actual == expected);
+            e::nearest_neighbours(parallel_tree, queries[i], 8, e::first(actual));
+            REQUIRE (actual == expected);
+            e::nearest_neighbours(parallel_grid, queries[i], 8, e::first(actual));
+            REQUIRE (actual == expected);
+        }
+    }
+}
@@ -1,6 +1,8 @@
 #include "catch.hpp"
 
 #include <chrono>
+#include <tuple>
+#include <utility>
 
 #include "vector_space.h"
 
@@ -121,3 +123,191 @@ SCENARIO ("Using vectors", "[vector]")
         }
     }
 }
+
+SCENARIO ("Using vector expressions", "[vector]")
+{
+    SECTION ("Dynamic expression vectors")
+    {
+        e::pointer_diff n = 1003;
+        e::dynamic_expression_vector<double> x{n, 0.0};
+        e::dynamic_expression_vector<double> y{n, 0.0};
+        for (e::pointer_diff i = 0; i < n; ++i) {
+            x(i) = static_cast<double>(i);
+            y(i) = static_cast<double>(2 * i + 1);
+        }
+
+        auto axpy = 3.0 * x + y;
+
+        static_assert(e::Expression_engine<decltype(axpy.engine)>);
+        static_assert(!e::Is_dynamic_vector<decltype(axpy)>);
+        REQUIRE (e::size(axpy.engine) == n);
+
+        e::dynamic_expression_vector<double> z = axpy;
+
+        REQUIRE (e::size(z) == n);
+        for (e::pointer_diff i = 0; i < n; ++i) {
+            REQUIRE (z(i) == static_cast<double>(5 * i + 1));
+        }
+
+        e::dynamic_vector<double> w;
+        w = x - y * 2.0 + (-x);
+
+        REQUIRE (e::size(w) == n);
+        for (e::pointer_diff i = 0; i < n; ++i) {
+            REQUIRE (w(i) == static_cast<double>(-4 * i - 2));
+        }
+
+        y = 2.0 * x + y;
+
+        for (e::pointer_diff i = 0; i < n; ++i) {
+            REQUIRE (y(i) == static_cast<double>(4 * i + 1));
+        }
+
+        double s = 0.0;
+        for (e::pointer_diff i = 0; i < n; ++i) s = s + (3.0 * x(i) + y(i)) * (x(i) - y(i));
+
+        REQUIRE ((3.0 * x + y) * (x - y) == Approx(s));
+        REQUIRE (e::inner_product(x, y) == Approx(x * y));
+    }
+
+    SECTION ("Static expression vectors")
+    {
+        e::static_expression_vector<int, 3> x;
+        e::static_expression_vector<int, 3> y;
+        x(0) = 1;
+        x(1) = 2;
+        x(2) = 3;
+        y(0) = 4;
+        y(1) = 5;
+        y(2) = 6;
+
+        e::static_expression_vector<int, 3> z = 2 * x - y;
+
+        REQUIRE (z(0) == -2);
+        REQUIRE (z(1) == -1);
+        REQUIRE (z(2) == 0);
+        REQUIRE (x * y == 32);
+        REQUIRE ((x + y) * (x - y) == 1 + 4 + 9 - 16 - 25 - 36);
+    }
+
+    SECTION ("Fused inner products")
+    {
+        for (e::pointer_diff n : {0, 1, 7, 8, 9, 100}) {
+            e::dynamic_vector<long> x{n, 0L};
+            e::dynamic_vector<long> y{n, 0L};
+            long s = 0;
+            for (e::pointer_diff i = 0; i < n; ++i) {
+                x(i) = i + 1;
+                y(i) = 2 * i - 7;
+                s = s + (i + 1) * (2 * i - 7);
+            }
+
+            REQUIRE (x * y == s);
+            REQUIRE (e::inner_product(x, y) == s);
+        }
+    }
+}
+
+template <typename M0, typename M1>
+auto
+multiply_reference(M0 const& x, M1 const& y, e::pointer_diff i, e::pointer_diff j)
+{
+    auto s = e::Zero<e::Scalar_type<M0>>;
+    for (e::pointer_diff p = 0; p < e::columns(x); ++p) s = s + x(i, p) * y(p, j);
+    return s;
+}
+
+template <typename M>
+void
+fill_matrix(M& x, e::pointer_diff seed)
+{
+    for (e::pointer_diff i = 0; i < e::rows(x); ++i) {
+        for (e::pointer_diff j = 0; j < e::columns(x); ++j) {
+            x(i, j) = static_cast<e::Scalar_type<M>>((i * 7 + j * 3 + seed) % 11 - 5);
+        }
+    }
+}
+
+SCENARIO ("Using matrices", "[matrix]")
+{
+    SECTION ("Static matrices")
+    {
+        e::static_matrix<int, 2, 3> x;
+        e::static_matrix<int, 3, 2, e::column_major> y;
+        fill_matrix(x, 1);
+        fill_matrix(y, 2);
+        e::static_matrix<int, 2, 2> z = x * y;
+
+        static_assert(e::Same_as<decltype(z), decltype(x * y)>);
+        REQUIRE (e::rows(z) == 2);
+        REQUIRE (e::columns(z) == 2);
+        for (e::pointer_diff i = 0; i < 2; ++i) {
+            for (e::pointer_diff j = 0; j < 2; ++j) {
+                REQUIRE (z(i, j) == multiply_reference(x, y, i, j));
+            }
+        }
+        REQUIRE (y(1, 0) == e::first(y)[1]);
+        REQUIRE (x(1, 0) == e::first(x)[3]);
+
+        e::static_vector<int, 3> v;
+        v(0) = 1;
+        v(1) = -2;
+        v(2) = 3;
+        auto w = x * v;
+        REQUIRE (e::size(w) == 2);
+        REQUIRE (w(0) == x(0, 0) - 2 * x(0, 1) + 3 * x(0, 2));
+        REQUIRE (w(1) == x(1, 0) - 2 * x(1, 1) + 3 * x(1, 2));
+    }
+
+    SECTION ("Dynamic matrices")
+    {
+        for (auto [m, k, n] : {std::tuple{1, 1, 1}, {5, 7, 3}, {37, 45, 53}, {100, 300, 20}, {7, 9, 2100}}) {
+            e::dynamic_matrix<double> x(m, k, 0.0);
+            e::dynamic_matrix<double, e::column_major> y(k, n, 0.0);
+            fill_matrix(x, 0);
+            fill_matrix(y, 5);
+            auto z = x * y;
+
+            REQUIRE (e::rows(z) == m);
+            REQUIRE (e::columns(z) == n);
+            for (e::pointer_diff i = 0; i < m; ++i) {
+                for (e::pointer_diff j = 0; j < n; ++j) {
+                    REQUIRE (z(i, j) == multiply_reference(x, y, i, j));
+                }
+            }
+        }
+    }
+
+    SECTION ("Blocked and parallel products")
+    {
+        e::pointer_diff m = 103;
+        e::pointer_diff k = 270;
+        e::pointer_diff n = 61;
+        e::dynamic_matrix<long, e::column_major> x(m, k, 0L);
+        e::dynamic_matrix<long> y(k, n, 0L);
+        fill_matrix(x, 3);
+        fill_matrix(y, 4);
+        auto a = e::view(std::as_const(x));
+        auto b = e::view(std::as_const(y));
+        e::dynamic_matrix<long> expected(m, n, 0L);
+        e::multiply_matrix_naive(a, b, e::view(expected));
+
+        e::dynamic_matrix<long> z(m, n, 0L);
+        e::multiply_matrix_blocked(a, b, e::view(z));
+        REQUIRE (z == expected);
+
+        for (e::pointer_diff workers : {1, 2, 3, 8}) {
+            e::dynamic_matrix<long> w(m, n, 0L);
+            e::multiply_matrix_parallel(a, b, e::view(w), workers);
+            REQUIRE (w == expected);
+            e::dynamic_matrix<long> v(m, n, 0L);
+            e::multiply_matrix(a, b, e::view(v), workers);
+            REQUIRE (v == expected);
+        }
+
+        e::multiply_matrix_blocked(a, b, e::view(z));
+        for (e::pointer_diff i = 0; i < m; ++i) {
+            REQUIRE (z(i, 0) == 2 * expected(i, 0));
+        }
+    }
+}